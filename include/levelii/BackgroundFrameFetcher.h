@@ -14,9 +14,14 @@
 #include <memory>
 #include <future>
 #include <queue>
+#include <map>
 #include <nlohmann/json.hpp>
 #include "levelii/RadarFrame.h"
 #include "levelii/ThreadPool.h"
+#include "levelii/FairBatchQueue.h"
+#include "levelii/CancellationToken.h"
+#include "levelii/DegradationController.h"
+#include "levelii/Pipeline.h"
 
 // ✅ AWS SDK includes
 #include <aws/s3/S3Client.h>
@@ -29,22 +34,25 @@ using json = nlohmann::json;
 class FrameStorageManager;
 
 /**
- * DiscoveryItem - Metadata for a discovered NEXRAD frame to be processed
+ * StationCost - Resources spent fetching one station's volumes
+ *
+ * CPU time is the thread CPU time of the pipeline worker running each stage,
+ * so work a stage hands to other threads (parallel decode) is not included.
+ * Peak scratch is the largest pool-buffer footprint of any single volume.
  */
-struct DiscoveryItem {
-    std::string station;
-    std::string key;
-    std::string bucket;
-    std::string timestamp;
-};
-
-/**
- * DiscoveryBatch - A group of discovery items, usually for the same station,
- * to be processed sequentially on a single thread.
- */
-struct DiscoveryBatch {
-    std::string station;
-    std::vector<DiscoveryItem> items;
+struct StationCost {
+    uint64_t download_cpu_ns = 0;
+    uint64_t decode_cpu_ns = 0;
+    uint64_t store_cpu_ns = 0;
+    uint64_t index_cpu_ns = 0;
+    uint64_t bytes_downloaded = 0;
+    uint64_t bytes_decompressed = 0;
+    uint64_t bytes_stored = 0;         // Compressed frame files written
+    uint64_t peak_scratch_bytes = 0;
+    uint64_t volumes = 0;              // Volumes that made it through every stage
+
+    uint64_t cpu_ns() const { return download_cpu_ns + decode_cpu_ns + store_cpu_ns + index_cpu_ns; }
+    void add(const StationCost& other);
 };
 
 /**
@@ -59,6 +67,8 @@ struct StationStats {
     // Optimization: avoid re-scanning old objects
     std::string last_processed_key;
     uint64_t last_scan_timestamp = 0;
+
+    StationCost cost;
 };
 
 /**
@@ -185,10 +195,52 @@ struct FrameFetcherConfig {
     int buffer_pool_size = 64;            // More buffers for parallelism
     size_t buffer_size = 64 * 1024 * 1024; // 64MB per buffer (for decompressed data)
     int max_task_queue_size = 1000;       // Bound task queue to prevent memory spikes
+    int parse_threads = 1;                // Sweep decode threads per volume, shared among volumes parsing at once
+
+    // Decode window and gate decimation (see ParseOptions). Stored grids shrink to match.
+    float decode_min_range_meters = 0.0f;
+    float decode_max_range_meters = 230000.0f;  // Products are quantized and rendered out to 230 km
+    int decode_gate_stride = 1;
+    std::string decode_gate_reduction = "max";  // "max", "mean" or "sample"
     
     // Discovery performance
     int discovery_parallelism = 10;        // Scan 10 stations at once
     int max_discovery_queue_size = 200;    // Bound discovery queue (number of station batches)
+    std::map<std::string, double> station_weights;  // Fetch share per station when backlogged (default 1.0)
+
+    // Base scan first: fetch the start of each object in ranged reads of this many bytes and
+    // store its finished tilts before fetching the rest (0 fetches whole objects). Stations in
+    // base_only_stations stop after those tilts.
+    size_t base_scan_bytes = 0;
+    std::set<std::string> base_only_stations;
+
+    int item_deadline_seconds = 600;       // Cancel an object's fetch and store after this long (0 = never)
+
+    // Fetch pipeline (download -> decode -> store -> index): workers per stage and objects
+    // buffered between stages. 0 workers: fetcher_thread_pool_size downloads, half as many
+    // decoders and storers.
+    int download_workers = 0;
+    int decode_workers = 0;
+    int store_workers = 0;
+    int pipeline_queue_size = 4;
+
+    // Load shedding when ingest falls behind (see DegradationController). Processing steps down
+    // a level while queue wait or backlog (volumes queued or in flight) is over its degrade mark,
+    // and back up once both stay under their restore marks for shed_hold_seconds. Shed volumes
+    // stay in the work queue and are fetched again in full once processing is back at full.
+    bool shed_enabled = false;
+    int shed_degrade_wait_seconds = 120;
+    int shed_restore_wait_seconds = 30;
+    int shed_degrade_backlog = 200;
+    int shed_restore_backlog = 20;
+    int shed_hold_seconds = 60;
+    int shed_max_tilts = 4;                   // Lowest tilts stored per product from level base_tilts
+    std::vector<std::string> shed_priority_products = {"reflectivity"};  // Products kept from level priority_products
+
+    // Background integrity scrubbing of stored frames
+    bool scrub_enabled = true;
+    size_t scrub_bytes_per_second = 8 * 1024 * 1024; // Disk read budget for the scrubber
+    int scrub_pass_interval_seconds = 3600;          // Pause between full passes
 };
 
 class BackgroundFrameFetcher {
@@ -199,7 +251,7 @@ public:
         const std::string& data_path = "./data/levelii"
     );
 
-    ~BackgroundFrameFetcher();
+    virtual ~BackgroundFrameFetcher();
 
     // Lifecycle
     void start();
@@ -231,17 +283,52 @@ public:
      */
     json get_statistics() const;
 
+protected:
+    enum class FetchResult {
+        Ok,
+        Missing,   // The object does not exist; fetching it again will not help
+        Failed     // Anything else, worth retrying
+    };
+
+    /**
+     * @brief Append `length` bytes of an object from offset `begin` to `out` (0, 0: the whole object).
+     *
+     * Sets object_size to the full size of the object. Virtual so tests can
+     * serve objects without S3; an override must call stop() before it is destroyed.
+     */
+    virtual FetchResult fetch_object(const DiscoveryItem& item, size_t begin, size_t length, std::vector<uint8_t>& out,
+                                     size_t& object_size, const CancellationToken& cancel);
+
 private:
     std::shared_ptr<FrameStorageManager> storage_;
     FrameFetcherConfig config_;
     std::string data_path_;
-    std::shared_ptr<ThreadPool> fetch_thread_pool_;
+    /**
+     * One discovered object on its way through the fetch pipeline.
+     */
+    struct VolumeJob {
+        DiscoveryItem item;
+        std::shared_ptr<const FrameFetcherConfig> config;
+        std::shared_ptr<BufferPool> buffer_pool;
+        CancellationToken cancel;                 // Per object, with its deadline
+        ScopedBuffer raw{nullptr};                // Downloaded object, until decoded
+        std::unordered_map<std::string, std::unique_ptr<RadarFrame>> frames;
+        bool stored = false;                      // Nothing left but indexing (base-only stations)
+        StationCost cost;                         // Spent since last charged to the station
+        size_t max_tilts = 0;                     // Lowest tilts stored per product when shedding (0 = all)
+        bool degraded = false;                    // Stored with something shed: backfilled, not acknowledged
+        bool unfetchable = false;                 // Missing or undecodable: acknowledged, not retried
+    };
+    using FetchPipeline = levelii::Pipeline<VolumeJob>;
+
+    std::shared_ptr<FetchPipeline> fetch_pipeline_;
+    DegradationController degradation_;
     std::shared_ptr<ThreadPool> discovery_thread_pool_;
     std::shared_ptr<BufferPool> buffer_pool_;
 
     // Discovery queue
     std::thread discovery_loop_thread_;
-    std::queue<DiscoveryBatch> discovery_queue_;
+    FairBatchQueue discovery_queue_;
     mutable std::mutex discovery_mutex_;
     std::condition_variable discovery_cv_;
     std::condition_variable discovery_full_cv_;
@@ -251,6 +338,8 @@ private:
     std::thread cleanup_thread_;
     std::atomic<bool> is_running_{false};
     std::atomic<bool> should_stop_{false};
+    CancellationToken cancel_;              // Cancelled by stop() (state_mutex_)
+    CancellationToken pool_cancel_;         // Child of cancel_, cancelled when its pools are replaced (state_mutex_)
     std::atomic<bool> logging_enabled_{false};
 
     mutable std::mutex state_mutex_;
@@ -259,14 +348,24 @@ private:
     std::atomic<uint64_t> frames_fetched_{0};
     std::atomic<uint64_t> frames_failed_{0};
     std::atomic<uint64_t> last_fetch_timestamp_{0};
+    std::atomic<int> active_parses_{0};
     
     std::map<std::string, StationStats> station_stats_;
+    json last_bulk_discovery_;             // Summary of the last ALL-mode discovery cycle (stats_mutex_)
     mutable std::mutex stats_mutex_;
 
     // High-parallelism discovery tracking
     std::set<std::string> active_scans_;
     mutable std::mutex active_scans_mutex_;
 
+    // Volumes shed while behind, fetched again in full once back at level full
+    std::vector<DiscoveryItem> backfill_;
+    mutable std::mutex backfill_mutex_;
+
+    // Volumes re-queued by the scrubber and not yet re-fetched (station + timestamp)
+    std::set<std::string> requeued_volumes_;
+    std::mutex requeue_mutex_;
+
     // Loops
     void discovery_loop();
     void fetch_loop();
@@ -283,7 +382,24 @@ private:
 
     // ✅ Core NOAA S3 logic
     void fetch_frame_for_station(const std::string& station);
-    void process_discovery_batch(const DiscoveryBatch& batch, const FrameFetcherConfig& config, std::shared_ptr<BufferPool> buffer_pool);
+    void discover_all_stations(bool include_yesterday);
+    void queue_new_objects(const std::string& station, const std::string& last_key, std::vector<std::string> keys);
+    std::shared_ptr<FetchPipeline> make_fetch_pipeline(const FrameFetcherConfig& config);
+    bool download_volume(VolumeJob& job);
+    bool decode_volume(VolumeJob& job);
+    bool store_volume(VolumeJob& job);
+    void index_volumes(std::vector<VolumeJob>& jobs);
+    void record_failure(const VolumeJob& job);
+    void charge_station(VolumeJob& job);
+    void store_frames(const DiscoveryItem& item, std::unordered_map<std::string, std::unique_ptr<RadarFrame>>& frames,
+                      const FrameFetcherConfig& config, const std::shared_ptr<BufferPool>& buffer_pool, const CancellationToken& cancel,
+                      const std::map<std::string, std::set<float>>* only_tilts = nullptr, bool count_frames = true,
+                      StationCost* cost = nullptr);
+    bool publish_base_scan(const DiscoveryItem& item, const FrameFetcherConfig& config, const std::shared_ptr<BufferPool>& buffer_pool,
+                           const CancellationToken& cancel, std::vector<uint8_t>& raw, size_t& object_size, bool base_only,
+                           StationCost* cost = nullptr);
+    void requeue_volume(const std::string& station, const std::string& timestamp);
+    void resume_outstanding_work();
 
     // Logging helpers
     void log_info(const std::string& msg) const;
@@ -0,0 +1,80 @@
+/**
+ * BitmaskCodec.h - Expand .RDA bitmask + packed values into dense grids
+ *
+ * Uses an SSSE3 byte shuffle per bitmask byte when the CPU supports it (one
+ * table lookup places all eight cells) and a scalar loop otherwise. The
+ * implementation is selected once at first use. RankIndex answers single
+ * cell lookups without expanding anything.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace BitmaskCodec {
+
+/**
+ * 256-entry dequantization table for one product. Level 0 is "no data" and
+ * maps to `empty`; level v maps to value_min + v / 255 * (value_max - value_min).
+ */
+struct DequantTable {
+    float value[256];
+};
+
+DequantTable dequant_table(float value_min, float value_max, float empty);
+
+/**
+ * @brief Expand `cells` cells starting at bit `first_bit` of the bitmask.
+ *
+ * Set bits take the next entry of `values`; clear bits, and set bits past
+ * the end of `values`, are written as level 0. Returns the number of values
+ * consumed.
+ */
+size_t expand(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count, uint8_t* out);
+
+/**
+ * @brief Same as above with each level mapped through `table`.
+ */
+size_t expand(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count,
+              const DequantTable& table, float* out);
+
+/**
+ * @brief True if the SIMD path is in use.
+ */
+bool simd_accelerated();
+
+/**
+ * Rank structure over a bitmask: the number of set bits before every
+ * 512-bit superblock. rank(bit) is the position of that cell's value in the
+ * packed values array and costs one table read plus at most eight 64-bit
+ * popcounts. Holds a pointer to the bitmask, which must outlive it.
+ */
+class RankIndex {
+public:
+    static constexpr size_t SUPERBLOCK_BITS = 512;
+
+    RankIndex() = default;
+    RankIndex(const uint8_t* bitmask, size_t bits);
+
+    bool test(size_t bit) const { return bitmask_[bit >> 3] & (0x80 >> (bit & 7)); }
+
+    /**
+     * @brief Number of set bits in [0, bit).
+     */
+    size_t rank(size_t bit) const;
+
+    size_t size() const { return bits_; }
+    size_t count() const { return ones_; }
+
+private:
+    uint64_t word(size_t index) const;
+
+    const uint8_t* bitmask_ = nullptr;
+    size_t bits_ = 0;
+    size_t ones_ = 0;
+    std::vector<uint32_t> superblocks_;
+};
+
+} // namespace BitmaskCodec
@@ -0,0 +1,80 @@
+/**
+ * BulkDiscovery.h - Find new objects under a NEXRAD day prefix in few listings
+ *
+ * Keys are "YYYY/MM/DD/STATION/STATIONYYYYMMDD_HHMMSS_V06", so one listing of
+ * a day prefix returns every station's objects, station by station. A single
+ * StartAfter cannot skip what was seen before (each station has its own
+ * high-water mark), so the prefix is split into station ranges that are
+ * listed independently. Each listing seeks past the objects of its current
+ * station that are at or below that station's mark, using StartAfter.
+ *
+ * Listing is supplied by the caller, which keeps this free of the AWS SDK.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+
+namespace BulkDiscovery {
+
+/**
+ * One ListObjectsV2 response: keys in order, and whether more follow.
+ */
+struct Page {
+    std::vector<std::string> keys;
+    bool truncated = false;
+};
+
+/**
+ * Lists keys under `prefix` that sort after `start_after`. Returns false on failure.
+ */
+using ListPage = std::function<bool(const std::string& prefix, const std::string& start_after, Page& page)>;
+
+/**
+ * Part of a day prefix listed on its own: keys after `start_after` and below
+ * `end` (no bound if empty).
+ */
+struct Range {
+    std::string start_after;
+    std::string end;
+};
+
+struct Result {
+    std::map<std::string, std::vector<std::string>> keys;  // New keys per station, in order
+    size_t requests = 0;
+    size_t keys_listed = 0;
+    bool complete = true;                                 // False if a listing failed
+};
+
+/**
+ * @brief Station of a key, or of a "YYYY/MM/DD/STATION" bound. Empty if malformed.
+ */
+std::string station_of(const std::string& key);
+
+/**
+ * @brief Split `prefix` into at most `count` ranges at known station names.
+ *
+ * The first range starts at the beginning of the prefix, so stations not in
+ * `marks` yet are still listed.
+ */
+std::vector<Range> partition(const std::string& prefix, const std::map<std::string, std::string>& marks, size_t count);
+
+/**
+ * @brief List one range and collect keys above their station's mark.
+ *
+ * Keys are only ever skipped inside a station whose mark is above them, so a
+ * partial result (after a failed listing) is still a gap-free continuation
+ * of every station's marks.
+ */
+void scan(const std::string& prefix, const Range& range, const std::map<std::string, std::string>& marks, const ListPage& list,
+          Result& result, const std::function<bool()>& stopped = {});
+
+/**
+ * @brief Add another range's result to `into`.
+ */
+void merge(Result& into, Result&& from);
+
+} // namespace BulkDiscovery
@@ -0,0 +1,62 @@
+/**
+ * CancellationToken.h - Hierarchical cooperative cancellation with deadlines
+ *
+ * A token is a cheap handle to shared state. child() derives a token that is
+ * cancelled whenever its parent is, and that can also be cancelled on its
+ * own or run out of time, without affecting the parent. The fetcher keeps
+ * one token for the process, one per generation of worker pools (what a
+ * batch runs under) and one per object, which carries the object's deadline.
+ *
+ * Work checks cancelled() at coarse boundaries (a read chunk, a tilt, a
+ * sweep) rather than per gate. A check is one relaxed load per level plus a
+ * clock read when a deadline is set.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+class CancellationToken {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Reason {
+        None,
+        Cancelled,         // cancel() on this token or an ancestor
+        DeadlineExceeded   // This token's or an ancestor's deadline passed
+    };
+
+    /**
+     * @brief A root token: never cancelled until cancel() is called on it.
+     */
+    CancellationToken();
+
+    /**
+     * @brief Token cancelled with this one. Its deadline is the earlier of
+     * this token's and `deadline`.
+     */
+    CancellationToken child(Clock::time_point deadline = Clock::time_point::max()) const;
+    CancellationToken child(Clock::duration timeout) const { return child(Clock::now() + timeout); }
+
+    /**
+     * @brief Cancel this token and every token derived from it. Idempotent.
+     */
+    void cancel() const;
+
+    bool cancelled() const { return reason() != Reason::None; }
+    Reason reason() const;
+    Clock::time_point deadline() const { return state_->deadline; }
+
+private:
+    struct State {
+        std::atomic<bool> cancelled{false};
+        Clock::time_point deadline = Clock::time_point::max();
+        std::shared_ptr<const State> parent;
+    };
+
+    explicit CancellationToken(std::shared_ptr<State> state) : state_(std::move(state)) {}
+
+    std::shared_ptr<State> state_;
+};
@@ -0,0 +1,27 @@
+/**
+ * Checksum.h - CRC32C (Castagnoli) checksums for stored frames
+ *
+ * Uses the SSE4.2 crc32 instruction when the CPU supports it and falls back
+ * to a slicing-by-8 table implementation otherwise. The implementation is
+ * selected once at first use.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Checksum {
+
+/**
+ * @brief Compute (or extend) a CRC32C.
+ * @param crc Result of a previous call to continue a running checksum, 0 to start.
+ */
+uint32_t crc32c(const uint8_t* data, size_t size, uint32_t crc = 0);
+
+/**
+ * @brief True if the hardware-accelerated path is in use.
+ */
+bool crc32c_hardware_accelerated();
+
+} // namespace Checksum
@@ -0,0 +1,65 @@
+/**
+ * ContextPool.h - Idle codec contexts kept for reuse across calls and threads
+ *
+ * Compression contexts (z_stream, bzip2 decoder memory) are expensive to set
+ * up and cheap to reset. A pool hands out an idle context, or creates one when
+ * every context is busy, and takes it back when the lease ends; the pool only
+ * ever grows to the peak number of concurrent users.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace levelii {
+
+template <typename T>
+class ContextPool {
+public:
+    class Lease {
+    public:
+        Lease(ContextPool& pool, std::unique_ptr<T> context) : pool_(pool), context_(std::move(context)) {}
+        ~Lease() { pool_.release(std::move(context_)); }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        T& operator*() const { return *context_; }
+        T* operator->() const { return context_.get(); }
+        T* get() const { return context_.get(); }
+
+    private:
+        ContextPool& pool_;
+        std::unique_ptr<T> context_;
+    };
+
+    Lease acquire() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!idle_.empty()) {
+                std::unique_ptr<T> context = std::move(idle_.back());
+                idle_.pop_back();
+                return Lease(*this, std::move(context));
+            }
+        }
+        return Lease(*this, std::make_unique<T>());
+    }
+
+    size_t idle() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return idle_.size();
+    }
+
+private:
+    void release(std::unique_ptr<T> context) {
+        if (!context) return;
+        std::lock_guard<std::mutex> lock(mutex_);
+        idle_.push_back(std::move(context));
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<T>> idle_;
+};
+
+}  // namespace levelii
@@ -6,6 +6,7 @@
 
 #include <string>
 #include <vector>
+#include <utility>
 #include <mutex>
 #include <sqlite3.h>
 #include <nlohmann/json.hpp>
@@ -27,20 +28,37 @@ public:
     bool execute(const std::string& sql);
 
     /**
-     * @brief Execute an INSERT/REPLACE with parameters
+     * @brief Insert a frame row, or update an existing row in place (its rowid is kept)
+     * @param crc32c Payload checksum of the file, or -1 to store NULL.
      */
     bool insert_frame(const std::string& table,
                      const std::string& station,
                      int product_code,
                      const std::string& product_name,
                      const std::string& timestamp,
-                     const std::string& filename);
+                     const std::string& filename,
+                     int64_t crc32c = -1);
 
     /**
      * @brief Execute a query and return results as a list of JSON objects
      */
     nlohmann::json query(const std::string& sql);
 
+    /**
+     * @brief Execute a non-query statement with text parameters bound to '?' placeholders
+     */
+    bool execute_params(const std::string& sql, const std::vector<std::string>& params);
+
+    /**
+     * @brief Execute a query with text parameters bound to '?' placeholders
+     */
+    nlohmann::json query_params(const std::string& sql, const std::vector<std::string>& params);
+
+    /**
+     * @brief Run several parameterized statements in one transaction; all or none take effect
+     */
+    bool execute_transaction(const std::vector<std::pair<std::string, std::vector<std::string>>>& statements);
+
     /**
      * @brief Purge old records for a station
      */
@@ -57,6 +75,7 @@ private:
     std::string db_path_;
 
     void initialize_schema();
+    nlohmann::json collect_rows(sqlite3_stmt* stmt);
 };
 
 } // namespace levelii
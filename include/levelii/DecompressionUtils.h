@@ -9,6 +9,7 @@
 
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 #include <string>
 
 namespace RadarDecompression {
@@ -32,9 +33,30 @@ constexpr uint32_t NEXRAD_MAGIC = 0x41523256;  // "AR2V"
  * 
  * @param data Input data (may be compressed or uncompressed)
  * @param decompressed Output decompressed data
+ * @param threads Files that are one bzip2 stream are split at their ~900 KB
+ *        block boundaries and the blocks decoded on up to this many threads.
+ *        Output is identical to a sequential decode.
  * @return true if decompression succeeded (or data was already uncompressed)
  */
 bool auto_decompress(const std::vector<uint8_t>& data, 
-                     std::vector<uint8_t>& decompressed);
+                     std::vector<uint8_t>& decompressed,
+                     int threads = 1);
+
+/**
+ * Length of the leading part of an LDM-format Archive II file that holds
+ * only whole records: the volume header plus every record whose control
+ * word and bzip2 block are both inside `size` bytes. Archive II is written
+ * in scan order, so a prefix of a file decodes to the first sweeps.
+ *
+ * @return 0 if the data is not LDM-format or no record is complete yet
+ */
+size_t complete_ldm_prefix(const uint8_t* data, size_t size);
+
+/**
+ * Decoder buffers allocated for bzip2 since startup. Decoder memory is pooled
+ * and reused across streams, so this stays flat once every concurrent decode
+ * has warmed up a pool entry.
+ */
+uint64_t bz2_arena_allocations();
 
 }  // namespace RadarDecompression
@@ -0,0 +1,100 @@
+/**
+ * DegradationController - Load shedding levels for when ingest falls behind
+ *
+ * Every volume costs the same CPU whether it is current or half an hour
+ * stale, so an overloaded fetcher just gets later. The controller watches
+ * how long volumes wait in the discovery queue and how many are queued or in
+ * flight, and steps processing down one level at a time while either is over
+ * its degrade mark. Each level keeps the shedding of the levels before it:
+ *
+ *   Full              Everything configured
+ *   NoVolumetric      No 3D generation or volumetric files
+ *   BaseTilts         Only the lowest tilts of each product are stored
+ *   PriorityProducts  Only the priority products are decoded
+ *   LatestOnly        Volumes older than the newest known for their station are skipped
+ *
+ * It steps back up one level at a time once both signals have stayed under
+ * their lower restore marks for hold_seconds, so a queue hovering around one
+ * mark does not flap between levels.
+ *
+ * Thread-safe: the fetch loop updates it, stage workers count what they shed.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+class DegradationController {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Level {
+        Full = 0,
+        NoVolumetric,
+        BaseTilts,
+        PriorityProducts,
+        LatestOnly
+    };
+    static constexpr size_t LEVEL_COUNT = 5;
+
+    struct Config {
+        bool enabled = true;
+        double degrade_wait_seconds = 120.0;   // Queue wait that steps down a level
+        double restore_wait_seconds = 30.0;
+        size_t degrade_backlog = 200;          // Volumes queued or in flight that steps down a level
+        size_t restore_backlog = 20;
+        double step_seconds = 30.0;            // Least time between two steps down
+        double hold_seconds = 60.0;            // Time under both restore marks before each step up
+    };
+
+    struct Stats {
+        Level level = Level::Full;
+        uint64_t degrades = 0;                 // Steps down
+        uint64_t restores = 0;                 // Steps up
+        std::array<double, LEVEL_COUNT> seconds_at_level{};
+        uint64_t volumetric_skipped = 0;       // Volumes stored without 3D generation
+        uint64_t tilts_skipped = 0;
+        uint64_t products_dropped = 0;         // Products left out of a volume's decode
+        uint64_t stale_skipped = 0;            // Volumes skipped for a newer one
+        uint64_t backfilled = 0;               // Shed volumes queued again in full
+    };
+
+    DegradationController();
+    explicit DegradationController(const Config& config);
+
+    void set_config(const Config& config);
+
+    /**
+     * @brief Feed the current signals and get the level to process at.
+     * @param wait_seconds How long the volumes just taken off the queue waited in it
+     * @param backlog Volumes queued plus volumes in the pipeline
+     */
+    Level update(double wait_seconds, size_t backlog, Clock::time_point now = Clock::now());
+
+    Level level() const;
+
+    void count_volumetric_skipped(uint64_t volumes = 1);
+    void count_tilts_skipped(uint64_t tilts);
+    void count_products_dropped(uint64_t products);
+    void count_stale_skipped(uint64_t volumes = 1);
+    void count_backfilled(uint64_t volumes);
+
+    Stats stats(Clock::time_point now = Clock::now()) const;
+
+    static const char* level_name(Level level);
+
+private:
+    Config config_;
+    Level level_ = Level::Full;
+    Clock::time_point changed_at_;             // Last level change, or construction
+    Clock::time_point calm_since_;             // Start of the current run under both restore marks
+    bool calm_ = false;
+    Stats stats_;
+    mutable std::mutex mutex_;
+
+    void set_level(Level level, Clock::time_point now);
+};
@@ -0,0 +1,74 @@
+/**
+ * DurableWorkQueue.h - Restart-safe record of discovered but unprocessed objects
+ *
+ * Every object handed from discovery to the fetch pool is written to the
+ * levelii_work_queue table of index.db before the station's last_processed_key
+ * moves past it, and acknowledged once its frames are stored or it turns out
+ * to be unfetchable. Transient failures are retried in the same run. Whatever
+ * is still in the table on startup is exactly the work a previous run dropped.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <set>
+#include <mutex>
+#include "levelii/DatabaseUtils.h"
+
+class DurableWorkQueue {
+public:
+    struct Item {
+        std::string station;
+        std::string key;
+        std::string bucket;
+        std::string timestamp;
+    };
+
+    /**
+     * @param max_attempts Items retried or recovered this many times without being acknowledged
+     *        are dropped, so an object that keeps failing or crashes the process cannot wedge startup.
+     */
+    explicit DurableWorkQueue(levelii::SQLiteDatabase& db, int max_attempts = 3);
+
+    /**
+     * @brief Record items as outstanding.
+     * @return The items that were not already outstanding, in input order.
+     */
+    std::vector<Item> add(const std::vector<Item>& items);
+
+    /**
+     * @brief Mark items as done (stored, or permanently unfetchable).
+     *
+     * The object key stays on record by station and timestamp, for source().
+     */
+    void ack(const std::vector<std::string>& keys);
+
+    /**
+     * @brief The object an acknowledged volume was fetched from, so it can be fetched again.
+     * @return false if no object is on record for the volume.
+     */
+    bool source(const std::string& station, const std::string& timestamp, Item& out) const;
+
+    /**
+     * @brief Count a failed delivery of an outstanding item.
+     * @return true if the item should be delivered again; false if it was dropped
+     *         after max_attempts, or is not outstanding.
+     */
+    bool retry(const std::string& key);
+
+    /**
+     * @brief Outstanding items left by a previous run, oldest first.
+     *
+     * Each call counts as one delivery attempt for every returned item.
+     */
+    std::vector<Item> recover();
+
+    size_t size() const;
+
+private:
+    levelii::SQLiteDatabase& db_;
+    int max_attempts_;
+    mutable std::mutex mutex_;
+    std::set<std::string> outstanding_;
+};
@@ -0,0 +1,108 @@
+/**
+ * FairBatchQueue.h - Per-station discovery queue with deficit round robin
+ *
+ * Replaces a single FIFO of station batches, where one station's catch-up
+ * backlog could hold every other station's newest volume behind it. Items
+ * are kept in one sub-queue per station, oldest first. pop() hands out:
+ *
+ * 1. The newest item of any station that has one newer than everything
+ *    already handed out for it, round robin across such stations, as a
+ *    batch of one.
+ * 2. Otherwise a batch of the oldest items of the next station in deficit
+ *    round robin order. Each turn adds quantum * weight items of credit, so
+ *    a station with weight 2 gets twice the share of a backlogged fetch pool.
+ *
+ * Not thread-safe; the owner guards it like the std::queue it replaces.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+
+/**
+ * DiscoveryItem - Metadata for a discovered NEXRAD frame to be processed
+ */
+struct DiscoveryItem {
+    std::string station;
+    std::string key;
+    std::string bucket;
+    std::string timestamp;
+    std::chrono::steady_clock::time_point queued_at{};  // Set by FairBatchQueue::push
+};
+
+/**
+ * DiscoveryBatch - A group of discovery items, usually for the same station,
+ * to be processed sequentially on a single thread.
+ */
+struct DiscoveryBatch {
+    std::string station;
+    std::vector<DiscoveryItem> items;
+};
+
+class FairBatchQueue {
+public:
+    /**
+     * @param max_batch Most items handed out in one batch.
+     * @param quantum Items of credit a weight-1 station gets per round.
+     */
+    explicit FairBatchQueue(size_t max_batch = 5, size_t quantum = 5);
+
+    /**
+     * @brief Share of a station relative to the default of 1.0. Values <= 0 reset it.
+     */
+    void set_weight(const std::string& station, double weight);
+    void set_weights(const std::map<std::string, double>& weights);
+
+    /**
+     * @brief Queue items; each goes to the sub-queue of its own station.
+     */
+    void push(std::vector<DiscoveryItem> items);
+
+    /**
+     * @brief Take the next batch. Returns false if nothing is queued.
+     */
+    bool pop(DiscoveryBatch& batch);
+
+    bool empty() const { return items_ == 0; }
+    size_t size() const { return items_; }
+
+    /**
+     * @brief Batches of at most max_batch items the queued items make up.
+     */
+    size_t batches() const;
+
+    /**
+     * @brief Stations with queued items.
+     */
+    size_t stations() const;
+
+    /**
+     * @brief Newest timestamp of a station queued or handed out so far, empty if none.
+     */
+    std::string newest(const std::string& station) const;
+
+    void clear();
+
+private:
+    struct Station {
+        std::deque<DiscoveryItem> items;    // Ordered by timestamp
+        std::string newest_dispatched;      // Newest timestamp handed out so far
+        double weight = 1.0;
+        double deficit = 0.0;
+        bool scheduled = false;             // In round_
+        bool fresh = false;                 // In fresh_
+    };
+
+    size_t max_batch_;
+    size_t quantum_;
+    size_t items_ = 0;
+    std::map<std::string, Station> stations_;
+    std::deque<std::string> fresh_;    // Stations with an item newer than newest_dispatched
+    std::deque<std::string> round_;    // Deficit round robin order
+
+    bool pop_fresh(DiscoveryBatch& batch);
+};
@@ -9,6 +9,11 @@
  * - JSON index generation and maintenance
  * - Memory-efficient parsing (parse to disk, clear memory)
  * - Automatic cleanup of old frames
+ * - Optional time-chunked archive for per-location time-series queries
+ * - Optional object-store sink that uploads each completed volume
+ * - CRC32C per file (gzip header + index) with an optional background scrubber
+ * - Durable queue of fetch work outstanding across restarts
+ * - Optional hot/warm/cold tiers with background migration and recompression
  */
 
 #pragma once
@@ -25,14 +30,21 @@
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include "levelii/RadarFrame.h"
 #include "levelii/DatabaseUtils.h"
+#include "levelii/TimeSeriesArchive.h"
+#include "levelii/ObjectSink.h"
+#include "levelii/DurableWorkQueue.h"
+#include "levelii/BitmaskCodec.h"
 #include <memory>
 
 using json = nlohmann::json;
 namespace fs = std::filesystem;
 
 constexpr size_t MAX_INDEX_CACHE_SIZE = 64;
+// Rays per independently compressed block in single-tilt .RDA files
+constexpr size_t RAY_BLOCK = 16;
 
 struct AsyncWriteTask {
     enum Type {
@@ -75,11 +87,188 @@ public:
         std::string file_path;
     };
 
+    /**
+     * Read-only byte range. Used for payloads that point into a buffer owned
+     * elsewhere, so loading a frame does not copy it.
+     */
+    class ByteView {
+    public:
+        ByteView() = default;
+        ByteView(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+        const uint8_t* begin() const { return data_; }
+        const uint8_t* end() const { return data_ + size_; }
+        uint8_t operator[](size_t i) const { return data_[i]; }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    /**
+     * A loaded .RDA file. binary_data views the payload inside `inflated`,
+     * the whole decompressed file; copies re-point the view at their own buffer.
+     */
     struct CompressedFrameData {
         json metadata;
-        std::vector<uint8_t> binary_data;
+        ByteView binary_data;
+        std::vector<uint8_t> inflated;
+
+        CompressedFrameData() = default;
+        CompressedFrameData(CompressedFrameData&&) = default;
+        CompressedFrameData& operator=(CompressedFrameData&&) = default;
+        CompressedFrameData(const CompressedFrameData& other)
+            : metadata(other.metadata), inflated(other.inflated) {
+            binary_data = other.rebased(inflated);
+        }
+        CompressedFrameData& operator=(const CompressedFrameData& other) {
+            if (this != &other) {
+                metadata = other.metadata;
+                inflated = other.inflated;
+                binary_data = other.rebased(inflated);
+            }
+            return *this;
+        }
+
+    private:
+        ByteView rebased(const std::vector<uint8_t>& buffer) const {
+            if (binary_data.empty()) return ByteView();
+            return ByteView(buffer.data() + (binary_data.data() - inflated.data()), binary_data.size());
+        }
     };
 
+    /**
+     * Several tilts of one volume loaded by load_volume. All payloads live in
+     * the single `inflated` buffer; each tilt's binary_data is a view into it.
+     * Move-only, since copying would leave the views on the old buffer.
+     */
+    struct VolumeData {
+        struct Tilt {
+            float tilt = 0.0f;
+            bool loaded = false;        // False if the file was missing or corrupt
+            json metadata;
+            ByteView binary_data;
+        };
+
+        std::vector<Tilt> tilts;
+        std::vector<uint8_t> inflated;
+
+        VolumeData() = default;
+        VolumeData(VolumeData&&) = default;
+        VolumeData& operator=(VolumeData&&) = default;
+        VolumeData(const VolumeData&) = delete;
+        VolumeData& operator=(const VolumeData&) = delete;
+    };
+
+    /**
+     * Part of one tilt cut out by load_frame_sector: a dense grid of
+     * num_rays x num_gates quantized levels, 0 meaning no data. Rows start at
+     * ray first_ray and wrap from the last ray back to ray 0.
+     */
+    struct FrameSector {
+        json metadata;
+        uint16_t first_ray = 0;
+        uint16_t num_rays = 0;
+        uint16_t first_gate = 0;
+        uint16_t num_gates = 0;
+        std::vector<uint8_t> values;
+        size_t bytes_read = 0;      // File bytes read to serve the request
+    };
+
+    /**
+     * One tilt held in memory for point queries, filled by open_frame_points.
+     * Keeps the packed payload and a rank index over its bitmask, so each
+     * sample is a constant-time lookup and nothing is expanded. Move-only,
+     * since the index points into the payload.
+     */
+    class FramePoints {
+    public:
+        struct Point {
+            float azimuth = 0.0f;       // Degrees clockwise from north
+            float range = 0.0f;         // Meters from the radar
+        };
+
+        FramePoints() = default;
+        FramePoints(FramePoints&&) = default;
+        FramePoints& operator=(FramePoints&&) = default;
+        FramePoints(const FramePoints&) = delete;
+        FramePoints& operator=(const FramePoints&) = delete;
+
+        const json& metadata() const { return frame_.metadata; }
+
+        /**
+         * @brief Quantized level of one cell, 0 for no data or a cell outside the tilt.
+         */
+        uint8_t level(size_t ray, size_t gate) const;
+
+        /**
+         * @brief Level at each point, using the same azimuth and range rounding as load_frame_sector.
+         */
+        void sample(const std::vector<Point>& points, std::vector<uint8_t>& levels) const;
+
+    private:
+        friend class FrameStorageManager;
+
+        CompressedFrameData frame_;
+        BitmaskCodec::RankIndex rank_;
+        const uint8_t* values_ = nullptr;
+        size_t value_count_ = 0;
+        size_t num_rays_ = 0;
+        size_t num_gates_ = 0;
+        float gate_spacing_ = 0.0f;
+        float first_gate_ = 0.0f;
+    };
+
+    struct ScrubberConfig {
+        size_t bytes_per_second = 8 * 1024 * 1024;  // Read budget; the scrubber sleeps to stay under it
+        int pass_interval_seconds = 3600;           // Pause between full walks of the index
+    };
+
+    struct ScrubStats {
+        size_t files_checked = 0;
+        size_t bytes_checked = 0;
+        size_t corrupt_found = 0;
+        size_t unchecked = 0;       // Files written before checksums were recorded
+        size_t passes_completed = 0;
+    };
+
+    /**
+     * Storage roots for older volumes. base_path is the hot tier; every entry
+     * adds a colder tier with the same STATION/product/timestamp layout.
+     */
+    struct TieringConfig {
+        struct Tier {
+            std::string root;
+            int min_age_minutes = 0;    // Volumes at least this old (by data timestamp) move here
+            int gzip_level = 9;         // Files are recompressed to this level on the way in; 0 copies them as is
+        };
+
+        std::vector<Tier> tiers;        // Sorted hot to cold by min_age_minutes when tiering is enabled
+        int hot_gzip_level = 9;         // Level for frames written to the hot tier
+        int hot_reads = 8;              // Reads within one scan that bring a colder volume back to the hot tier
+        int scan_interval_seconds = 300;  // 0: no background thread, call migrate_tiers() directly
+        size_t bytes_per_second = 32 * 1024 * 1024;  // Migration read budget
+    };
+
+    struct TieringStats {
+        size_t volumes_demoted = 0;
+        size_t volumes_promoted = 0;
+        size_t bytes_read = 0;
+        size_t bytes_written = 0;
+        size_t failures = 0;
+        size_t scans_completed = 0;
+    };
+
+    /**
+     * Called from the scrubber thread after a corrupt file has been removed
+     * from disk and from the index.
+     */
+    using CorruptFrameCallback = std::function<void(const std::string& station, const std::string& product,
+                                                    const std::string& timestamp, const std::string& filename)>;
+
     /**
      * @brief Construct a new Frame Storage Manager
      * @param base_path Root directory for all stored radar data.
@@ -95,12 +284,14 @@ public:
     void enqueue_async_write(AsyncWriteTask&& task);
     
     /**
-     * @brief Stop the async storage thread and wait for pending tasks to complete.
+     * @brief Stop the async storage thread after writing every task already queued.
      */
     void shutdown_async_storage();
 
     /**
      * @brief Save a single frame using bitmask compression.
+     * @param auto_update_index If true, indexes the file immediately; otherwise its row waits for update_index().
+     * @param stored_bytes If set, receives the size of the file written.
      */
     bool save_frame_bitmask(
         const std::string& station,
@@ -114,7 +305,8 @@ public:
         const std::vector<uint8_t>& bitmask,
         const std::vector<uint8_t>& values,
         const RadarFrame::DualPolMetadata& dualpol_meta = {},
-        bool auto_update_index = true
+        bool auto_update_index = true,
+        size_t* stored_bytes = nullptr
     );
     
     /**
@@ -131,7 +323,8 @@ public:
      * @param bitmask Packed bitmask of valid data points.
      * @param values Vector of quantized data values.
      * @param dualpol_meta Dual-polarimetric metadata.
-     * @param auto_update_index If true, regenerates the product index immediately.
+     * @param auto_update_index If true, indexes the file immediately; otherwise its row waits for update_index().
+     * @param stored_bytes If set, receives the size of the file written.
      * @return true if saved successfully.
      */
     bool save_volumetric_bitmask(
@@ -146,11 +339,14 @@ public:
         const std::vector<uint8_t>& bitmask,
         const std::vector<uint8_t>& values,
         const RadarFrame::DualPolMetadata& dualpol_meta = {},
-        bool auto_update_index = true
+        bool auto_update_index = true,
+        size_t* stored_bytes = nullptr
     );
 
     /**
      * @brief Load a frame's compressed bitmask data from disk.
+     *
+     * Concurrent loads of the same tilt are coalesced; see load_frame_shared.
      */
     bool load_frame_bitmask(
         const std::string& station,
@@ -160,6 +356,29 @@ public:
         CompressedFrameData& out_data
     ) const;
 
+    /**
+     * @brief Load a frame, sharing the load with concurrent callers asking for the same tilt.
+     *
+     * A caller that arrives while the same (station, product, timestamp, tilt)
+     * is being loaded waits for that load and gets its result instead of
+     * reading and inflating the file again. Nothing is kept afterwards: the
+     * next caller once the load is done starts a new one.
+     * @return nullptr if the frame is missing or corrupt
+     */
+    std::shared_ptr<const CompressedFrameData> load_frame_shared(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        float tilt
+    ) const;
+
+    struct ReadStats {
+        size_t loads = 0;       // Frame files read and inflated by load_frame_bitmask/load_frame_shared
+        size_t coalesced = 0;   // Requests served by a load another caller had in flight
+    };
+
+    ReadStats get_read_stats() const;
+
     /**
      * @brief Load a volumetric dataset's compressed bitmask data from disk.
      */
@@ -170,6 +389,103 @@ public:
         CompressedFrameData& out_data
     ) const;
 
+    /**
+     * @brief Load a tilt as a dense rays x gates grid of quantized levels, 0 where there is no data.
+     */
+    bool load_frame_grid(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        float tilt,
+        std::vector<uint8_t>& grid,
+        json* metadata = nullptr
+    ) const;
+
+    /**
+     * @brief Load a tilt as a dense rays x gates grid of physical values, NaN where there is no data.
+     * @param params Quantization range of the product, from get_quant_params().
+     */
+    bool load_frame_grid(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        float tilt,
+        const QuantizationParams& params,
+        std::vector<float>& grid,
+        json* metadata = nullptr
+    ) const;
+
+    /**
+     * @brief Load the rays covering [azimuth_start, azimuth_end] degrees clockwise
+     *        and the gates covering [min_range, max_range] meters of one tilt.
+     *
+     * Tilt files are written in independently compressed blocks of RAY_BLOCK
+     * rays with an index in the metadata, so only the header and the blocks
+     * under the sector are read and inflated; each block is checked by its own
+     * gzip CRC. Files written before the index existed are read whole.
+     * max_range <= 0 means to the last gate. A single azimuth and range gives
+     * a point query.
+     */
+    bool load_frame_sector(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        float tilt,
+        float azimuth_start,
+        float azimuth_end,
+        float min_range,
+        float max_range,
+        FrameSector& out
+    ) const;
+
+    /**
+     * @brief Load one tilt and index it for point queries.
+     */
+    bool open_frame_points(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        float tilt,
+        FramePoints& out
+    ) const;
+
+    /**
+     * @brief Sample one tilt at many (azimuth, range) points; see FramePoints::sample.
+     *
+     * Loads the tilt on every call. To sample the same tilt repeatedly, keep a
+     * FramePoints from open_frame_points instead.
+     */
+    bool sample_frame_points(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        float tilt,
+        const std::vector<FramePoints::Point>& points,
+        std::vector<uint8_t>& levels
+    ) const;
+
+    /**
+     * @brief Load several tilts of one volume at once.
+     *
+     * Every file is requested from the kernel up front, then read, verified and
+     * inflated on up to `threads` threads (0 = one per core) straight into one
+     * buffer sized from the gzip trailers. Tilts come back in the order asked
+     * for. Returns false if any tilt failed to load; the rest are still filled.
+     */
+    bool load_volume(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        const std::vector<float>& tilts,
+        VolumeData& out,
+        int threads = 0
+    ) const;
+
+    /**
+     * @brief Verify, inflate and split any .RDA file (single tilt or volumetric).
+     */
+    static bool read_frame_file(const std::string& file_path, CompressedFrameData& out_data);
+
     // Index management
     void update_index(const std::string& station, const std::string& product);
     json get_index(const std::string& station, const std::string& product) const;
@@ -186,6 +502,86 @@ public:
     
     // Cleanup operations
     void cleanup_old_frames(int max_frames_per_station = 30);
+
+    /**
+     * @brief Mirror every saved tilt into the time-series archive under base_path/_timeseries.
+     * @param retention_hours Chunks older than this are dropped by cleanup_old_frames().
+     *
+     * Must be called before frames are saved.
+     */
+    void enable_timeseries_archive(int retention_hours = 24);
+    bool timeseries_enabled() const { return timeseries_ != nullptr; }
+
+    /**
+     * @brief Query the time-series archive; returns an empty list if it is disabled.
+     */
+    std::vector<TimeSeriesArchive::Sample> query_timeseries(const TimeSeriesArchive::Query& q) const;
+
+    /**
+     * @brief Upload every published volume to an object store in addition to local disk.
+     *
+     * Upload state is kept in the levelii_uploads table; volumes still pending from a
+     * previous run are re-queued immediately. Must be called before frames are published.
+     */
+    void enable_object_sink(std::unique_ptr<ObjectStoreClient> client, const ObjectSinkConfig& config);
+    bool object_sink_enabled() const { return object_sink_ != nullptr; }
+
+    /**
+     * @brief Queue a fully written (station, product, timestamp) volume for upload.
+     *
+     * Blocks while the upload queue is full. No-op when no sink is configured.
+     */
+    void publish_volume(const std::string& station, const std::string& product, const std::string& timestamp);
+
+    /**
+     * @brief Wait for all queued uploads to finish.
+     */
+    void flush_object_sink();
+
+    ObjectSink::Stats get_object_sink_stats() const;
+
+    /**
+     * @brief Start a low-priority thread that re-verifies every indexed file's CRC32C.
+     *
+     * Files are read (never inflated) at most config.bytes_per_second. Corrupt files
+     * are deleted, dropped from the index and reported through on_corrupt so the
+     * caller can fetch the volume again.
+     */
+    void start_scrubber(const ScrubberConfig& config, CorruptFrameCallback on_corrupt = nullptr);
+    void stop_scrubber();
+    ScrubStats get_scrub_stats() const;
+
+    /**
+     * @brief Spread volumes over several storage roots by age and read frequency.
+     *
+     * Whole volumes move between tiers, recompressed to the destination's
+     * level, and every volume outside base_path is recorded in the
+     * levelii_tiers table. Reads and late writes find a volume through that
+     * table. The move of one volume commits in a single transaction; the old
+     * copy is removed on the next pass, so readers that resolved it just
+     * before still find their files. Copies left by an interrupted move are
+     * removed here. Must be called before frames are saved.
+     */
+    void enable_tiering(const TieringConfig& config);
+    bool tiering_enabled() const { return !tiering_.tiers.empty(); }
+    void stop_tiering();
+
+    /**
+     * @brief Move every volume whose tier is out of date; returns the number moved.
+     */
+    size_t migrate_tiers();
+
+    /**
+     * @brief Tier holding a volume: 0 for base_path, i for config.tiers[i - 1].
+     */
+    int volume_tier(const std::string& station, const std::string& product, const std::string& timestamp) const;
+
+    TieringStats get_tiering_stats() const;
+
+    /**
+     * @brief Fetch work that has been discovered but not yet stored, persisted in index.db.
+     */
+    DurableWorkQueue& work_queue() { return *work_queue_; }
     
     // Path utilities
     std::string get_frame_path(
@@ -206,6 +602,19 @@ public:
 private:
     std::string base_path_;
     std::unique_ptr<levelii::SQLiteDatabase> db_;
+    std::unique_ptr<TimeSeriesArchive> timeseries_;
+    int timeseries_retention_hours_ = 24;
+    std::unique_ptr<ObjectSink> object_sink_;
+    std::unique_ptr<DurableWorkQueue> work_queue_;
+
+    // Rows saved without auto_update_index, by station/product, with the checksum taken at save time
+    struct PendingIndexRow {
+        std::string timestamp;
+        std::string filename;
+        int64_t crc32c;
+    };
+    std::mutex pending_index_mutex_;
+    std::unordered_map<std::string, std::vector<PendingIndexRow>> pending_index_;
 
     // Incremental statistics tracking
     mutable std::mutex stats_mutex_;
@@ -222,9 +631,54 @@ private:
     std::atomic<bool> async_storage_stop_{false};
     
     const size_t MAX_WRITE_QUEUE_SIZE = 50;
+
+    // Background scrubber
+    std::thread scrubber_thread_;
+    std::mutex scrubber_mutex_;
+    std::condition_variable scrubber_cv_;
+    std::atomic<bool> scrubber_stop_{false};
+    mutable std::mutex scrub_stats_mutex_;
+    ScrubStats scrub_stats_;
     
+    // Storage tiers; no tiers unless enable_tiering was called
+    TieringConfig tiering_;
+    mutable std::mutex tier_mutex_;
+    std::unordered_map<std::string, int> volume_tiers_;         // Volumes outside base_path
+    mutable std::unordered_map<std::string, int> volume_reads_;  // Reads since the last pass
+    std::vector<std::string> stale_copies_;                    // Old copies removed on the next pass
+    TieringStats tiering_stats_;
+    std::mutex migrate_mutex_;
+    std::thread tiering_thread_;
+    std::mutex tiering_wait_mutex_;
+    std::condition_variable tiering_cv_;
+    std::atomic<bool> tiering_stop_{false};
+
+    // Frame loads in flight, by volume and file name, for load_frame_shared
+    struct FrameLoad;
+    mutable std::mutex frame_loads_mutex_;
+    mutable std::unordered_map<std::string, std::shared_ptr<FrameLoad>> frame_loads_;
+    mutable std::atomic<size_t> frames_loaded_{0};
+    mutable std::atomic<size_t> frames_coalesced_{0};
+
+    std::shared_ptr<CompressedFrameData> load_frame_coalesced(const std::string& station, const std::string& product,
+                                                              const std::string& timestamp, float tilt, bool& exclusive) const;
     void async_storage_loop();
+    void tiering_loop();
+    bool tiering_wait(std::chrono::milliseconds duration);
+    std::string tier_root(int tier) const;
+    int tier_level(int tier) const;
+    std::string volume_dir(const std::string& station, const std::string& product, const std::string& timestamp,
+                           bool read = false, int* tier = nullptr) const;
+    bool move_volume(const std::string& station, const std::string& product, const std::string& timestamp, int from, int to,
+                     size_t& bytes_read);
+    void remove_stale_copies();
+    void scrub_loop(ScrubberConfig config, CorruptFrameCallback on_corrupt);
+    bool scrubber_wait(std::chrono::milliseconds duration);
+    bool write_frame_file(const std::string& file_path, const std::vector<uint8_t>& compressed);
     void process_write_task(const AsyncWriteTask& task);
+    bool is_upload_pending(const std::string& station, const std::string& product, const std::string& timestamp) const;
+    void index_frame(const std::string& station, const std::string& product, const std::string& timestamp,
+                     const std::string& filename, int64_t crc32c, bool now);
     
     bool ensure_directory_exists(const std::string& path) const;
     std::string format_filename(
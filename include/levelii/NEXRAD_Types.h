@@ -63,6 +63,51 @@ struct Message31Header {
     uint32_t block_pointers[10]; // Data Block Pointers (Big Endian, offset from Message 31 start). Fixed size 10 as per ICD.
 };
 
+/**
+ * Message 5: Volume Coverage Pattern
+ * Sent once per volume in the metadata record, before the first radial.
+ * Followed by num_cuts Message5ElevationCut entries.
+ */
+struct Message5Header {
+    uint16_t pattern_size;      // Pattern size in halfwords (Big Endian)
+    uint16_t pattern_type;      // Pattern type (Big Endian)
+    uint16_t pattern_number;    // VCP number (Big Endian)
+    uint16_t num_cuts;          // Number of elevation cuts (Big Endian)
+    uint8_t version;            // VCP version
+    uint8_t clutter_map_group;  // Clutter map group number
+    uint8_t velocity_resolution; // Doppler velocity resolution (2 = 0.5 m/s, 4 = 1.0 m/s)
+    uint8_t pulse_width;        // Pulse width (2 = short, 4 = long)
+    uint16_t spare[5];
+};
+
+/**
+ * Message 5 elevation cut (46 bytes)
+ */
+struct Message5ElevationCut {
+    uint16_t elevation_angle;   // Binary angle: degrees = value * 180 / 32768 (Big Endian)
+    uint8_t channel_config;     // 0 = constant phase, 1 = random phase, 2 = SZ2 phase
+    uint8_t waveform;           // 1 = CS, 2 = CD/W, 3 = CD/WO, 4 = batch, 5 = staggered pulse pair
+    uint8_t super_res;          // SuperResFlags
+    uint8_t surveillance_prf;   // Surveillance PRF number
+    uint16_t surveillance_pulses; // Surveillance pulse count per radial (Big Endian)
+    uint16_t azimuth_rate;      // Azimuth rate (Big Endian)
+    uint16_t snr_thresholds[6]; // REF, VEL, SW, ZDR, PHI, RHO thresholds (Big Endian)
+    uint16_t doppler_sectors[9]; // 3 x (edge angle, PRF number, pulse count) (Big Endian)
+    uint16_t supplemental;      // Supplemental data flags (Big Endian)
+    uint16_t spare;
+    uint16_t ebc_angle;         // Elevation blockage correction angle (Big Endian)
+};
+
+/**
+ * Super resolution control bits of Message5ElevationCut::super_res
+ */
+enum SuperResFlags : uint8_t {
+    SUPER_RES_HALF_DEGREE_AZIMUTH = 0x01,   // 720 radials per sweep
+    SUPER_RES_QUARTER_KM_REFLECTIVITY = 0x02,
+    SUPER_RES_DOPPLER_300KM = 0x04,
+    SUPER_RES_DUAL_POL_300KM = 0x08
+};
+
 /**
  * Common Header for all Data Blocks
  */
@@ -157,6 +202,8 @@ namespace {
     constexpr size_t VOLUME_HEADER_SIZE = sizeof(VolumeHeader);
     constexpr size_t MESSAGE_HEADER_SIZE = sizeof(MessageHeader);
     constexpr size_t MESSAGE31_HEADER_MIN_SIZE = sizeof(Message31Header); // Includes 9 block pointers
+    constexpr size_t MESSAGE5_HEADER_SIZE = sizeof(Message5Header);
+    constexpr size_t MESSAGE5_CUT_SIZE = sizeof(Message5ElevationCut);
     constexpr size_t DATABLOCK_HEADER_SIZE = sizeof(DataBlock_Header);
     constexpr size_t DATABLOCK_VOLUME_SIZE = sizeof(DataBlock_Volume);
     constexpr size_t DATABLOCK_ELEVATION_SIZE = sizeof(DataBlock_Elevation);
@@ -0,0 +1,179 @@
+/**
+ * ObjectSink.h - Asynchronous object-store output for stored volumes
+ *
+ * Packs all .RDA files of one (station, product, timestamp) volume into a
+ * single object and uploads it with bounded concurrency and retries:
+ * PREFIX/STATION/product/YYYYMMDD_HHMMSS.rdapack
+ *
+ * Objects larger than the multipart threshold are sent as multipart uploads.
+ * A volume whose upload still fails after the per-request retries is queued
+ * again with a growing delay until it succeeds or the sink shuts down.
+ * The transport is abstracted behind ObjectStoreClient so any S3-compatible
+ * endpoint (or an in-memory stand-in for tests) can be used.
+ *
+ * Pack format:
+ * [4-byte magic "RDAP"][uint32 LE header size][JSON header][file payloads]
+ * JSON header: {"s": station, "p": product, "t": timestamp,
+ *               "files": [{"n": name, "o": offset, "z": size}, ...]}
+ * Offsets are relative to the first byte after the header.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <utility>
+#include <cstdint>
+
+/**
+ * @class ObjectStoreClient
+ * @brief Minimal S3-style transport used by ObjectSink.
+ *
+ * Implementations must be safe to call from several upload threads at once.
+ * All methods return false and fill `error` on failure.
+ */
+class ObjectStoreClient {
+public:
+    virtual ~ObjectStoreClient() = default;
+
+    virtual bool put_object(const std::string& key, const uint8_t* data, size_t size, std::string& error) = 0;
+
+    virtual bool create_multipart_upload(const std::string& key, std::string& upload_id, std::string& error) = 0;
+
+    virtual bool upload_part(
+        const std::string& key,
+        const std::string& upload_id,
+        int part_number,
+        const uint8_t* data,
+        size_t size,
+        std::string& etag,
+        std::string& error
+    ) = 0;
+
+    virtual bool complete_multipart_upload(
+        const std::string& key,
+        const std::string& upload_id,
+        const std::vector<std::string>& etags,
+        std::string& error
+    ) = 0;
+
+    virtual void abort_multipart_upload(const std::string& key, const std::string& upload_id) = 0;
+};
+
+struct ObjectSinkConfig {
+    std::string key_prefix;                        // Prepended to every object key (no trailing '/')
+    size_t multipart_threshold = 16 * 1024 * 1024; // Objects above this use multipart uploads
+    size_t part_size = 8 * 1024 * 1024;            // S3 requires >= 5 MiB for all but the last part
+    int max_concurrent_uploads = 4;
+    size_t max_queued_volumes = 64;                // enqueue() blocks beyond this
+    int max_retries = 5;                           // Per request, not per volume
+    int retry_base_delay_ms = 250;                 // Doubled after every failed attempt
+    int volume_retry_base_ms = 30 * 1000;          // A volume whose upload failed is queued again after this,
+    int volume_retry_max_ms = 30 * 60 * 1000;      // doubled after every further failure up to this cap
+};
+
+class ObjectSink {
+public:
+    struct Volume {
+        std::string station;
+        std::string product;
+        std::string timestamp;
+        std::vector<std::pair<std::string, std::string>> files; // (object name, local path)
+    };
+
+    /**
+     * @brief Called from an upload thread after every attempt: once the volume is durably
+     *        stored, or each time an attempt fails and the volume is set aside for a retry.
+     */
+    using CompletionCallback = std::function<void(const Volume& volume, const std::string& key, bool success)>;
+
+    struct Stats {
+        uint64_t volumes_uploaded = 0;
+        uint64_t volumes_failed = 0;
+        uint64_t bytes_uploaded = 0;
+        uint64_t retries = 0;
+        size_t queued = 0;
+        size_t in_flight = 0;
+        size_t waiting_retry = 0;   // Failed volumes waiting out their retry delay
+    };
+
+    ObjectSink(std::unique_ptr<ObjectStoreClient> client, const ObjectSinkConfig& config, CompletionCallback on_complete);
+    ~ObjectSink();
+
+    ObjectSink(const ObjectSink&) = delete;
+    ObjectSink& operator=(const ObjectSink&) = delete;
+
+    /**
+     * @brief Queue a volume for upload, blocking while the queue is full.
+     * @return false if the sink is shutting down.
+     */
+    bool enqueue(Volume volume);
+
+    /**
+     * @brief Block until every queued volume has been processed. Volumes waiting
+     *        to retry after a failed upload are not waited for.
+     */
+    void flush();
+
+    /**
+     * @brief Stop the upload threads after their current volume; queued and waiting volumes are dropped.
+     */
+    void shutdown();
+
+    Stats get_stats() const;
+
+    std::string object_key(const std::string& station, const std::string& product, const std::string& timestamp) const;
+
+    /**
+     * @brief Build a packed object from the volume's files; empty if any file is unreadable.
+     */
+    static std::vector<uint8_t> pack_volume(const Volume& volume);
+
+    /**
+     * @brief Split a packed object back into (name, bytes) entries.
+     */
+    static bool unpack_volume(
+        const uint8_t* data,
+        size_t size,
+        std::vector<std::pair<std::string, std::vector<uint8_t>>>& out_files
+    );
+
+private:
+    std::unique_ptr<ObjectStoreClient> client_;
+    ObjectSinkConfig config_;
+    CompletionCallback on_complete_;
+
+    struct Queued {
+        Volume volume;
+        int failures = 0;
+    };
+
+    std::deque<Queued> queue_;
+    std::multimap<std::chrono::steady_clock::time_point, Queued> retry_;  // By time due
+    mutable std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    std::condition_variable space_cv_;
+    std::condition_variable idle_cv_;
+    std::condition_variable stop_cv_;
+    size_t in_flight_ = 0;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+
+    std::atomic<uint64_t> volumes_uploaded_{0};
+    std::atomic<uint64_t> volumes_failed_{0};
+    std::atomic<uint64_t> bytes_uploaded_{0};
+    std::atomic<uint64_t> retries_{0};
+
+    void worker_loop();
+    bool upload(const std::string& key, const std::vector<uint8_t>& data);
+    bool with_retry(const std::string& what, const std::function<bool(std::string&)>& request);
+};
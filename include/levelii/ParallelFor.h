@@ -0,0 +1,58 @@
+/**
+ * ParallelFor.h - Fan a burst of independent jobs out over short-lived threads
+ *
+ * For work that belongs to a single call (the sweeps of one volume, the bzip2
+ * blocks of one file) and must finish before the call returns. The shared
+ * ThreadPool is sized for whole volumes; queueing sub-tasks behind them from
+ * inside one of its workers could deadlock.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace levelii {
+
+/**
+ * @brief Call job(i) for every i in [0, count) on up to `threads` threads.
+ *
+ * Indices are handed out in increasing order, so callers that sort the
+ * expensive jobs first get the best balance. The calling thread is one of
+ * the workers. If a job throws, remaining indices are abandoned and the
+ * first exception is rethrown once every thread has joined.
+ */
+template <typename Job>
+void parallel_for(size_t count, int threads, Job&& job) {
+    size_t workers = std::min(static_cast<size_t>(std::max(threads, 1)), count);
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; ++i) job(i);
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::exception_ptr failure;
+    std::mutex failure_mutex;
+    auto worker = [&]() {
+        try {
+            for (size_t i; (i = next.fetch_add(1)) < count;) job(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failure_mutex);
+            if (!failure) failure = std::current_exception();
+            next = count;
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t t = 1; t < workers; ++t) pool.emplace_back(worker);
+    worker();
+    for (auto& thread : pool) thread.join();
+    if (failure) std::rethrow_exception(failure);
+}
+
+}  // namespace levelii
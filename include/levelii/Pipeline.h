@@ -0,0 +1,290 @@
+/**
+ * Pipeline.h - Staged executor with bounded channels between stages
+ *
+ * Work moves through an ordered list of stages. Each stage has its own
+ * worker threads and a bounded input channel. A worker that finishes an
+ * item blocks until the next stage's channel has room, so a saturated stage
+ * slows everything upstream instead of letting queues grow without limit.
+ * Busy and blocked time per stage show which stage limits throughput, so
+ * CPU-bound stages can be given more cores and I/O-bound stages more
+ * concurrency independently.
+ *
+ * Items are moved from stage to stage, never copied. A step returns false
+ * to drop an item (failed or cancelled); later stages never see it.
+ *
+ * Channels use a mutex like ThreadPool's queue. Items here are whole
+ * volumes, so a hand-off costs nothing next to the work on either side.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace levelii {
+
+/**
+ * Bounded multi-producer, multi-consumer queue that can be closed.
+ */
+template <typename T>
+class Channel {
+public:
+    explicit Channel(size_t capacity) : capacity_(std::max<size_t>(1, capacity)) {}
+
+    /**
+     * @brief Move `item` in, blocking while the channel is full.
+     * @return false if the channel is closed; `item` is left untouched
+     */
+    bool push(T& item) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [this] { return closed_ || items_.size() < capacity_; });
+            if (closed_) return false;
+            items_.push_back(std::move(item));
+        }
+        not_empty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Move up to `max` items into `out`, blocking while the channel is empty.
+     * @return false once the channel is closed and drained
+     */
+    bool pop(std::vector<T>& out, size_t max = 1) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+            if (items_.empty()) return false;
+            while (!items_.empty() && out.size() < max) {
+                out.push_back(std::move(items_.front()));
+                items_.pop_front();
+            }
+        }
+        not_full_.notify_all();
+        return true;
+    }
+
+    /**
+     * @brief Refuse further pushes. Items already queued can still be popped.
+     */
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return items_.size();
+    }
+    size_t capacity() const { return capacity_; }
+
+private:
+    const size_t capacity_;
+    std::deque<T> items_;
+    bool closed_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+template <typename T>
+class Pipeline {
+public:
+    using Step = std::function<bool(T&)>;                    // false drops the item
+    using BatchStep = std::function<void(std::vector<T>&)>;  // Erase items to drop them
+
+    struct StageStats {
+        std::string name;
+        size_t workers = 0;
+        size_t active = 0;             // Workers inside the step right now
+        size_t queued = 0;             // Items waiting in the stage's input channel
+        size_t capacity = 0;
+        uint64_t processed = 0;        // Items the step was run on
+        uint64_t dropped = 0;          // Of those, items the step dropped
+        double busy_seconds = 0.0;     // Worker time spent in the step
+        double blocked_seconds = 0.0;  // Worker time spent waiting for room downstream
+        double utilization = 0.0;      // busy_seconds / (workers * uptime)
+    };
+
+    Pipeline() = default;
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    ~Pipeline() {
+        close();
+        join();
+    }
+
+    /**
+     * @brief Append a stage that runs `step` on one item at a time. Call before start().
+     */
+    void add_stage(std::string name, size_t workers, size_t capacity, Step step) {
+        add_batch_stage(std::move(name), workers, capacity, 1, [step = std::move(step)](std::vector<T>& items) {
+            size_t kept = 0;
+            for (size_t i = 0; i < items.size(); ++i) {
+                if (!step(items[i])) continue;
+                if (kept != i) items[kept] = std::move(items[i]);
+                ++kept;
+            }
+            items.erase(items.begin() + kept, items.end());
+        });
+    }
+
+    /**
+     * @brief Append a stage whose step gets up to `max_batch` queued items at once,
+     * for work that is cheaper done once per group. Call before start().
+     */
+    void add_batch_stage(std::string name, size_t workers, size_t capacity, size_t max_batch, BatchStep step) {
+        auto stage = std::make_unique<Stage>();
+        stage->name = std::move(name);
+        stage->workers = std::max<size_t>(1, workers);
+        stage->max_batch = std::max<size_t>(1, max_batch);
+        stage->step = std::move(step);
+        stage->input = std::make_unique<Channel<T>>(capacity);
+        stages_.push_back(std::move(stage));
+    }
+
+    void start() {
+        started_ = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < stages_.size(); ++i) {
+            stages_[i]->running.store(stages_[i]->workers);
+            for (size_t w = 0; w < stages_[i]->workers; ++w) threads_.emplace_back([this, i] { worker(i); });
+        }
+    }
+
+    /**
+     * @brief Hand an item to the first stage, blocking while it is full.
+     * @return false once the pipeline is closed; `item` is left untouched
+     */
+    bool push(T& item) {
+        if (stages_.empty()) return false;
+        in_flight_.fetch_add(1);
+        if (stages_.front()->input->push(item)) return true;
+        in_flight_.fetch_sub(1);
+        return false;
+    }
+
+    /**
+     * @brief Stop accepting items. Queued items still run through every stage.
+     */
+    void close() {
+        if (!stages_.empty()) stages_.front()->input->close();
+    }
+
+    /**
+     * @brief Wait for every worker to exit. Returns once close() has been
+     * called and every item has left the pipeline.
+     */
+    void join() {
+        for (auto& thread : threads_) {
+            if (thread.joinable()) thread.join();
+        }
+        threads_.clear();
+    }
+
+    size_t in_flight() const { return in_flight_.load(); }
+
+    size_t worker_count() const {
+        size_t total = 0;
+        for (const auto& stage : stages_) total += stage->workers;
+        return total;
+    }
+
+    std::vector<StageStats> stats() const {
+        double uptime = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+        std::vector<StageStats> result;
+        for (const auto& stage : stages_) {
+            StageStats s;
+            s.name = stage->name;
+            s.workers = stage->workers;
+            s.active = stage->active.load();
+            s.queued = stage->input->size();
+            s.capacity = stage->input->capacity();
+            s.processed = stage->processed.load();
+            s.dropped = stage->dropped.load();
+            s.busy_seconds = stage->busy_ns.load() / 1e9;
+            s.blocked_seconds = stage->blocked_ns.load() / 1e9;
+            s.utilization = uptime > 0.0 ? std::min(1.0, s.busy_seconds / (s.workers * uptime)) : 0.0;
+            result.push_back(std::move(s));
+        }
+        return result;
+    }
+
+private:
+    struct Stage {
+        std::string name;
+        size_t workers = 1;
+        size_t max_batch = 1;
+        BatchStep step;
+        std::unique_ptr<Channel<T>> input;
+        std::atomic<size_t> running{0};
+        std::atomic<size_t> active{0};
+        std::atomic<uint64_t> processed{0};
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<uint64_t> busy_ns{0};
+        std::atomic<uint64_t> blocked_ns{0};
+    };
+
+    static uint64_t elapsed_ns(std::chrono::steady_clock::time_point since) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - since).count());
+    }
+
+    void worker(size_t index) {
+        Stage& stage = *stages_[index];
+        Channel<T>* next = index + 1 < stages_.size() ? stages_[index + 1]->input.get() : nullptr;
+
+        std::vector<T> items;
+        while (stage.input->pop(items, stage.max_batch)) {
+            size_t taken = items.size();
+            stage.active.fetch_add(1);
+            auto start = std::chrono::steady_clock::now();
+            try {
+                stage.step(items);
+            } catch (...) {
+                items.clear();  // A step that throws drops what it was given
+            }
+            stage.busy_ns.fetch_add(elapsed_ns(start));
+            stage.active.fetch_sub(1);
+            stage.processed.fetch_add(taken);
+            stage.dropped.fetch_add(taken - items.size());
+
+            size_t finished = taken - items.size();
+            if (next) {
+                auto blocked = std::chrono::steady_clock::now();
+                for (auto& item : items) {
+                    if (!next->push(item)) ++finished;
+                }
+                stage.blocked_ns.fetch_add(elapsed_ns(blocked));
+            } else {
+                finished = taken;
+            }
+            in_flight_.fetch_sub(finished);
+            items.clear();
+        }
+
+        // The last worker out closes the next stage, which then drains and exits the same way
+        if (stage.running.fetch_sub(1) == 1 && next) next->close();
+    }
+
+    std::vector<std::unique_ptr<Stage>> stages_;
+    std::vector<std::thread> threads_;
+    std::chrono::steady_clock::time_point started_ = std::chrono::steady_clock::now();
+    std::atomic<size_t> in_flight_{0};
+};
+
+} // namespace levelii
@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include <tuple>
 #include <memory>
+#include <array>
+#include <cmath>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
@@ -25,6 +27,30 @@ QuantizationParams get_quant_params(const std::string& product_type);
 uint8_t quantize_value(float value, float min_val, float max_val);
 uint16_t quantize_azimuth(float azimuth_deg);
 
+/**
+ * Volume plan decoded from the Message 5 VCP definition. Available before the
+ * first radial, so per-sweep buffers are sized once; shared by every product
+ * parsed from the same volume.
+ */
+struct VolumePlan {
+    struct Cut {
+        float elevation_deg = 0.0f;
+        uint8_t waveform = 0;           // Message 5 waveform type (1 = CS, 2 = CD/W, 3 = CD/WO, 4 = batch)
+        uint8_t channel_config = 0;
+        uint8_t super_res = 0;          // nexrad::SuperResFlags bits
+        uint16_t expected_radials = 360; // 720 with half-degree azimuth super resolution
+        std::array<uint16_t, 7> gates{}; // Gates per moment type (1 = REF ... 6 = RHO) on the cut's first radial; 0 if absent
+    };
+
+    uint16_t vcp_number = 0;
+    std::vector<Cut> cuts;  // Indexed by Message 31 elevation number - 1
+
+    const Cut* cut(uint8_t elevation_num) const {
+        if (elevation_num == 0 || elevation_num > cuts.size()) return nullptr;
+        return &cuts[elevation_num - 1];
+    }
+};
+
 struct RadarFrame {
     std::string station;
     std::string timestamp;
@@ -66,6 +92,7 @@ struct RadarFrame {
     
     // Per-sweep metadata
     std::shared_ptr<std::unordered_map<int, int>> elevation_ray_counts;  // elevation_key -> number of rays
+    std::shared_ptr<const VolumePlan> volume_plan;  // Null when the volume carried no Message 5
     
     // Velocity dealiasing metadata
     std::unordered_map<int, float> nyquist_velocity;  // elevation_key -> Nyquist velocity (m/s)
@@ -96,9 +123,18 @@ struct RadarFrame {
         std::vector<float>().swap(volumetric_3d);
         std::vector<float>().swap(available_tilts);
         elevation_ray_counts.reset();
+        volume_plan.reset();
         nyquist_velocity.clear();
         has_volumetric_data = false;
     }
     
+    /**
+     * @brief Radials per revolution the VCP schedules for a sweep, or 0 without a plan.
+     */
+    int planned_radials(const Sweep& sweep) const {
+        const VolumePlan::Cut* cut = volume_plan ? volume_plan->cut(sweep.elevation_num) : nullptr;
+        return cut ? cut->expected_radials : 0;
+    }
+
     std::string encode_volumetric_3d_binary() const;
 };
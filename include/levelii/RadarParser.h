@@ -6,6 +6,37 @@
 #include <unordered_map>
 #include "levelii/RadarFrame.h"
 
+/**
+ * @brief How gate_stride folds a group of consecutive gates into one bin.
+ */
+enum class GateReduction {
+    Sample,  // First gate of the group, the others are never read
+    Max,     // Largest value in the group
+    Mean     // Mean of the group's valid gates, re-quantized
+};
+
+/**
+ * @brief Tuning knobs for a single parse.
+ */
+struct ParseOptions {
+    // Threads used to decompress and decode one volume. Single-stream bzip2 input is
+    // split at block boundaries; after the serial header walk, sweep/product pairs are
+    // decoded concurrently and stitched in order. The output is identical for any
+    // value. 1 works on the calling thread only.
+    int decode_threads = 1;
+
+    // Range window in meters. Gates outside it are skipped without being read;
+    // 0 leaves that side unbounded.
+    float min_range_meters = 0.0f;
+    float max_range_meters = 0.0f;
+
+    // Every group of gate_stride gates becomes one bin placed at the group's first
+    // gate; the frame's ngates, first_gate_meters and gate_spacing_meters describe
+    // the windowed, strided grid.
+    int gate_stride = DOWNSAMPLE_GATES;
+    GateReduction reduction = GateReduction::Max;
+};
+
 /**
  * @brief Parses raw NEXRAD Level II data into a structured RadarFrame.
  * 
@@ -39,6 +70,7 @@ std::unique_ptr<RadarFrame> parse_nexrad_level2(
  * @param product_types List of products to extract (e.g., {"reflectivity", "velocity"}).
  * @param decompressed_buffer Optional pre-allocated buffer for decompression to reduce allocations.
  * @param generate_3d Whether to generate 3D volumetric data for each frame (default: true).
+ * @param options Parse tuning, e.g. intra-volume decode threads.
  * @return std::unordered_map<std::string, std::unique_ptr<RadarFrame>> Map from product name to its frame.
  */
 std::unordered_map<std::string, std::unique_ptr<RadarFrame>> parse_nexrad_level2_multi(
@@ -47,5 +79,6 @@ std::unordered_map<std::string, std::unique_ptr<RadarFrame>> parse_nexrad_level2
     const std::string& timestamp,
     const std::vector<std::string>& product_types,
     std::vector<uint8_t>* decompressed_buffer = nullptr,
-    bool generate_3d = true
+    bool generate_3d = true,
+    const ParseOptions& options = {}
 );
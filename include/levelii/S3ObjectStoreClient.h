@@ -0,0 +1,56 @@
+/**
+ * S3ObjectStoreClient.h - ObjectStoreClient backed by the AWS S3 SDK
+ *
+ * Works against AWS S3 or any S3-compatible endpoint (MinIO, Ceph RGW, ...).
+ * Credentials come from the default AWS provider chain (AWS_ACCESS_KEY_ID /
+ * AWS_SECRET_ACCESS_KEY, profile, instance metadata).
+ *
+ * Requires AWSInitializer::instance().initialize() to have been called.
+ */
+
+#pragma once
+
+#include "levelii/ObjectSink.h"
+#include <memory>
+#include <string>
+
+namespace Aws { namespace S3 { class S3Client; } }
+
+class S3ObjectStoreClient : public ObjectStoreClient {
+public:
+    /**
+     * @param bucket Destination bucket.
+     * @param endpoint_url Optional endpoint such as "http://localhost:9000"; empty uses AWS.
+     *                     Custom endpoints use path-style addressing.
+     * @param region Signing region.
+     */
+    S3ObjectStoreClient(const std::string& bucket, const std::string& endpoint_url = "", const std::string& region = "us-east-1");
+    ~S3ObjectStoreClient() override;
+
+    bool put_object(const std::string& key, const uint8_t* data, size_t size, std::string& error) override;
+
+    bool create_multipart_upload(const std::string& key, std::string& upload_id, std::string& error) override;
+
+    bool upload_part(
+        const std::string& key,
+        const std::string& upload_id,
+        int part_number,
+        const uint8_t* data,
+        size_t size,
+        std::string& etag,
+        std::string& error
+    ) override;
+
+    bool complete_multipart_upload(
+        const std::string& key,
+        const std::string& upload_id,
+        const std::vector<std::string>& etags,
+        std::string& error
+    ) override;
+
+    void abort_multipart_upload(const std::string& key, const std::string& upload_id) override;
+
+private:
+    std::string bucket_;
+    std::shared_ptr<Aws::S3::S3Client> client_;
+};
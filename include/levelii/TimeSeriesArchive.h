@@ -0,0 +1,112 @@
+/**
+ * TimeSeriesArchive.h - Time-chunked, tiled secondary archive for per-location queries
+ *
+ * Re-chunks every stored tilt by time and space so that time-series reads only
+ * touch the tiles covering the requested location:
+ * /levelii/_timeseries/STATION/product/tilt/YYYYMMDD_HH_RAYSxGATES/rRR_gGG.TSC
+ *
+ * Each .TSC tile file is append-only and holds one record per frame:
+ * ["TSR1"][uint32 LE compressed size][16-byte NUL-padded timestamp][gzip(dense uint8 tile)]
+ * Tiles with no echo are not written. Every appended frame is recorded in the
+ * levelii_timeseries table of index.db, so frames missing from a tile read as "no data".
+ *
+ * A frame is recorded only once all of its tiles are appended. A failed append
+ * truncates the tiles it touched back to where they were, and a tail torn by a
+ * crash is cut off before the next append to that file, so records stay aligned.
+ *
+ * Tiles are expanded and compressed without locks; only appends to the same
+ * chunk directory are serialized.
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+#include "levelii/DatabaseUtils.h"
+
+constexpr uint16_t TS_TILE_RAYS = 64;
+constexpr uint16_t TS_TILE_GATES = 128;
+
+class TimeSeriesArchive {
+public:
+    /**
+     * @brief Point or area query over a single (station, product, tilt).
+     *
+     * A point query sets azimuth_min == azimuth_max and range_min_m == range_max_m.
+     * Areas may wrap through north (azimuth_min > azimuth_max).
+     * Timestamps are inclusive and use the YYYYMMDD_HHMMSS format.
+     */
+    struct Query {
+        std::string station;
+        std::string product;
+        float tilt = 0.0f;
+        std::string start;
+        std::string end;
+        float azimuth_min = 0.0f;
+        float azimuth_max = 0.0f;
+        float range_min_m = 0.0f;
+        float range_max_m = 0.0f;
+    };
+
+    /**
+     * @brief Aggregate of the quantized values inside the query window for one frame.
+     *
+     * Values are the raw 8-bit quantized levels written to .RDA files; count == 0
+     * means no echo inside the window for that frame.
+     */
+    struct Sample {
+        std::string timestamp;
+        uint32_t count = 0;
+        uint8_t min = 0;
+        uint8_t max = 0;
+        float mean = 0.0f;
+    };
+
+    TimeSeriesArchive(const std::string& root_path, levelii::SQLiteDatabase& db);
+
+    /**
+     * @brief Append one bitmask-encoded tilt to the archive.
+     *
+     * Frames already present in the index are skipped, so re-saving a tilt is harmless.
+     */
+    bool append_frame(
+        const std::string& station,
+        const std::string& product,
+        const std::string& timestamp,
+        float tilt,
+        uint16_t num_rays,
+        uint16_t num_gates,
+        float gate_spacing,
+        float first_gate,
+        const std::vector<uint8_t>& bitmask,
+        const std::vector<uint8_t>& values
+    );
+
+    std::vector<Sample> query(const Query& q) const;
+
+    /**
+     * @brief Drop all chunks whose hour starts before the given timestamp.
+     */
+    void prune_before(const std::string& timestamp);
+
+    const std::string& root_path() const { return root_path_; }
+
+private:
+    std::string root_path_;
+    levelii::SQLiteDatabase& db_;
+    std::array<std::mutex, 32> chunk_mutexes_;   // Appends to one chunk, by hash of its directory
+    std::shared_mutex prune_mutex_;              // Shared by appends, exclusive while pruning
+
+    std::mutex& chunk_mutex(const std::string& dir);
+
+    std::string chunk_dir(
+        const std::string& station,
+        const std::string& product,
+        float tilt,
+        const std::string& chunk
+    ) const;
+};
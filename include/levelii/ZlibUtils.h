@@ -1,11 +1,87 @@
 #pragma once
 
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
 namespace ZlibUtils {
 
-std::vector<uint8_t> gzip_compress(const uint8_t* data, size_t data_size);
+/**
+ * Whole-buffer gzip. The output is sized up front (deflateBound when
+ * compressing, the ISIZE trailer when inflating) and written in one pass, so
+ * nothing is staged through scratch chunks. Built against libdeflate when it
+ * is available, zlib otherwise; the files are plain gzip either way.
+ * Concatenated gzip members are inflated back to back.
+ */
+std::vector<uint8_t> gzip_compress(const uint8_t* data, size_t data_size, int level = 9);
 std::vector<uint8_t> gzip_decompress(const uint8_t* data, size_t data_size);
 
+/**
+ * Inflate into `out`, reusing its capacity. Returns false and leaves `out`
+ * empty on corrupt or truncated input.
+ */
+bool gzip_decompress(const uint8_t* data, size_t data_size, std::vector<uint8_t>& out);
+
+/**
+ * Inflate into a fixed buffer, e.g. one slice of a buffer shared by several
+ * files. Returns false if the data is corrupt, truncated or does not fit.
+ */
+bool gzip_decompress_into(const uint8_t* data, size_t data_size, uint8_t* out, size_t capacity, size_t& produced);
+
+/**
+ * Inflate only the first gzip member. `consumed` receives its compressed
+ * length, i.e. where the next member starts. `data` may end anywhere after
+ * the member; returns false if the member is not complete.
+ */
+bool gzip_decompress_member(const uint8_t* data, size_t data_size, std::vector<uint8_t>& out, size_t& consumed);
+
+/**
+ * Inflated size of the file: the size subfield written by
+ * gzip_compress_members_with_crc, else the gzip trailer. 0 when neither is
+ * present or plausible. Exact for files written by this module.
+ */
+size_t gzip_inflated_size(const uint8_t* data, size_t data_size);
+
+/**
+ * Gzip with a CRC32C of everything after the header stored in an FEXTRA
+ * subfield ('R','C', 4 bytes LE). Standard gzip readers ignore the field.
+ */
+std::vector<uint8_t> gzip_compress_with_crc(const uint8_t* data, size_t data_size, int level = 9);
+
+/**
+ * Gzip `data` as the first member of a multi-member file and append
+ * `members`, each a complete gzip member from gzip_compress (empty ones are
+ * skipped). Any member can later be inflated on its own. The first header
+ * carries the CRC32C of everything after it and an 'R','S' subfield with the
+ * inflated size of the whole file.
+ */
+std::vector<uint8_t> gzip_compress_members_with_crc(const uint8_t* data, size_t data_size,
+                                                    const std::vector<std::vector<uint8_t>>& members, int level = 9);
+
+enum class GzipCrcStatus {
+    Valid,
+    Missing,   // No embedded checksum (written before checksums existed) or not a gzip stream
+    Mismatch
+};
+
+/**
+ * Verify the embedded CRC32C without inflating. Only the header needs to be
+ * present to read the stored value, so `stored_crc` may be requested from a
+ * short prefix by passing verify = false.
+ */
+GzipCrcStatus verify_gzip_crc(const uint8_t* data, size_t data_size, uint32_t* stored_crc = nullptr, bool verify = true);
+
+/**
+ * Highest `level` the compressors accept: 9 with zlib, 12 with libdeflate,
+ * whose levels above 9 are slower and denser.
+ */
+int max_level();
+
+/**
+ * Codec contexts (z_streams or libdeflate compressors) created since startup.
+ * They are pooled and reused, so this only grows with the number of
+ * concurrent callers.
+ */
+uint64_t stream_inits();
+
 } // namespace ZlibUtils
@@ -39,4 +39,6 @@ private:
     json handle_post_config(const std::string& body);
     json handle_post_pause();
     json handle_post_resume();
+    json handle_post_timeseries(const std::string& body);
+    json handle_post_frame(const std::string& body);
 };
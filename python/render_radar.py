@@ -49,23 +49,14 @@ def decode_bitmask_format(binary_data, ray_count, gate_count, product_type):
     bitmask = np.frombuffer(binary_data[:bitmask_bytes_count], dtype=np.uint8)
     packed_values = np.frombuffer(binary_data[bitmask_bytes_count:], dtype=np.uint8)
     
-    # Reconstruct the grid
-    grid = np.zeros((ray_count, gate_count), dtype=np.float32)
-    
-    value_idx = 0
-    for r in range(ray_count):
-        for g in range(gate_count):
-            bit_idx = r * gate_count + g
-            byte_idx = bit_idx // 8
-            bit_pos = 7 - (bit_idx % 8)
-            
-            if (bitmask[byte_idx] >> bit_pos) & 1:
-                if value_idx < len(packed_values):
-                    val_quant = float(packed_values[value_idx])
-                    # Dequantize
-                    grid[r, g] = min_val + (val_quant / 255.0) * (max_val - min_val)
-                    value_idx += 1
-                    
+    # Expand the bitmask and scatter the values through a 256-entry table
+    present = np.flatnonzero(np.unpackbits(bitmask, count=total_bits))
+    present = present[:len(packed_values)]
+    lut = (min_val + (np.arange(256, dtype=np.float32) / 255.0) * (max_val - min_val)).astype(np.float32)
+    grid = np.zeros(total_bits, dtype=np.float32)
+    grid[present] = lut[packed_values[:len(present)]]
+    grid = grid.reshape(ray_count, gate_count)
+
     return grid
 
 def main():
@@ -9,6 +9,8 @@
 #include "levelii/RadarFrame.h"
 #include "levelii/RadarParser.h"
 #include "levelii/ThreadPool.h"
+#include "levelii/BulkDiscovery.h"
+#include "levelii/ParallelFor.h"
 #include <iostream>
 #include <chrono>
 #include <algorithm>
@@ -16,9 +18,13 @@
 #include <cstring>
 #include <fstream>
 #include <cstdlib>
+#include <cmath>
+#include <ctime>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/ListObjectsV2Request.h>
 #include <aws/s3/model/GetObjectRequest.h>
+#include <aws/s3/S3Errors.h>
+#include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/DateTime.h>
 
 namespace {
@@ -43,6 +49,123 @@ namespace {
         std::set<std::string>& active_scans_;
         std::mutex& mutex_;
     };
+
+    DurableWorkQueue::Item to_work_item(const DiscoveryItem& item) {
+        return {item.station, item.key, item.bucket, item.timestamp};
+    }
+
+    GateReduction to_gate_reduction(const std::string& name) {
+        if (name == "mean") return GateReduction::Mean;
+        if (name == "sample") return GateReduction::Sample;
+        return GateReduction::Max;
+    }
+
+    ParseOptions to_parse_options(const FrameFetcherConfig& config, int parsing) {
+        ParseOptions options;
+        options.decode_threads = std::max(1, config.parse_threads / std::max(parsing, 1));
+        options.min_range_meters = config.decode_min_range_meters;
+        options.max_range_meters = config.decode_max_range_meters;
+        options.gate_stride = config.decode_gate_stride;
+        options.reduction = to_gate_reduction(config.decode_gate_reduction);
+        return options;
+    }
+
+    /**
+     * Tilts of a partly fetched volume that are finished. Archive II is in scan
+     * order, so everything but the elevation of the last sweep, which the end
+     * of the range may have cut off, is complete.
+     */
+    std::set<float> finished_tilts(const RadarFrame& frame, bool& has_data) {
+        std::set<float> tilts;
+        has_data = false;
+        if (frame.sweeps.empty()) return tilts;
+        const float last = frame.sweeps.back().elevation_deg;
+        for (const auto& sweep : frame.sweeps) {
+            if (std::abs(sweep.elevation_deg - last) < 0.01f) continue;
+            tilts.insert(sweep.elevation_deg);
+            has_data = has_data || !sweep.bins.empty();
+        }
+        return tilts;
+    }
+
+    // Total size from a "bytes 0-1048575/16086099" Content-Range, 0 if absent
+    size_t content_range_total(const std::string& content_range) {
+        size_t slash = content_range.rfind('/');
+        if (slash == std::string::npos || slash + 1 >= content_range.size() || content_range[slash + 1] == '*') return 0;
+        return static_cast<size_t>(std::strtoull(content_range.c_str() + slash + 1, nullptr, 10));
+    }
+
+    struct StageWorkers {
+        size_t download, decode, store;
+    };
+
+    // Downloads wait on the network, so they get the full thread count; decode and store share the cores
+    StageWorkers stage_workers(const FrameFetcherConfig& config) {
+        int threads = std::max(1, config.fetcher_thread_pool_size);
+        auto or_default = [](int configured, int fallback) { return static_cast<size_t>(configured > 0 ? configured : std::max(1, fallback)); };
+        return {or_default(config.download_workers, threads), or_default(config.decode_workers, threads / 2),
+                or_default(config.store_workers, threads / 2)};
+    }
+
+    // CPU time of the calling thread, not wall time: waiting on S3 or a full queue costs nothing
+    uint64_t thread_cpu_ns() {
+        timespec ts{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    DegradationController::Config to_degradation_config(const FrameFetcherConfig& config) {
+        DegradationController::Config shed;
+        shed.enabled = config.shed_enabled;
+        shed.degrade_wait_seconds = config.shed_degrade_wait_seconds;
+        shed.restore_wait_seconds = config.shed_restore_wait_seconds;
+        shed.degrade_backlog = static_cast<size_t>(std::max(config.shed_degrade_backlog, 1));
+        shed.restore_backlog = static_cast<size_t>(std::max(config.shed_restore_backlog, 0));
+        shed.hold_seconds = config.shed_hold_seconds;
+        return shed;
+    }
+
+    // Keep the `count` lowest tilts of a frame and free the sweeps above them; returns the tilts dropped
+    size_t keep_lowest_tilts(RadarFrame& frame, size_t count) {
+        if (count == 0 || frame.available_tilts.size() <= count) return 0;
+        std::vector<float> tilts = frame.available_tilts;
+        std::sort(tilts.begin(), tilts.end());
+        tilts.resize(count);
+        size_t dropped = frame.available_tilts.size() - count;
+        const float highest = tilts.back();
+        frame.available_tilts = std::move(tilts);
+        for (auto& sweep : frame.sweeps) {
+            if (sweep.elevation_deg > highest + 0.01f) std::vector<float>().swap(sweep.bins);
+        }
+        return dropped;
+    }
+
+    json cost_to_json(const StationCost& cost) {
+        return {
+            {"cpu_seconds", cost.cpu_ns() / 1e9},
+            {"download_cpu_seconds", cost.download_cpu_ns / 1e9},
+            {"decode_cpu_seconds", cost.decode_cpu_ns / 1e9},
+            {"store_cpu_seconds", cost.store_cpu_ns / 1e9},
+            {"index_cpu_seconds", cost.index_cpu_ns / 1e9},
+            {"bytes_downloaded", cost.bytes_downloaded},
+            {"bytes_decompressed", cost.bytes_decompressed},
+            {"bytes_stored", cost.bytes_stored},
+            {"peak_scratch_bytes", cost.peak_scratch_bytes},
+            {"volumes", cost.volumes}
+        };
+    }
+}
+
+void StationCost::add(const StationCost& other) {
+    download_cpu_ns += other.download_cpu_ns;
+    decode_cpu_ns += other.decode_cpu_ns;
+    store_cpu_ns += other.store_cpu_ns;
+    index_cpu_ns += other.index_cpu_ns;
+    bytes_downloaded += other.bytes_downloaded;
+    bytes_decompressed += other.bytes_decompressed;
+    bytes_stored += other.bytes_stored;
+    peak_scratch_bytes = std::max(peak_scratch_bytes, other.peak_scratch_bytes);
+    volumes += other.volumes;
 }
 
 void BackgroundFrameFetcher::log_info(const std::string& msg) const {
@@ -147,6 +270,8 @@ BackgroundFrameFetcher::BackgroundFrameFetcher(
     : storage_(storage), config_(config), data_path_(data_path) {
     load_config_from_disk();
     load_state_from_disk();
+    discovery_queue_.set_weights(config_.station_weights);
+    degradation_.set_config(to_degradation_config(config_));
     reinitialize_pools();
 }
 
@@ -160,17 +285,42 @@ void BackgroundFrameFetcher::start() {
     
     should_stop_.store(false);
     is_running_.store(true);
+    if (cancel_.cancelled()) {
+        // Tokens stay cancelled once stop() cancels them; a restart runs under new ones
+        cancel_ = CancellationToken();
+        pool_cancel_ = cancel_.child();
+    }
+
+    resume_outstanding_work();
     
     discovery_loop_thread_ = std::thread([this]() { this->discovery_loop(); });
     fetch_thread_ = std::thread([this]() { this->fetch_loop(); });
     cleanup_thread_ = std::thread([this]() { this->cleanup_loop(); });
+
+    if (config_.scrub_enabled) {
+        FrameStorageManager::ScrubberConfig scrub_config;
+        scrub_config.bytes_per_second = config_.scrub_bytes_per_second;
+        scrub_config.pass_interval_seconds = config_.scrub_pass_interval_seconds;
+        storage_->start_scrubber(scrub_config, [this](const std::string& station, const std::string&, const std::string& timestamp, const std::string&) {
+            requeue_volume(station, timestamp);
+        });
+    }
 }
 
 void BackgroundFrameFetcher::stop() {
     if (!is_running_.load()) return;
+
+    // The scrubber pushes into the discovery queue, stop it before the consumers
+    storage_->stop_scrubber();
     
     should_stop_.store(true);
     is_running_.store(false);
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        cancel_.cancel();
+        // A fetch loop blocked handing work to the pipeline gives up at once
+        if (fetch_pipeline_) fetch_pipeline_->close();
+    }
     
     {
         std::lock_guard<std::mutex> lock(discovery_mutex_);
@@ -191,19 +341,38 @@ void BackgroundFrameFetcher::stop() {
     }
     
     std::shared_ptr<ThreadPool> disc_pool;
-    std::shared_ptr<ThreadPool> fetch_pool;
+    std::shared_ptr<FetchPipeline> pipeline;
     std::shared_ptr<BufferPool> buf_pool;
 
     {
         std::lock_guard<std::mutex> lock(state_mutex_);
         disc_pool = std::move(discovery_thread_pool_);
-        fetch_pool = std::move(fetch_thread_pool_);
+        pipeline = std::move(fetch_pipeline_);
         buf_pool = std::move(buffer_pool_);
     }
 
     if (disc_pool) disc_pool->shutdown();
-    if (fetch_pool) fetch_pool->shutdown();
+    // Wake stage workers waiting for a buffer before waiting for them
     if (buf_pool) buf_pool->shutdown();
+    if (pipeline) pipeline->join();
+}
+
+void BackgroundFrameFetcher::resume_outstanding_work() {
+    // Every recovered object is fetched again. A product having rows in the index says
+    // nothing about which of its tilts were stored, and rewriting a frame is harmless.
+    auto outstanding = storage_->work_queue().recover();
+
+    // Everything left in the in-memory queue is also in the durable one, rebuild from that
+    std::vector<DiscoveryItem> items;
+    for (const auto& work : outstanding) {
+        items.push_back({work.station, work.key, work.bucket, work.timestamp});
+    }
+    std::lock_guard<std::mutex> lock(discovery_mutex_);
+    discovery_queue_.clear();
+    discovery_queue_.push(std::move(items));
+    if (!outstanding.empty()) {
+        this->log_info("Resuming " + std::to_string(outstanding.size()) + " outstanding objects from the work queue");
+    }
 }
 
 void BackgroundFrameFetcher::add_monitored_station(const std::string& station) {
@@ -250,11 +419,20 @@ void BackgroundFrameFetcher::reconfigure(const FrameFetcherConfig& new_config) {
         if (new_config.fetcher_thread_pool_size != config_.fetcher_thread_pool_size ||
             new_config.discovery_parallelism != config_.discovery_parallelism ||
             new_config.buffer_pool_size != config_.buffer_pool_size ||
-            new_config.buffer_size != config_.buffer_size) {
+            new_config.buffer_size != config_.buffer_size ||
+            new_config.download_workers != config_.download_workers ||
+            new_config.decode_workers != config_.decode_workers ||
+            new_config.store_workers != config_.store_workers ||
+            new_config.pipeline_queue_size != config_.pipeline_queue_size) {
             pools_changed = true;
         }
         config_ = new_config;
     }
+    {
+        std::lock_guard<std::mutex> lock(discovery_mutex_);
+        discovery_queue_.set_weights(new_config.station_weights);
+    }
+    degradation_.set_config(to_degradation_config(new_config));
 
     save_config_to_disk();
 
@@ -270,10 +448,11 @@ FrameFetcherConfig BackgroundFrameFetcher::get_config() const {
 }
 
 void BackgroundFrameFetcher::reinitialize_pools() {
-    int fetch_threads, disc_threads, buffer_pool_size, buffer_size, max_queue_size;
+    FrameFetcherConfig config;
+    int disc_threads, buffer_pool_size, buffer_size, max_queue_size;
     {
         std::lock_guard<std::mutex> lock(state_mutex_);
-        fetch_threads = config_.fetcher_thread_pool_size;
+        config = config_;
         disc_threads = config_.discovery_parallelism;
         buffer_pool_size = config_.buffer_pool_size;
         buffer_size = config_.buffer_size;
@@ -288,7 +467,11 @@ void BackgroundFrameFetcher::reinitialize_pools() {
         } catch (...) {}
     }
 
-    int required_buffers = fetch_threads * 4;
+    // Peak buffers held by the pipeline: raw and decompressed per download (base scan) and decode,
+    // a raw one per object queued for decode, and four grids per store worker
+    StageWorkers workers = stage_workers(config);
+    int required_buffers = static_cast<int>(2 * workers.download + std::max(config.pipeline_queue_size, 1) + 2 * workers.decode +
+                                            4 * workers.store);
     int actual_buffer_pool_size = std::max(buffer_pool_size, required_buffers);
 
     if (actual_buffer_pool_size > buffer_pool_size) {
@@ -296,81 +479,53 @@ void BackgroundFrameFetcher::reinitialize_pools() {
                  " to " + std::to_string(actual_buffer_pool_size) + " to maintain adequate thread ratio");
     }
 
-    auto new_fetch_pool = std::make_shared<ThreadPool>(fetch_threads, max_queue_size);
+    auto new_pipeline = make_fetch_pipeline(config);
     auto new_disc_pool = std::make_shared<ThreadPool>(disc_threads, max_queue_size);
     auto new_buffer_pool = std::make_shared<BufferPool>(actual_buffer_pool_size, buffer_size);
     new_buffer_pool->set_logging_enabled(logging_enabled_.load());
 
-    std::shared_ptr<ThreadPool> old_fetch_pool;
+    std::shared_ptr<FetchPipeline> old_pipeline;
     std::shared_ptr<ThreadPool> old_disc_pool;
     std::shared_ptr<BufferPool> old_buffer_pool;
     
     {
         std::lock_guard<std::mutex> lock(state_mutex_);
-        old_fetch_pool = std::move(fetch_thread_pool_);
+        old_pipeline = std::move(fetch_pipeline_);
         old_disc_pool = std::move(discovery_thread_pool_);
         old_buffer_pool = std::move(buffer_pool_);
         
-        fetch_thread_pool_ = new_fetch_pool;
+        fetch_pipeline_ = new_pipeline;
         discovery_thread_pool_ = new_disc_pool;
         buffer_pool_ = new_buffer_pool;
+        pool_cancel_ = cancel_.child();
         
-        this->log_info("Initialized pools: " + std::to_string(fetch_threads) + 
-                 " fetch threads, " + std::to_string(disc_threads) + " discovery threads, " +
-                 std::to_string(actual_buffer_pool_size) + " buffers");
+        this->log_info("Initialized pools: " + std::to_string(workers.download) + " download, " + std::to_string(workers.decode) +
+                 " decode and " + std::to_string(workers.store) + " store workers, " + std::to_string(disc_threads) +
+                 " discovery threads, " + std::to_string(actual_buffer_pool_size) + " buffers");
     }
 
-    if (old_fetch_pool) old_fetch_pool->shutdown();
+    // Objects already in the old pipeline run to completion: a cancelled one would stay
+    // outstanding in the work queue, where discovery never re-queues it. stop() still
+    // cancels them through the parent token. The fetch loop puts back whatever the closed
+    // pipeline refuses.
+    if (old_pipeline) old_pipeline->close();
     if (old_disc_pool) old_disc_pool->shutdown();
+    if (old_pipeline) old_pipeline->join();
     if (old_buffer_pool) old_buffer_pool->shutdown();
 }
 
 void BackgroundFrameFetcher::discovery_loop() {
     this->log_info("High-efficiency S3 discovery loop started");
 
+    bool first_cycle = true;
     while (!should_stop_.load()) {
         auto stations = get_monitored_stations();
         
-        // Handle "ALL" stations mode
+        // "ALL" stations mode: bulk listings of the day prefixes instead of a scan per station
         if (stations.count("ALL")) {
-            auto s3_client = AWSInitializer::instance().get_s3_client();
-            if (s3_client) {
-                auto now = std::chrono::system_clock::now();
-                std::time_t t_now = std::chrono::system_clock::to_time_t(now);
-                std::time_t t_yesterday = t_now - (24 * 60 * 60);
-                
-                std::tm utc_tm, yest_tm;
-                gmtime_r(&t_now, &utc_tm);
-                gmtime_r(&t_yesterday, &yest_tm);
-
-                std::vector<std::string> prefixes;
-                char buf[32];
-                std::snprintf(buf, sizeof(buf), "%04d/%02d/%02d/",
-                              yest_tm.tm_year + 1900, yest_tm.tm_mon + 1, yest_tm.tm_mday);
-                prefixes.push_back(buf);
-                std::snprintf(buf, sizeof(buf), "%04d/%02d/%02d/",
-                              utc_tm.tm_year + 1900, utc_tm.tm_mon + 1, utc_tm.tm_mday);
-                prefixes.push_back(buf);
-
-                for (const auto& day_prefix : prefixes) {
-                    Aws::S3::Model::ListObjectsV2Request list_req;
-                    list_req.WithBucket(NEXRAD_BUCKET).WithPrefix(day_prefix).WithDelimiter("/");
-
-                    auto list_outcome = s3_client->ListObjectsV2(list_req);
-                    if (list_outcome.IsSuccess()) {
-                        for (const auto& prefix : list_outcome.GetResult().GetCommonPrefixes()) {
-                            std::string p = prefix.GetPrefix();
-                            // Prefix is "YYYY/MM/DD/STATION/"
-                            size_t last_slash = p.find_last_of('/', p.size() - 2);
-                            if (last_slash != std::string::npos) {
-                                std::string station = p.substr(last_slash + 1, p.size() - last_slash - 2);
-                                stations.insert(station);
-                            }
-                        }
-                    }
-                }
-                stations.erase("ALL"); // Don't try to scan "ALL" as a station
-            }
+            discover_all_stations(first_cycle);
+            first_cycle = false;
+            stations.clear();
         }
         
         if (!stations.empty()) {
@@ -418,45 +573,128 @@ void BackgroundFrameFetcher::discovery_loop() {
 void BackgroundFrameFetcher::fetch_loop() {
     this->log_info("Fetch loop started");
     while (!should_stop_.load()) {
+        std::shared_ptr<FetchPipeline> pipeline;
+        std::shared_ptr<BufferPool> buffer_pool;
+        CancellationToken cancel;
+        std::shared_ptr<const FrameFetcherConfig> config;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            pipeline = fetch_pipeline_;
+            buffer_pool = buffer_pool_;
+            cancel = pool_cancel_;
+            config = std::make_shared<const FrameFetcherConfig>(config_);
+        }
+        if (!pipeline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            continue;
+        }
+
         DiscoveryBatch batch;
+        size_t backlog = 0;
+        std::string newest;
         {
             std::unique_lock<std::mutex> lock(discovery_mutex_);
-            discovery_cv_.wait_for(lock, std::chrono::seconds(1), [this] { 
-                return !discovery_queue_.empty() || should_stop_.load(); 
+            discovery_cv_.wait_for(lock, std::chrono::seconds(1), [this] {
+                return !discovery_queue_.empty() || should_stop_.load();
             });
 
             if (should_stop_.load()) break;
-            if (discovery_queue_.empty()) continue;
-
-            batch = std::move(discovery_queue_.front());
-            discovery_queue_.pop();
-            discovery_full_cv_.notify_one();
+            if (discovery_queue_.pop(batch)) {
+                newest = discovery_queue_.newest(batch.station);
+                discovery_full_cv_.notify_all();
+            }
+            backlog = discovery_queue_.size() + batch.items.size() + pipeline->in_flight();
         }
 
-        std::shared_ptr<ThreadPool> pool;
-        std::shared_ptr<BufferPool> buffer_pool;
-        FrameFetcherConfig config;
-        {
-            std::lock_guard<std::mutex> lock(state_mutex_);
-            pool = fetch_thread_pool_;
-            buffer_pool = buffer_pool_;
-            config = config_;
+        // An idle second counts too, so the level can recover once the queue drains
+        auto now = std::chrono::steady_clock::now();
+        double waited = 0.0;
+        for (const auto& item : batch.items) {
+            waited = std::max(waited, std::chrono::duration<double>(now - item.queued_at).count());
         }
+        auto level = degradation_.update(waited, backlog, now);
 
-        if (pool) {
-            pool->enqueue([this, batch = std::move(batch), config, buffer_pool]() {
-                std::string station = batch.station;
-                try {
-                    process_discovery_batch(batch, config, buffer_pool);
-                } catch (const std::exception& e) {
-                    this->log_error("Error processing batch for " + station + ": " + e.what());
-                    frames_failed_.fetch_add(1);
-                    
-                    std::lock_guard<std::mutex> lock(stats_mutex_);
-                    station_stats_[station].frames_failed++;
-                    station_stats_[station].last_fetch_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+        // Back at full with room to spare: shed volumes return to the queue a few at a time,
+        // so the backfill alone never takes the backlog over the restore mark
+        size_t room = static_cast<size_t>(std::max(config->shed_restore_backlog, 0));
+        if (level == DegradationController::Level::Full && backlog < room) {
+            std::vector<DiscoveryItem> refetch;
+            {
+                std::lock_guard<std::mutex> lock(backfill_mutex_);
+                size_t take = std::min(backfill_.size(), room - backlog);
+                refetch.assign(std::make_move_iterator(backfill_.end() - take), std::make_move_iterator(backfill_.end()));
+                backfill_.resize(backfill_.size() - take);
+            }
+            if (!refetch.empty()) {
+                degradation_.count_backfilled(refetch.size());
+                std::lock_guard<std::mutex> lock(discovery_mutex_);
+                discovery_queue_.push(std::move(refetch));
+            }
+        }
+        if (batch.items.empty()) continue;
+
+        // Shed work for this batch: each level keeps what the ones before it dropped
+        using Level = DegradationController::Level;
+        size_t max_tilts = 0;
+        size_t products_dropped = 0;
+        bool volumetric_dropped = level >= Level::NoVolumetric && (config->generate_3d || config->save_volumetric);
+        if (level >= Level::NoVolumetric) {
+            auto shed = std::make_shared<FrameFetcherConfig>(*config);
+            shed->generate_3d = false;
+            shed->save_volumetric = false;
+            if (level >= Level::BaseTilts) max_tilts = static_cast<size_t>(std::max(config->shed_max_tilts, 1));
+            if (level >= Level::PriorityProducts) {
+                std::vector<std::string> kept;
+                for (const auto& product : config->products) {
+                    if (std::find(config->shed_priority_products.begin(), config->shed_priority_products.end(), product) !=
+                        config->shed_priority_products.end()) {
+                        kept.push_back(product);
+                    }
                 }
-            });
+                if (!kept.empty()) {
+                    products_dropped = config->products.size() - kept.size();
+                    shed->products = std::move(kept);
+                }
+            }
+            config = std::move(shed);
+        }
+
+        // Blocks while the download stage is backed up. Everything else waits in
+        // the fair queue meanwhile, so the next batch popped is still the fairest one.
+        std::vector<DiscoveryItem> skipped;
+        std::vector<DiscoveryItem> unpushed;
+        for (size_t i = 0; i < batch.items.size(); ++i) {
+            auto& item = batch.items[i];
+            if (level >= Level::LatestOnly && item.timestamp < newest) {
+                skipped.push_back(std::move(item));
+                continue;
+            }
+            VolumeJob job;
+            job.item = std::move(item);
+            job.config = config;
+            job.buffer_pool = buffer_pool;
+            job.cancel = cancel;
+            job.max_tilts = max_tilts;
+            job.degraded = volumetric_dropped || products_dropped > 0;
+            if (!pipeline->push(job)) {
+                // Closed by a reconfigure or stop: the rest of the batch goes back to the queue
+                unpushed.push_back(std::move(job.item));
+                for (size_t j = i + 1; j < batch.items.size(); ++j) unpushed.push_back(std::move(batch.items[j]));
+                break;
+            }
+            if (volumetric_dropped) degradation_.count_volumetric_skipped();
+            if (products_dropped > 0) degradation_.count_products_dropped(products_dropped);
+        }
+        if (!unpushed.empty()) {
+            // Not bounded by max_discovery_queue_size: this thread is the one that drains it
+            std::lock_guard<std::mutex> lock(discovery_mutex_);
+            discovery_queue_.push(std::move(unpushed));
+        }
+        // A skipped volume stays in the work queue and is backfilled later
+        if (!skipped.empty()) {
+            degradation_.count_stale_skipped(skipped.size());
+            std::lock_guard<std::mutex> lock(backfill_mutex_);
+            for (auto& item : skipped) backfill_.push_back(std::move(item));
         }
     }
     this->log_info("Fetch loop stopped");
@@ -487,255 +725,679 @@ void BackgroundFrameFetcher::cleanup_loop() {
     this->log_info("Cleanup thread stopped");
 }
 
-void BackgroundFrameFetcher::process_discovery_batch(const DiscoveryBatch& batch, const FrameFetcherConfig& config, std::shared_ptr<BufferPool> buffer_pool) {
-    using namespace Aws::S3::Model;
+std::shared_ptr<BackgroundFrameFetcher::FetchPipeline> BackgroundFrameFetcher::make_fetch_pipeline(const FrameFetcherConfig& config) {
+    // Failures are counted where they happen; this only catches what a stage did not expect.
+    // Each step is charged to its station as it finishes, so dropped volumes are accounted for too.
+    auto guarded = [this](const char* stage, bool (BackgroundFrameFetcher::*step)(VolumeJob&), uint64_t StationCost::*cpu) {
+        return [this, stage, step, cpu](VolumeJob& job) {
+            uint64_t started = thread_cpu_ns();
+            bool kept = false;
+            bool failed = false;
+            try {
+                kept = (this->*step)(job);
+            } catch (const std::exception& e) {
+                this->log_error(std::string("Error in ") + stage + " stage for " + job.item.key + ": " + e.what());
+                failed = true;
+            } catch (...) {
+                this->log_error(std::string("Unknown error in ") + stage + " stage for " + job.item.key);
+                failed = true;
+            }
+            job.cost.*cpu += thread_cpu_ns() - started;
+            charge_station(job);
+            if (failed) record_failure(job);
+            return kept;
+        };
+    };
 
-    auto s3_client = AWSInitializer::instance().get_s3_client();
-    if (!s3_client || !buffer_pool) return;
+    StageWorkers workers = stage_workers(config);
+    size_t queue = static_cast<size_t>(std::max(config.pipeline_queue_size, 1));
+    auto pipeline = std::make_shared<FetchPipeline>();
+    pipeline->add_stage("download", workers.download, queue, guarded("download", &BackgroundFrameFetcher::download_volume, &StationCost::download_cpu_ns));
+    pipeline->add_stage("decode", workers.decode, queue, guarded("decode", &BackgroundFrameFetcher::decode_volume, &StationCost::decode_cpu_ns));
+    pipeline->add_stage("store", workers.store, queue, guarded("store", &BackgroundFrameFetcher::store_volume, &StationCost::store_cpu_ns));
+    // update_index() rescans a product directory, so it runs once for everything stored since the last pass
+    pipeline->add_batch_stage("index", 1, 64, 64, [this](std::vector<VolumeJob>& jobs) {
+        try {
+            index_volumes(jobs);
+        } catch (const std::exception& e) {
+            this->log_error(std::string("Error in index stage: ") + e.what());
+        }
+    });
+    pipeline->start();
+    return pipeline;
+}
 
-    auto is_stopped = [&]() {
-        return should_stop_.load() || (buffer_pool && buffer_pool->is_shutdown());
-    };
+void BackgroundFrameFetcher::record_failure(const VolumeJob& job) {
+    if (job.cancel.reason() == CancellationToken::Reason::DeadlineExceeded) {
+        this->log_error("Gave up on " + job.item.key + " after its " + std::to_string(job.config->item_deadline_seconds) + "s deadline");
+    }
+    frames_failed_.fetch_add(1);
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        station_stats_[job.item.station].frames_failed++;
+        station_stats_[job.item.station].last_fetch_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+    }
 
-    for (const auto& item : batch.items) {
-        if (is_stopped()) break;
+    // Done with an object that cannot be fetched; anything else goes round again until the work queue gives up on it
+    if (job.unfetchable) {
+        this->log_error("Giving up on " + job.item.key + ": missing or undecodable");
+        storage_->work_queue().ack({job.item.key});
+        return;
+    }
+    if (should_stop_.load() || !storage_->work_queue().retry(job.item.key)) return;
+    {
+        // Not bounded by max_discovery_queue_size: stage workers must not block on the fetch loop
+        std::lock_guard<std::mutex> lock(discovery_mutex_);
+        discovery_queue_.push({job.item});
+    }
+    discovery_cv_.notify_one();
+}
 
-        GetObjectRequest get_req;
-        get_req.WithBucket(item.bucket).WithKey(item.key);
+void BackgroundFrameFetcher::charge_station(VolumeJob& job) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    station_stats_[job.item.station].cost.add(job.cost);
+    job.cost = StationCost();
+}
 
-        auto get_outcome = s3_client->GetObject(get_req);
-        if (!get_outcome.IsSuccess()) {
-            this->log_error("Failed to get object " + item.key + ": " + get_outcome.GetError().GetMessage());
-            frames_failed_.fetch_add(1);
-            
-            {
-                std::lock_guard<std::mutex> lock(stats_mutex_);
-                station_stats_[item.station].frames_failed++;
-                station_stats_[item.station].last_fetch_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-            }
-            continue;
+bool BackgroundFrameFetcher::download_volume(VolumeJob& job) {
+    const FrameFetcherConfig& config = *job.config;
+    const DiscoveryItem& item = job.item;
+    if (job.cancel.cancelled() || !job.buffer_pool) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(requeue_mutex_);
+        requeued_volumes_.erase(item.station + item.timestamp);
+    }
+
+    // A stalled read or a runaway decode costs only this object; the clock starts when the download does
+    job.cancel = config.item_deadline_seconds > 0
+        ? job.cancel.child(std::chrono::seconds(config.item_deadline_seconds))
+        : job.cancel.child();
+
+    job.raw = ScopedBuffer(job.buffer_pool);
+    if (!job.raw.valid()) return false;
+    job.raw->clear();
+
+    // Base scan first: the leading tilts are stored from a ranged read, then the rest follows
+    size_t object_size = 0;
+    bool base_only = config.base_only_stations.count(item.station) > 0;
+    if (config.base_scan_bytes > 0 || base_only) {
+        bool published = publish_base_scan(item, config, job.buffer_pool, job.cancel, *job.raw, object_size, base_only, &job.cost);
+        if (published && base_only) {
+            last_fetch_timestamp_.store(std::chrono::system_clock::now().time_since_epoch().count());
+            job.cost.bytes_downloaded += job.raw->size();
+            job.raw.reset();
+            job.stored = true;
+            return true;
         }
+    }
 
-        auto result = get_outcome.GetResultWithOwnership();
-        auto& stream = result.GetBody();
-        
-        ScopedBuffer raw_data(buffer_pool);
-        if (!raw_data.valid()) continue;
-        raw_data->clear();
-        
-        char temp_buf[65536];
-        while (!is_stopped()) {
-            stream.read(temp_buf, sizeof(temp_buf));
-            std::streamsize bytes_read = stream.gcount();
-            if (bytes_read > 0) {
-                raw_data->insert(raw_data->end(), temp_buf, temp_buf + bytes_read);
-            }
-            if (!stream) break;
+    FetchResult fetched = FetchResult::Failed;
+    if (!job.cancel.cancelled()) {
+        fetched = object_size > 0 && job.raw->size() >= object_size
+            ? FetchResult::Ok
+            : fetch_object(item, job.raw->size(), 0, *job.raw, object_size, job.cancel);
+    }
+    job.cost.bytes_downloaded += job.raw->size();
+    job.cost.peak_scratch_bytes = std::max<uint64_t>(job.cost.peak_scratch_bytes, job.raw->size());
+    if (fetched != FetchResult::Ok || job.cancel.cancelled() || job.raw->empty()) {
+        // Shutdown is not a failure; the object stays in the work queue for the next start
+        if (job.cancel.reason() == CancellationToken::Reason::Cancelled) return false;
+        job.unfetchable = !job.cancel.cancelled() &&
+                          (fetched == FetchResult::Missing || (fetched == FetchResult::Ok && job.raw->empty()));
+        record_failure(job);
+        return false;
+    }
+    return true;
+}
+
+bool BackgroundFrameFetcher::decode_volume(VolumeJob& job) {
+    if (job.stored) return true;
+    if (job.cancel.cancelled()) {
+        if (job.cancel.reason() != CancellationToken::Reason::Cancelled) record_failure(job);
+        return false;
+    }
+    const FrameFetcherConfig& config = *job.config;
+
+    ScopedBuffer decompressed_data(job.buffer_pool);
+    if (!decompressed_data.valid()) return false;
+    decompressed_data->clear();
+
+    // A lone volume (quiet period) gets all parse threads; under load each volume decodes serially
+    int parsing = active_parses_.fetch_add(1) + 1;
+    ParseOptions parse_options = to_parse_options(config, parsing);
+    job.frames = parse_nexrad_level2_multi(*job.raw, job.item.station, job.item.timestamp, config.products, decompressed_data.get(),
+                                           config.generate_3d, parse_options);
+    active_parses_.fetch_sub(1);
+    job.cost.bytes_decompressed += decompressed_data->size();
+    job.cost.peak_scratch_bytes = std::max<uint64_t>(job.cost.peak_scratch_bytes, job.raw->size() + decompressed_data->size());
+
+    // Every product comes back empty from a truncated or corrupt object; another fetch gets the same bytes
+    bool decoded = std::any_of(job.frames.begin(), job.frames.end(),
+                               [](const auto& pair) { return pair.second && !pair.second->available_tilts.empty(); });
+    if (!decoded) {
+        job.unfetchable = true;
+        record_failure(job);
+        return false;
+    }
+
+    if (job.max_tilts > 0) {
+        size_t dropped = 0;
+        for (auto& [product, frame] : job.frames) {
+            if (frame) dropped += keep_lowest_tilts(*frame, job.max_tilts);
         }
+        if (dropped > 0) {
+            degradation_.count_tilts_skipped(dropped);
+            job.degraded = true;
+        }
+    }
 
-        if (is_stopped()) break;
-        if (raw_data->empty()) {
-            continue;
+    // Release buffers early to avoid deadlocks when processing many products
+    job.raw.reset();
+    return true;
+}
+
+bool BackgroundFrameFetcher::store_volume(VolumeJob& job) {
+    if (job.stored) return true;
+    store_frames(job.item, job.frames, *job.config, job.buffer_pool, job.cancel, nullptr, true, &job.cost);
+    job.frames.clear();
+    last_fetch_timestamp_.store(std::chrono::system_clock::now().time_since_epoch().count());
+    if (job.cancel.cancelled()) {
+        if (job.cancel.reason() != CancellationToken::Reason::Cancelled) record_failure(job);
+        return false;
+    }
+    return true;
+}
+
+void BackgroundFrameFetcher::index_volumes(std::vector<VolumeJob>& jobs) {
+    std::set<std::pair<std::string, std::string>> products;
+    std::vector<std::string> completed;
+    std::vector<DiscoveryItem> degraded;
+    std::map<std::string, StationCost> costs;
+    for (const auto& job : jobs) {
+        for (const auto& product : job.config->products) products.insert({job.item.station, product});
+        if (job.degraded) {
+            degraded.push_back(job.item);
+        } else {
+            completed.push_back(job.item.key);
         }
+        costs[job.item.station].volumes++;
+    }
+    for (const auto& [station, product] : products) {
+        uint64_t started = thread_cpu_ns();
+        storage_->update_index(station, product);
+        costs[station].index_cpu_ns += thread_cpu_ns() - started;
+    }
+    // Only objects whose frames are all stored; failures were retried or acknowledged by record_failure.
+    // Volumes stored with something shed stay in the work queue, and are fetched again once back at full.
+    storage_->work_queue().ack(completed);
+    if (!degraded.empty()) {
+        std::lock_guard<std::mutex> lock(backfill_mutex_);
+        for (auto& item : degraded) backfill_.push_back(std::move(item));
+    }
 
-        ScopedBuffer decompressed_data(buffer_pool);
-        if (!decompressed_data.valid()) continue;
-        decompressed_data->clear();
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    for (const auto& [station, cost] : costs) station_stats_[station].cost.add(cost);
+}
 
-        auto frames = parse_nexrad_level2_multi(*raw_data, item.station, item.timestamp, config.products, decompressed_data.get(), config.generate_3d);
-        
-        // Release buffers early to avoid deadlocks when processing many products
-        raw_data.reset();
-        decompressed_data.reset();
+void BackgroundFrameFetcher::store_frames(const DiscoveryItem& item, std::unordered_map<std::string, std::unique_ptr<RadarFrame>>& frames,
+                                          const FrameFetcherConfig& config, const std::shared_ptr<BufferPool>& buffer_pool,
+                                          const CancellationToken& cancel, const std::map<std::string, std::set<float>>* only_tilts,
+                                          bool count_frames, StationCost* cost) {
+    // Checked per tilt and per sweep; the per-gate loops below run without branches on it
+    auto is_stopped = [&]() { return cancel.cancelled(); };
 
-        for (auto& pair : frames) {
-            if (is_stopped()) break;
-            const std::string& product = pair.first;
-            auto& frame = pair.second;
-            if (is_stopped()) break;
+    for (auto& pair : frames) {
+        if (is_stopped()) break;
+        const std::string& product = pair.first;
+        auto& frame = pair.second;
+        if (is_stopped()) break;
 
-                try {
-                    if (!frame || frame->available_tilts.empty()) continue;
+        const std::set<float>* only = nullptr;
+        if (only_tilts) {
+            auto it = only_tilts->find(product);
+            if (it == only_tilts->end()) continue;
+            only = &it->second;
+        }
 
-                    std::vector<float> sorted_tilts = frame->available_tilts;
-                    std::sort(sorted_tilts.begin(), sorted_tilts.end());
+        try {
+            if (!frame || frame->available_tilts.empty()) continue;
 
-                    const uint16_t vol_num_rays = 720;
-                    const float vol_res_factor = 2.0f;
-                    const uint16_t vol_num_gates = frame->ngates;
-                    const uint16_t vol_num_tilts = static_cast<uint16_t>(sorted_tilts.size());
-                    
-                    if (vol_num_gates == 0 || frame->gate_spacing_meters <= 0) continue;
-                    
-                    // Safety: limit allocation size
-                    size_t total_elements = static_cast<size_t>(vol_num_tilts) * vol_num_rays * vol_num_gates;
-                    if (total_elements > 200000000) { // 200M elements (~200MB)
-                        continue;
-                    }
+            std::vector<float> sorted_tilts = frame->available_tilts;
+            std::sort(sorted_tilts.begin(), sorted_tilts.end());
 
-                    // Pool processing buffers
-                    ScopedBuffer vol_grid_buf(buffer_pool);
-                    if (!vol_grid_buf.valid()) continue;
-                    vol_grid_buf->assign(total_elements, 0);
-                    std::vector<uint8_t>& vol_grid = *vol_grid_buf;
-                    
-                    auto params = get_quant_params(product);
-
-                    for (size_t tilt_idx = 0; tilt_idx < sorted_tilts.size(); ++tilt_idx) {
-                        if (is_stopped()) break;
-                        float tilt = sorted_tilts[tilt_idx];
-                        if (is_stopped()) break;
-
-                        // Check if this tilt has any sweeps before proceeding
-                        bool has_sweeps = false;
-                        for (const auto& sweep : frame->sweeps) {
-                            if (is_stopped()) break;
-                            if (std::abs(sweep.elevation_deg - tilt) < 0.01f) {
-                                has_sweeps = true;
-                                break;
-                            }
-                        }
-                        if (is_stopped()) break;
-                        if (!has_sweeps) continue;
-
-                        uint16_t num_rays = 360;
-                        float resolution_factor = 1.0f;
-                        if (frame->elevation_ray_counts) {
-                            auto ray_count_it = frame->elevation_ray_counts->find(RadarFrame::get_tilt_key(tilt));
-                            if (ray_count_it != frame->elevation_ray_counts->end() && ray_count_it->second > 400) {
-                                num_rays = 720;
-                                resolution_factor = 2.0f;
+            const uint16_t vol_num_rays = 720;
+            const float vol_res_factor = 2.0f;
+            const uint16_t vol_num_gates = frame->ngates;
+            const uint16_t vol_num_tilts = static_cast<uint16_t>(sorted_tilts.size());
+            
+            if (vol_num_gates == 0 || frame->gate_spacing_meters <= 0) continue;
+            
+            // Safety: limit allocation size
+            size_t total_elements = static_cast<size_t>(vol_num_tilts) * vol_num_rays * vol_num_gates;
+            if (total_elements > 200000000) { // 200M elements (~200MB)
+                continue;
+            }
+
+            // Pool processing buffers
+            ScopedBuffer vol_grid_buf(buffer_pool);
+            if (!vol_grid_buf.valid()) continue;
+            vol_grid_buf->assign(only ? 0 : total_elements, 0);
+            std::vector<uint8_t>& vol_grid = *vol_grid_buf;
+            
+            auto params = get_quant_params(product);
+
+            for (size_t tilt_idx = 0; tilt_idx < sorted_tilts.size(); ++tilt_idx) {
+                if (is_stopped()) break;
+                float tilt = sorted_tilts[tilt_idx];
+                if (is_stopped()) break;
+                if (only && !only->count(tilt)) continue;
+
+                // Check if this tilt has any sweeps before proceeding
+                const RadarFrame::Sweep* first_sweep = nullptr;
+                for (const auto& sweep : frame->sweeps) {
+                    if (std::abs(sweep.elevation_deg - tilt) < 0.01f) {
+                        first_sweep = &sweep;
+                        break;
+                    }
+                }
+                if (is_stopped()) break;
+                if (!first_sweep) continue;
+
+                // Grid resolution comes from the VCP plan; sweeps without a planned cut fall back to observed counts
+                uint16_t num_rays = 360;
+                float resolution_factor = 1.0f;
+                int planned_rays = frame->planned_radials(*first_sweep);
+                if (planned_rays == 720) {
+                    num_rays = 720;
+                    resolution_factor = 2.0f;
+                } else if (planned_rays == 0 && frame->elevation_ray_counts) {
+                    auto ray_count_it = frame->elevation_ray_counts->find(RadarFrame::get_tilt_key(tilt));
+                    if (ray_count_it != frame->elevation_ray_counts->end() && ray_count_it->second > 400) {
+                        num_rays = 720;
+                        resolution_factor = 2.0f;
+                    }
+                }
+                
+                ScopedBuffer grid_2d_buf(buffer_pool);
+                if (!grid_2d_buf.valid()) continue;
+                grid_2d_buf->assign(static_cast<size_t>(num_rays) * vol_num_gates, 0);
+                std::vector<uint8_t>& grid_2d = *grid_2d_buf;
+                
+                for (const auto& sweep : frame->sweeps) {
+                    if (is_stopped()) break;
+                    if (std::abs(sweep.elevation_deg - tilt) < 0.01f) {
+                        for (size_t j = 0; j + 2 < sweep.bins.size(); j += 3) {
+                            float azimuth = sweep.bins[j];
+                            float range = sweep.bins[j+1];
+                            float value = sweep.bins[j+2];
+
+                            uint8_t val = quantize_value(value, params.value_min, params.value_max);
+                            if (val == 0) continue;
+
+                            int gate_idx = static_cast<int>(std::floor((range - frame->first_gate_meters) / frame->gate_spacing_meters));
+                            if (gate_idx < 0 || gate_idx >= static_cast<int>(vol_num_gates)) continue;
+
+                            int ray_idx_2d = static_cast<int>(std::floor(azimuth * resolution_factor + 0.01f)) % num_rays;
+                            if (ray_idx_2d < 0) ray_idx_2d += num_rays;
+                            size_t idx_2d = static_cast<size_t>(ray_idx_2d) * vol_num_gates + gate_idx;
+                            if (idx_2d < grid_2d.size()) {
+                                grid_2d[idx_2d] = std::max(grid_2d[idx_2d], val);
                             }
-                        }
-                        
-                        ScopedBuffer grid_2d_buf(buffer_pool);
-                        if (!grid_2d_buf.valid()) continue;
-                        grid_2d_buf->assign(static_cast<size_t>(num_rays) * vol_num_gates, 0);
-                        std::vector<uint8_t>& grid_2d = *grid_2d_buf;
-                        
-                        for (const auto& sweep : frame->sweeps) {
-                            if (is_stopped()) break;
-                            if (std::abs(sweep.elevation_deg - tilt) < 0.01f) {
-                                for (size_t j = 0; j + 2 < sweep.bins.size(); j += 3) {
-                                    if (is_stopped()) break;
-                                    float azimuth = sweep.bins[j];
-                                    float range = sweep.bins[j+1];
-                                    float value = sweep.bins[j+2];
-
-                                    uint8_t val = quantize_value(value, params.value_min, params.value_max);
-                                    if (val == 0) continue;
-
-                                    int gate_idx = static_cast<int>(std::floor((range - frame->first_gate_meters) / frame->gate_spacing_meters));
-                                    if (gate_idx < 0 || gate_idx >= static_cast<int>(vol_num_gates)) continue;
-
-                                    int ray_idx_2d = static_cast<int>(std::floor(azimuth * resolution_factor + 0.01f)) % num_rays;
-                                    if (ray_idx_2d < 0) ray_idx_2d += num_rays;
-                                    size_t idx_2d = static_cast<size_t>(ray_idx_2d) * vol_num_gates + gate_idx;
-                                    if (idx_2d < grid_2d.size()) {
-                                        grid_2d[idx_2d] = std::max(grid_2d[idx_2d], val);
-                                    }
-
-                                    int ray_idx_3d = static_cast<int>(std::floor(azimuth * vol_res_factor + 0.01f)) % vol_num_rays;
-                                    if (ray_idx_3d < 0) ray_idx_3d += vol_num_rays;
-                                    size_t idx_3d = (static_cast<size_t>(tilt_idx) * vol_num_rays * vol_num_gates) + 
-                                                    (static_cast<size_t>(ray_idx_3d) * vol_num_gates) + gate_idx;
-                                    if (idx_3d < vol_grid.size()) {
-                                        vol_grid[idx_3d] = std::max(vol_grid[idx_3d], val);
-                                        if (resolution_factor < 1.5f) {
-                                            int adjacent_ray = (ray_idx_3d + 1) % vol_num_rays;
-                                            size_t adj_idx = (static_cast<size_t>(tilt_idx) * vol_num_rays * vol_num_gates) + 
-                                                             (static_cast<size_t>(adjacent_ray) * vol_num_gates) + gate_idx;
-                                            if (adj_idx < vol_grid.size()) vol_grid[adj_idx] = std::max(vol_grid[adj_idx], val);
-                                        }
-                                    }
+
+                            int ray_idx_3d = static_cast<int>(std::floor(azimuth * vol_res_factor + 0.01f)) % vol_num_rays;
+                            if (ray_idx_3d < 0) ray_idx_3d += vol_num_rays;
+                            size_t idx_3d = (static_cast<size_t>(tilt_idx) * vol_num_rays * vol_num_gates) + 
+                                            (static_cast<size_t>(ray_idx_3d) * vol_num_gates) + gate_idx;
+                            if (idx_3d < vol_grid.size()) {
+                                vol_grid[idx_3d] = std::max(vol_grid[idx_3d], val);
+                                if (resolution_factor < 1.5f) {
+                                    int adjacent_ray = (ray_idx_3d + 1) % vol_num_rays;
+                                    size_t adj_idx = (static_cast<size_t>(tilt_idx) * vol_num_rays * vol_num_gates) + 
+                                                     (static_cast<size_t>(adjacent_ray) * vol_num_gates) + gate_idx;
+                                    if (adj_idx < vol_grid.size()) vol_grid[adj_idx] = std::max(vol_grid[adj_idx], val);
                                 }
                             }
                         }
+                    }
+                }
 
-                        if (is_stopped()) break;
-
-                        ScopedBuffer bitmask_2d_buf(buffer_pool);
-                        ScopedBuffer values_2d_buf(buffer_pool);
-                        if (!bitmask_2d_buf.valid() || !values_2d_buf.valid()) continue;
-                        
-                        bitmask_2d_buf->assign((grid_2d.size() + 7) / 8, 0);
-                        values_2d_buf->clear();
-                        
-                        std::vector<uint8_t>& bitmask_2d = *bitmask_2d_buf;
-                        std::vector<uint8_t>& values_2d = *values_2d_buf;
-
-                        for (size_t b = 0; b < grid_2d.size(); ++b) {
-                            if (grid_2d[b] > 0) {
-                                bitmask_2d[b / 8] |= (1 << (7 - (b % 8)));
-                                values_2d.push_back(grid_2d[b]);
-                            }
+                if (is_stopped()) break;
+
+                ScopedBuffer bitmask_2d_buf(buffer_pool);
+                ScopedBuffer values_2d_buf(buffer_pool);
+                if (!bitmask_2d_buf.valid() || !values_2d_buf.valid()) continue;
+                
+                bitmask_2d_buf->assign((grid_2d.size() + 7) / 8, 0);
+                values_2d_buf->clear();
+                
+                std::vector<uint8_t>& bitmask_2d = *bitmask_2d_buf;
+                std::vector<uint8_t>& values_2d = *values_2d_buf;
+
+                for (size_t b = 0; b < grid_2d.size(); ++b) {
+                    if (grid_2d[b] > 0) {
+                        bitmask_2d[b / 8] |= (1 << (7 - (b % 8)));
+                        values_2d.push_back(grid_2d[b]);
+                    }
+                }
+
+                if (is_stopped()) break;
+
+                if (cost) {
+                    uint64_t scratch = vol_grid.size() + grid_2d.size() + bitmask_2d.size() + values_2d.size();
+                    cost->peak_scratch_bytes = std::max(cost->peak_scratch_bytes, scratch);
+                }
+
+                if (config.save_individual_tilts) {
+                    size_t stored_bytes = 0;
+                    bool saved = storage_->save_frame_bitmask(item.station, product, item.timestamp, tilt, num_rays, vol_num_gates, frame->gate_spacing_meters, frame->first_gate_meters, bitmask_2d, values_2d, frame->dualpol_meta, false, &stored_bytes);
+                    if (cost) cost->bytes_stored += stored_bytes;
+                    if (saved && count_frames) {
+                        frames_fetched_.fetch_add(1);
+                        {
+                            std::lock_guard<std::mutex> lock(stats_mutex_);
+                            station_stats_[item.station].frames_fetched++;
+                            station_stats_[item.station].last_fetch_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+                            station_stats_[item.station].last_frame_timestamp = item.timestamp;
                         }
+                    }
+                }
+            }
 
-                        if (is_stopped()) break;
+            if (is_stopped()) continue;
 
-                        if (config.save_individual_tilts) {
-                            if (storage_->save_frame_bitmask(item.station, product, item.timestamp, tilt, num_rays, vol_num_gates, frame->gate_spacing_meters, frame->first_gate_meters, bitmask_2d, values_2d, frame->dualpol_meta, false)) {
-                                frames_fetched_.fetch_add(1);
-                                {
-                                    std::lock_guard<std::mutex> lock(stats_mutex_);
-                                    station_stats_[item.station].frames_fetched++;
-                                    station_stats_[item.station].last_fetch_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-                                    station_stats_[item.station].last_frame_timestamp = item.timestamp;
-                                }
-                            }
+            // Base tilts from a ranged read: no volumetric file, and publish_base_scan decides what to publish
+            if (only) {
+                frame->clear_data();
+                continue;
+            }
+
+            if (config.save_volumetric) {
+                ScopedBuffer vol_bitmask_buf(buffer_pool);
+                ScopedBuffer vol_values_buf(buffer_pool);
+                if (vol_bitmask_buf.valid() && vol_values_buf.valid()) {
+                    vol_bitmask_buf->assign((vol_grid.size() + 7) / 8, 0);
+                    vol_values_buf->clear();
+                    
+                    std::vector<uint8_t>& vol_bitmask = *vol_bitmask_buf;
+                    std::vector<uint8_t>& vol_values = *vol_values_buf;
+                    
+                    for (size_t b = 0; b < vol_grid.size(); ++b) {
+                        if (vol_grid[b] > 0) {
+                            vol_bitmask[b / 8] |= (1 << (7 - (b % 8)));
+                            vol_values.push_back(vol_grid[b]);
                         }
                     }
 
-                    if (is_stopped()) continue;
-
-                    if (config.save_volumetric) {
-                        ScopedBuffer vol_bitmask_buf(buffer_pool);
-                        ScopedBuffer vol_values_buf(buffer_pool);
-                        if (vol_bitmask_buf.valid() && vol_values_buf.valid()) {
-                            vol_bitmask_buf->assign((vol_grid.size() + 7) / 8, 0);
-                            vol_values_buf->clear();
-                            
-                            std::vector<uint8_t>& vol_bitmask = *vol_bitmask_buf;
-                            std::vector<uint8_t>& vol_values = *vol_values_buf;
-                            
-                            for (size_t b = 0; b < vol_grid.size(); ++b) {
-                                if ((b & 0xFFFF) == 0 && is_stopped()) break;
-                                if (vol_grid[b] > 0) {
-                                    vol_bitmask[b / 8] |= (1 << (7 - (b % 8)));
-                                    vol_values.push_back(vol_grid[b]);
-                                }
-                            }
+                    if (cost) {
+                        uint64_t scratch = vol_grid.size() + vol_bitmask.size() + vol_values.size();
+                        cost->peak_scratch_bytes = std::max(cost->peak_scratch_bytes, scratch);
+                    }
 
-                            if (!vol_values.empty() && !is_stopped()) {
-                                if (storage_->save_volumetric_bitmask(item.station, product, item.timestamp, sorted_tilts, vol_num_rays, vol_num_gates, frame->gate_spacing_meters, frame->first_gate_meters, vol_bitmask, vol_values, frame->dualpol_meta, false)) {
-                                    if (!config.save_individual_tilts) {
-                                        frames_fetched_.fetch_add(1);
-                                        std::lock_guard<std::mutex> lock(stats_mutex_);
-                                        station_stats_[item.station].frames_fetched++;
-                                        station_stats_[item.station].last_fetch_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
-                                        station_stats_[item.station].last_frame_timestamp = item.timestamp;
-                                    }
-                                }
+                    if (!vol_values.empty() && !is_stopped()) {
+                        size_t stored_bytes = 0;
+                        bool saved = storage_->save_volumetric_bitmask(item.station, product, item.timestamp, sorted_tilts, vol_num_rays, vol_num_gates, frame->gate_spacing_meters, frame->first_gate_meters, vol_bitmask, vol_values, frame->dualpol_meta, false, &stored_bytes);
+                        if (cost) cost->bytes_stored += stored_bytes;
+                        if (saved) {
+                            if (!config.save_individual_tilts && count_frames) {
+                                frames_fetched_.fetch_add(1);
+                                std::lock_guard<std::mutex> lock(stats_mutex_);
+                                station_stats_[item.station].frames_fetched++;
+                                station_stats_[item.station].last_fetch_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+                                station_stats_[item.station].last_frame_timestamp = item.timestamp;
                             }
                         }
                     }
-                    
-                    // CRITICAL: Reclaim memory from RadarFrame as soon as it's processed and saved
-                    frame->clear_data();
-                    
-                } catch (const std::exception& e) {
-                    this->log_error("Exception parsing/processing " + product + " for " + item.station + ": " + e.what());
-                } catch (...) {
-                    this->log_error("Unknown exception parsing/processing " + product + " for " + item.station);
                 }
+            }
+            
+            // Every tilt of this product is on disk now, hand the volume to the object sink
+            if (!is_stopped()) {
+                storage_->publish_volume(item.station, product, item.timestamp);
+            }
+
+            // CRITICAL: Reclaim memory from RadarFrame as soon as it's processed and saved
+            frame->clear_data();
+            
+        } catch (const std::exception& e) {
+            this->log_error("Exception parsing/processing " + product + " for " + item.station + ": " + e.what());
+        } catch (...) {
+            this->log_error("Unknown exception parsing/processing " + product + " for " + item.station);
         }
-        last_fetch_timestamp_.store(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+}
+
+BackgroundFrameFetcher::FetchResult BackgroundFrameFetcher::fetch_object(const DiscoveryItem& item, size_t begin, size_t length,
+                                                                         std::vector<uint8_t>& out, size_t& object_size,
+                                                                         const CancellationToken& cancel) {
+    using namespace Aws::S3::Model;
+
+    auto s3_client = AWSInitializer::instance().get_s3_client();
+    if (!s3_client) return FetchResult::Failed;
+
+    GetObjectRequest get_req;
+    get_req.WithBucket(item.bucket).WithKey(item.key);
+    bool ranged = begin > 0 || length > 0;
+    if (ranged) {
+        get_req.WithRange("bytes=" + std::to_string(begin) + "-" + (length > 0 ? std::to_string(begin + length - 1) : ""));
     }
 
-    // Update index once per batch after ALL items and ALL products are saved
-    for (const auto& product : config.products) {
-        storage_->update_index(batch.station, product);
+    auto get_outcome = s3_client->GetObject(get_req);
+    if (!get_outcome.IsSuccess()) {
+        this->log_error("Failed to get object " + item.key + ": " + get_outcome.GetError().GetMessage());
+        return get_outcome.GetError().GetErrorType() == Aws::S3::S3Errors::NO_SUCH_KEY ||
+                       get_outcome.GetError().GetResponseCode() == Aws::Http::HttpResponseCode::NOT_FOUND
+                   ? FetchResult::Missing
+                   : FetchResult::Failed;
     }
+
+    auto result = get_outcome.GetResultWithOwnership();
+    auto& stream = result.GetBody();
+    size_t start = out.size();
+
+    char temp_buf[65536];
+    while (!cancel.cancelled()) {
+        stream.read(temp_buf, sizeof(temp_buf));
+        std::streamsize bytes_read = stream.gcount();
+        if (bytes_read > 0) {
+            out.insert(out.end(), temp_buf, temp_buf + bytes_read);
+        }
+        if (!stream) break;
+    }
+
+    size_t total = ranged ? content_range_total(result.GetContentRange()) : 0;
+    object_size = total > 0 ? total : begin + (out.size() - start);
+    return FetchResult::Ok;
+}
+
+bool BackgroundFrameFetcher::publish_base_scan(const DiscoveryItem& item, const FrameFetcherConfig& config,
+                                               const std::shared_ptr<BufferPool>& buffer_pool, const CancellationToken& cancel,
+                                               std::vector<uint8_t>& raw, size_t& object_size, bool base_only,
+                                               StationCost* cost) {
+    auto is_stopped = [&]() { return cancel.cancelled(); };
+
+    // Base-only stations still need a step size; 1 MB covers the lowest tilts of most volumes
+    const size_t step = config.base_scan_bytes > 0 ? config.base_scan_bytes : 1024 * 1024;
+    const size_t limit = step * 8;
+
+    while (!is_stopped()) {
+        // Double the prefix until every product has a finished tilt
+        size_t want = raw.empty() ? step : std::min(raw.size(), limit - std::min(limit, raw.size()));
+        if (want == 0 || fetch_object(item, raw.size(), want, raw, object_size, cancel) != FetchResult::Ok) return false;
+        if (is_stopped() || raw.size() >= object_size) return false;  // Small volume: parse it whole
+
+        size_t prefix = RadarDecompression::complete_ldm_prefix(raw.data(), raw.size());
+        if (prefix == 0) continue;
+
+        // Parse the complete records only; the partial one stays for the next read
+        std::vector<uint8_t> tail(raw.begin() + prefix, raw.end());
+        raw.resize(prefix);
+        ScopedBuffer decompressed_data(buffer_pool);
+        if (!decompressed_data.valid()) {
+            raw.insert(raw.end(), tail.begin(), tail.end());
+            return false;
+        }
+        decompressed_data->clear();
+
+        int parsing = active_parses_.fetch_add(1) + 1;
+        ParseOptions parse_options = to_parse_options(config, parsing);
+        auto frames = parse_nexrad_level2_multi(raw, item.station, item.timestamp, config.products, decompressed_data.get(), false, parse_options);
+        active_parses_.fetch_sub(1);
+        if (cost) {
+            cost->bytes_decompressed += decompressed_data->size();
+            cost->peak_scratch_bytes = std::max<uint64_t>(cost->peak_scratch_bytes, raw.size() + tail.size() + decompressed_data->size());
+        }
+        decompressed_data.reset();
+        raw.insert(raw.end(), tail.begin(), tail.end());
+
+        std::map<std::string, std::set<float>> only_tilts;
+        bool ready = !frames.empty();
+        for (const auto& [product, frame] : frames) {
+            bool has_data = false;
+            std::set<float> tilts = frame ? finished_tilts(*frame, has_data) : std::set<float>{};
+            if (!tilts.empty()) only_tilts[product] = std::move(tilts);
+            ready = ready && has_data;
+        }
+        if (!ready && raw.size() < limit) continue;
+        if (only_tilts.empty()) return false;
+
+        // Frames are counted once per volume: here only when the rest of the object is not fetched
+        store_frames(item, frames, config, buffer_pool, cancel, &only_tilts, base_only, cost);
+        // Indexed now, not by the index stage once the whole object is in, so clients see the base tilts first
+        for (const auto& [product, tilts] : only_tilts) {
+            uint64_t started = thread_cpu_ns();
+            storage_->update_index(item.station, product);
+            if (cost) cost->index_cpu_ns += thread_cpu_ns() - started;
+        }
+        // For a base-only station the base scan is the whole volume, so it goes to the object sink now
+        if (base_only && !is_stopped()) {
+            for (const auto& [product, tilts] : only_tilts) storage_->publish_volume(item.station, product, item.timestamp);
+        }
+        this->log_info("Stored base scan of " + item.key + " from the first " + std::to_string(prefix) + " of " +
+                       std::to_string(object_size) + " bytes");
+        return true;
+    }
+    return false;
+}
+
+void BackgroundFrameFetcher::requeue_volume(const std::string& station, const std::string& timestamp) {
+    if (should_stop_.load() || timestamp.size() < 15) return;
+    {
+        // Several corrupt tilts of one volume need only one fetch
+        std::lock_guard<std::mutex> lock(requeue_mutex_);
+        if (!requeued_volumes_.insert(station + timestamp).second) return;
+    }
+
+    // The object the volume came from; volumes stored before sources were kept fall back to the usual name
+    DurableWorkQueue::Item work;
+    if (!storage_->work_queue().source(station, timestamp, work)) {
+        work = {station,
+                timestamp.substr(0, 4) + "/" + timestamp.substr(4, 2) + "/" + timestamp.substr(6, 2) + "/" +
+                    station + "/" + station + timestamp + "_V06",
+                NEXRAD_BUCKET, timestamp};
+    }
+    DiscoveryItem item{work.station, work.key, work.bucket, work.timestamp};
+
+    if (storage_->work_queue().add({work}).empty()) {
+        // Fetched again anyway, and storing it again replaces the corrupt file
+        this->log_info("Not re-queueing " + item.key + " after a checksum failure: it is already outstanding");
+        return;
+    }
+
+    {
+        // Not bounded by max_discovery_queue_size: blocking here would stall stop()
+        std::lock_guard<std::mutex> lock(discovery_mutex_);
+        discovery_queue_.push({item});
+    }
+    discovery_cv_.notify_one();
+    this->log_info("Re-queued " + item.key + " after a checksum failure");
+}
+
+void BackgroundFrameFetcher::discover_all_stations(bool include_yesterday) {
+    auto s3_client = AWSInitializer::instance().get_s3_client();
+    if (!s3_client) return;
+    auto started = std::chrono::steady_clock::now();
+
+    std::time_t t_now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::time_t t_yesterday = t_now - (24 * 60 * 60);
+    std::tm utc_tm, yest_tm;
+    gmtime_r(&t_now, &utc_tm);
+    gmtime_r(&t_yesterday, &yest_tm);
+
+    // Yesterday's prefix only matters for catch-up and for volumes finishing
+    // around midnight; after that every station's mark is past it
+    std::vector<std::string> prefixes;
+    char buf[32];
+    if (include_yesterday || utc_tm.tm_hour == 0) {
+        std::snprintf(buf, sizeof(buf), "%04d/%02d/%02d/", yest_tm.tm_year + 1900, yest_tm.tm_mon + 1, yest_tm.tm_mday);
+        prefixes.push_back(buf);
+    }
+    std::snprintf(buf, sizeof(buf), "%04d/%02d/%02d/", utc_tm.tm_year + 1900, utc_tm.tm_mon + 1, utc_tm.tm_mday);
+    prefixes.push_back(buf);
+
+    std::map<std::string, std::string> marks;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        for (const auto& [station, st] : station_stats_) marks[station] = st.last_processed_key;
+    }
+    int parallelism = 10;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        parallelism = config_.discovery_parallelism;
+    }
+
+    BulkDiscovery::ListPage list = [&](const std::string& prefix, const std::string& start_after, BulkDiscovery::Page& page) {
+        Aws::S3::Model::ListObjectsV2Request list_req;
+        list_req.WithBucket(NEXRAD_BUCKET).WithPrefix(prefix);
+        if (!start_after.empty()) list_req.WithStartAfter(start_after);
+        auto list_outcome = s3_client->ListObjectsV2(list_req);
+        if (!list_outcome.IsSuccess()) {
+            this->log_error("Failed to list S3 objects under " + prefix + ": " + list_outcome.GetError().GetMessage());
+            return false;
+        }
+        for (const auto& obj : list_outcome.GetResult().GetContents()) page.keys.push_back(obj.GetKey());
+        page.truncated = list_outcome.GetResult().GetIsTruncated();
+        return true;
+    };
+    auto stopped = [this]() { return should_stop_.load(); };
+
+    // Ranges of one prefix are listed in parallel; yesterday's keys are merged first to keep each station in order
+    BulkDiscovery::Result found;
+    for (const auto& prefix : prefixes) {
+        auto ranges = BulkDiscovery::partition(prefix, marks, static_cast<size_t>(std::max(parallelism, 1)));
+        std::vector<BulkDiscovery::Result> results(ranges.size());
+        levelii::parallel_for(ranges.size(), parallelism, [&](size_t i) {
+            BulkDiscovery::scan(prefix, ranges[i], marks, list, results[i], stopped);
+        });
+        for (auto& result : results) BulkDiscovery::merge(found, std::move(result));
+    }
+
+    size_t new_objects = 0;
+    for (auto& [station, keys] : found.keys) {
+        if (should_stop_.load()) break;
+        new_objects += keys.size();
+        try {
+            queue_new_objects(station, marks[station], std::move(keys));
+        } catch (const std::exception& e) {
+            this->log_error("Exception queueing " + station + ": " + e.what());
+        }
+    }
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        last_bulk_discovery_ = {
+            {"list_requests", found.requests},
+            {"keys_listed", found.keys_listed},
+            {"new_objects", new_objects},
+            {"stations_with_new_objects", found.keys.size()},
+            {"complete", found.complete},
+            {"duration_ms", elapsed_ms}
+        };
+    }
+    this->log_info("Bulk discovery: " + std::to_string(found.requests) + " listings, " + std::to_string(found.keys_listed) +
+                   " keys, " + std::to_string(new_objects) + " new objects from " + std::to_string(found.keys.size()) +
+                   " stations in " + std::to_string(static_cast<int>(elapsed_ms)) + " ms");
 }
 
 void BackgroundFrameFetcher::fetch_frame_for_station(const std::string& station) {
@@ -791,115 +1453,102 @@ void BackgroundFrameFetcher::fetch_frame_for_station(const std::string& station)
 
         if (objects.empty()) return;
 
-        // Sort by key (which is chronological for NEXRAD)
-        std::sort(objects.begin(), objects.end(), [](const auto& a, const auto& b) {
-            return a.GetKey() < b.GetKey();
-        });
+        std::vector<std::string> keys;
+        keys.reserve(objects.size());
+        for (const auto& obj : objects) keys.push_back(obj.GetKey());
+        queue_new_objects(station, last_key, std::move(keys));
+    } catch (const std::exception& e) {
+        this->log_error("Exception fetching " + station + ": " + e.what());
+    }
+}
 
-        int max_frames = 30;
-        bool catchup = true;
-        {
-            std::lock_guard<std::mutex> lock(state_mutex_);
-            max_frames = config_.max_frames_per_station;
-            catchup = config_.catchup_enabled;
-        }
-        
-        std::vector<Aws::S3::Model::Object> target_objects;
-        if (last_key.empty()) {
-            if (catchup) {
-                // Take up to max_frames of the LATEST objects if we're catching up
-                size_t count = std::min(objects.size(), static_cast<size_t>(max_frames));
-                for (size_t i = objects.size() - count; i < objects.size(); ++i) {
-                    target_objects.push_back(objects[i]);
-                }
-            } else {
-                // Only take the absolute latest one if no catchup
-                target_objects.push_back(objects.back());
-            }
+void BackgroundFrameFetcher::queue_new_objects(const std::string& station, const std::string& last_key, std::vector<std::string> keys) {
+    // Sort by key (which is chronological for NEXRAD)
+    std::sort(keys.begin(), keys.end());
+
+    int max_frames = 30;
+    bool catchup = true;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        max_frames = config_.max_frames_per_station;
+        catchup = config_.catchup_enabled;
+    }
+    
+    std::vector<std::string> target_keys;
+    if (last_key.empty()) {
+        if (catchup) {
+            // Take up to max_frames of the LATEST objects if we're catching up
+            size_t count = std::min(keys.size(), static_cast<size_t>(max_frames));
+            target_keys.assign(keys.end() - count, keys.end());
         } else {
-            // Processing all new items found since last_key
-            target_objects = objects;
+            // Only take the absolute latest one if no catchup
+            target_keys.push_back(keys.back());
         }
+    } else {
+        // Processing all new items found since last_key
+        target_keys = std::move(keys);
+    }
 
-        DiscoveryBatch batch;
-        batch.station = station;
-
-        std::string new_last_key = last_key;
-        for (const auto& obj : target_objects) {
-            if (should_stop_.load()) break;
-            
-            std::string key = obj.GetKey();
-            
-            std::string filename = key.substr(key.find_last_of('/') + 1);
-            if (filename.find("_MDM") != std::string::npos || filename.size() < 20) continue;
-            
-            std::string timestamp = filename.substr(4, 8) + "_" + filename.substr(filename.find('_') + 1, 6);
-
-            // Skip if already stored
-            bool all_exist = true;
-            FrameFetcherConfig current_config;
-            {
-                std::lock_guard<std::mutex> lock(state_mutex_);
-                current_config = config_;
-            }
-            for (const auto& prod : current_config.products) {
-                if (!storage_->has_timestamp_product(station, prod, timestamp)) {
-                    all_exist = false;
-                    break;
-                }
-            }
+    std::vector<DiscoveryItem> discovered;
+    std::string new_last_key = last_key;
+    for (const auto& key : target_keys) {
+        if (should_stop_.load()) break;
+        
+        std::string filename = key.substr(key.find_last_of('/') + 1);
+        if (filename.find("_MDM") != std::string::npos || filename.size() < 20) continue;
+        
+        std::string timestamp = filename.substr(4, 8) + "_" + filename.substr(filename.find('_') + 1, 6);
 
-            if (!all_exist) {
-                DiscoveryItem item;
-                item.station = station;
-                item.key = key;
-                item.bucket = NEXRAD_BUCKET;
-                item.timestamp = timestamp;
-                batch.items.push_back(item);
-                
-                // If batch gets too large, push it and start a new one to allow interleaving
-                if (batch.items.size() >= 5) {
-                    {
-                        std::unique_lock<std::mutex> lock(discovery_mutex_);
-                        if (config_.max_discovery_queue_size > 0) {
-                            discovery_full_cv_.wait(lock, [this]() {
-                                return should_stop_.load() || discovery_queue_.size() < config_.max_discovery_queue_size;
-                            });
-                        }
-                        if (should_stop_.load()) break;
-                        discovery_queue_.push(std::move(batch));
-                    }
-                    discovery_cv_.notify_one();
-                    
-                    batch = DiscoveryBatch();
-                    batch.station = station;
-                }
+        // Skip if already stored
+        bool all_exist = true;
+        FrameFetcherConfig current_config;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            current_config = config_;
+        }
+        for (const auto& prod : current_config.products) {
+            if (!storage_->has_timestamp_product(station, prod, timestamp)) {
+                all_exist = false;
+                break;
             }
-            new_last_key = key;
         }
 
-        if (!batch.items.empty() && !should_stop_.load()) {
-            {
-                std::unique_lock<std::mutex> lock(discovery_mutex_);
-                if (config_.max_discovery_queue_size > 0) {
-                    discovery_full_cv_.wait(lock, [this]() {
-                        return should_stop_.load() || discovery_queue_.size() < config_.max_discovery_queue_size;
-                    });
-                }
-                if (!should_stop_.load()) {
-                    discovery_queue_.push(std::move(batch));
-                }
+        if (!all_exist) {
+            DiscoveryItem item;
+            item.station = station;
+            item.key = key;
+            item.bucket = NEXRAD_BUCKET;
+            item.timestamp = timestamp;
+            // Persist before last_processed_key moves past it; skip objects already outstanding
+            if (!storage_->work_queue().add({to_work_item(item)}).empty()) {
+                discovered.push_back(item);
             }
-            discovery_cv_.notify_one();
         }
+        new_last_key = key;
+    }
 
+    // One push per scan, so the newest object is known when the fair queue
+    // decides what to fast-track. The bound is checked before the push and
+    // may be exceeded by one scan's worth per discovery thread.
+    if (!discovered.empty() && !should_stop_.load()) {
         {
-            std::lock_guard<std::mutex> lock(stats_mutex_);
-            station_stats_[station].last_processed_key = new_last_key;
-            station_stats_[station].last_scan_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
+            std::unique_lock<std::mutex> lock(discovery_mutex_);
+            if (config_.max_discovery_queue_size > 0) {
+                discovery_full_cv_.wait(lock, [this]() {
+                    return should_stop_.load() || discovery_queue_.batches() < static_cast<size_t>(config_.max_discovery_queue_size);
+                });
+            }
+            if (!should_stop_.load()) {
+                discovery_queue_.push(std::move(discovered));
+            }
         }
-    } catch (const std::exception& e) {
-        this->log_error("Exception fetching " + station + ": " + e.what());
+        discovery_cv_.notify_one();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        station_stats_[station].last_processed_key = new_last_key;
+        station_stats_[station].last_scan_timestamp = std::chrono::system_clock::now().time_since_epoch().count();
     }
 }
 
@@ -919,12 +1568,32 @@ json BackgroundFrameFetcher::get_statistics() const {
             {"scan_interval", config_.scan_interval_seconds}
         };
 
-        if (fetch_thread_pool_) {
+        if (fetch_pipeline_) {
+            size_t active = 0, queued = 0;
+            json stages = json::array();
+            for (const auto& stage : fetch_pipeline_->stats()) {
+                active += stage.active;
+                queued += stage.queued;
+                stages.push_back({
+                    {"name", stage.name},
+                    {"workers", stage.workers},
+                    {"active", stage.active},
+                    {"queued", stage.queued},
+                    {"capacity", stage.capacity},
+                    {"processed", stage.processed},
+                    {"dropped", stage.dropped},
+                    {"busy_seconds", stage.busy_seconds},
+                    {"blocked_seconds", stage.blocked_seconds},
+                    {"utilization", stage.utilization}
+                });
+            }
             stats["thread_pool"] = {
-                {"worker_count", fetch_thread_pool_->worker_count()},
-                {"active_threads", fetch_thread_pool_->active_threads()},
-                {"pending_tasks", fetch_thread_pool_->pending_tasks()}
+                {"worker_count", fetch_pipeline_->worker_count()},
+                {"active_threads", active},
+                {"pending_tasks", queued}
             };
+            stats["pipeline"] = stages;
+            stats["fetches_in_flight"] = fetch_pipeline_->in_flight();
         }
         if (discovery_thread_pool_) {
             stats["discovery_pool"] = {
@@ -952,7 +1621,9 @@ json BackgroundFrameFetcher::get_statistics() const {
 
         {
             std::lock_guard<std::mutex> lock(discovery_mutex_);
-            stats["discovery_queue_size"] = discovery_queue_.size();
+            stats["discovery_queue_size"] = discovery_queue_.batches();
+            stats["discovery_queue_items"] = discovery_queue_.size();
+            stats["discovery_queue_stations"] = discovery_queue_.stations();
         }
     }
 
@@ -980,6 +1651,36 @@ json BackgroundFrameFetcher::get_statistics() const {
         }
         stats["station_stats"] = s_stats;
         stats["total_stations_tracked"] = station_stats_.size();
+
+        // Every station with any work done, for placing stations on nodes by cost
+        json costs = json::object();
+        for (const auto& [station, s] : station_stats_) {
+            if (s.cost.cpu_ns() > 0 || s.cost.bytes_downloaded > 0) costs[station] = cost_to_json(s.cost);
+        }
+        stats["station_costs"] = costs;
+        if (!last_bulk_discovery_.is_null()) stats["bulk_discovery"] = last_bulk_discovery_;
+    }
+
+    {
+        auto shed = degradation_.stats();
+        json seconds_at_level = json::object();
+        for (size_t i = 0; i < DegradationController::LEVEL_COUNT; ++i) {
+            seconds_at_level[DegradationController::level_name(static_cast<DegradationController::Level>(i))] = shed.seconds_at_level[i];
+        }
+        stats["degradation"] = {
+            {"level", static_cast<int>(shed.level)},
+            {"level_name", DegradationController::level_name(shed.level)},
+            {"degrades", shed.degrades},
+            {"restores", shed.restores},
+            {"seconds_at_level", seconds_at_level},
+            {"volumetric_skipped", shed.volumetric_skipped},
+            {"tilts_skipped", shed.tilts_skipped},
+            {"products_dropped", shed.products_dropped},
+            {"stale_skipped", shed.stale_skipped},
+            {"backfilled", shed.backfilled}
+        };
+        std::lock_guard<std::mutex> lock(backfill_mutex_);
+        stats["degradation"]["backfill_pending"] = backfill_.size();
     }
 
     if (storage_) {
@@ -1007,7 +1708,31 @@ void BackgroundFrameFetcher::load_config_from_disk() {
         if (data.contains("discovery_parallelism")) config_.discovery_parallelism = data["discovery_parallelism"];
         if (data.contains("buffer_pool_size")) config_.buffer_pool_size = data["buffer_pool_size"];
         if (data.contains("buffer_size")) config_.buffer_size = data["buffer_size"];
+        if (data.contains("parse_threads")) config_.parse_threads = data["parse_threads"];
+        if (data.contains("decode_min_range_meters")) config_.decode_min_range_meters = data["decode_min_range_meters"];
+        if (data.contains("decode_max_range_meters")) config_.decode_max_range_meters = data["decode_max_range_meters"];
+        if (data.contains("decode_gate_stride")) config_.decode_gate_stride = data["decode_gate_stride"];
+        if (data.contains("decode_gate_reduction")) config_.decode_gate_reduction = data["decode_gate_reduction"];
         if (data.contains("products")) config_.products = data["products"].get<std::vector<std::string>>();
+        if (data.contains("scrub_enabled")) config_.scrub_enabled = data["scrub_enabled"];
+        if (data.contains("scrub_bytes_per_second")) config_.scrub_bytes_per_second = data["scrub_bytes_per_second"];
+        if (data.contains("scrub_pass_interval_seconds")) config_.scrub_pass_interval_seconds = data["scrub_pass_interval_seconds"];
+        if (data.contains("station_weights")) config_.station_weights = data["station_weights"].get<std::map<std::string, double>>();
+        if (data.contains("base_scan_bytes")) config_.base_scan_bytes = data["base_scan_bytes"];
+        if (data.contains("base_only_stations")) config_.base_only_stations = data["base_only_stations"].get<std::set<std::string>>();
+        if (data.contains("item_deadline_seconds")) config_.item_deadline_seconds = data["item_deadline_seconds"];
+        if (data.contains("download_workers")) config_.download_workers = data["download_workers"];
+        if (data.contains("decode_workers")) config_.decode_workers = data["decode_workers"];
+        if (data.contains("store_workers")) config_.store_workers = data["store_workers"];
+        if (data.contains("pipeline_queue_size")) config_.pipeline_queue_size = data["pipeline_queue_size"];
+        if (data.contains("shed_enabled")) config_.shed_enabled = data["shed_enabled"];
+        if (data.contains("shed_degrade_wait_seconds")) config_.shed_degrade_wait_seconds = data["shed_degrade_wait_seconds"];
+        if (data.contains("shed_restore_wait_seconds")) config_.shed_restore_wait_seconds = data["shed_restore_wait_seconds"];
+        if (data.contains("shed_degrade_backlog")) config_.shed_degrade_backlog = data["shed_degrade_backlog"];
+        if (data.contains("shed_restore_backlog")) config_.shed_restore_backlog = data["shed_restore_backlog"];
+        if (data.contains("shed_hold_seconds")) config_.shed_hold_seconds = data["shed_hold_seconds"];
+        if (data.contains("shed_max_tilts")) config_.shed_max_tilts = data["shed_max_tilts"];
+        if (data.contains("shed_priority_products")) config_.shed_priority_products = data["shed_priority_products"].get<std::vector<std::string>>();
         this->log_info("Loaded configuration from " + path);
     } catch (...) {}
 }
@@ -1028,7 +1753,31 @@ void BackgroundFrameFetcher::save_config_to_disk() const {
         data["discovery_parallelism"] = config_.discovery_parallelism;
         data["buffer_pool_size"] = config_.buffer_pool_size;
         data["buffer_size"] = config_.buffer_size;
+        data["parse_threads"] = config_.parse_threads;
+        data["decode_min_range_meters"] = config_.decode_min_range_meters;
+        data["decode_max_range_meters"] = config_.decode_max_range_meters;
+        data["decode_gate_stride"] = config_.decode_gate_stride;
+        data["decode_gate_reduction"] = config_.decode_gate_reduction;
         data["products"] = config_.products;
+        data["scrub_enabled"] = config_.scrub_enabled;
+        data["scrub_bytes_per_second"] = config_.scrub_bytes_per_second;
+        data["scrub_pass_interval_seconds"] = config_.scrub_pass_interval_seconds;
+        data["station_weights"] = config_.station_weights;
+        data["base_scan_bytes"] = config_.base_scan_bytes;
+        data["base_only_stations"] = config_.base_only_stations;
+        data["item_deadline_seconds"] = config_.item_deadline_seconds;
+        data["download_workers"] = config_.download_workers;
+        data["decode_workers"] = config_.decode_workers;
+        data["store_workers"] = config_.store_workers;
+        data["pipeline_queue_size"] = config_.pipeline_queue_size;
+        data["shed_enabled"] = config_.shed_enabled;
+        data["shed_degrade_wait_seconds"] = config_.shed_degrade_wait_seconds;
+        data["shed_restore_wait_seconds"] = config_.shed_restore_wait_seconds;
+        data["shed_degrade_backlog"] = config_.shed_degrade_backlog;
+        data["shed_restore_backlog"] = config_.shed_restore_backlog;
+        data["shed_hold_seconds"] = config_.shed_hold_seconds;
+        data["shed_max_tilts"] = config_.shed_max_tilts;
+        data["shed_priority_products"] = config_.shed_priority_products;
     }
     f << data.dump(4);
 }
@@ -0,0 +1,231 @@
+/**
+ * BitmaskCodec.cpp - Implementation
+ */
+
+#include "levelii/BitmaskCodec.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <tmmintrin.h>
+#define LEVELII_HAVE_SSSE3_EXPAND 1
+#endif
+
+namespace {
+    /**
+     * For every bitmask byte, the value each of its eight cells (MSB first)
+     * takes: the rank of the bit among the byte's set bits, or 0x80 for a
+     * clear bit, which pshufb turns into a zero byte.
+     */
+    struct ShuffleTables {
+        alignas(16) uint8_t index[256][8];
+        uint8_t count[256];
+
+        ShuffleTables() {
+            for (int m = 0; m < 256; ++m) {
+                uint8_t rank = 0;
+                for (int j = 0; j < 8; ++j) {
+                    index[m][j] = (m & (0x80 >> j)) ? rank++ : 0x80;
+                }
+                count[m] = rank;
+            }
+        }
+    };
+
+    const ShuffleTables& tables() {
+        static const ShuffleTables instance;
+        return instance;
+    }
+
+    // Maps a level to the output type; level 0 is the empty cell
+    struct Levels {
+        uint8_t operator()(uint8_t level) const { return level; }
+    };
+
+    struct Dequantize {
+        const float* table;
+        float operator()(uint8_t level) const { return table[level]; }
+    };
+
+    /**
+     * Shared walk over the bitmask: single bits up to a byte boundary, then
+     * whole bytes through `byte8` while eight values can be read, runs of
+     * eight empty bytes as one fill, and single bits again for the tail.
+     */
+    template <typename Out, typename Map, typename Byte8>
+    __attribute__((always_inline)) inline size_t walk(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values,
+                                                      size_t value_count, Out* out, Map map, Byte8 byte8) {
+        const ShuffleTables& t = tables();
+        const Out empty = map(0);
+        size_t v = 0;
+        size_t i = 0;
+        auto single = [&](size_t bit) {
+            bool set = bitmask[bit >> 3] & (0x80 >> (bit & 7));
+            out[i] = (set && v < value_count) ? map(values[v++]) : empty;
+        };
+
+        for (; i < cells && ((first_bit + i) & 7); ++i) single(first_bit + i);
+        const uint8_t* mask = bitmask + ((first_bit + i) >> 3);
+        while (cells - i >= 8) {
+            if (cells - i >= 64) {
+                uint64_t word;
+                std::memcpy(&word, mask, 8);
+                if (word == 0) {
+                    std::fill_n(out + i, 64, empty);
+                    mask += 8;
+                    i += 64;
+                    continue;
+                }
+            }
+            const uint8_t m = *mask;
+            if (m == 0) {
+                std::fill_n(out + i, 8, empty);
+            } else {
+                if (v + 8 > value_count) break;
+                byte8(t.index[m], values + v, out + i);
+                v += t.count[m];
+            }
+            ++mask;
+            i += 8;
+        }
+        for (; i < cells; ++i) single(first_bit + i);
+        return v;
+    }
+
+    struct ScalarLevels {
+        void operator()(const uint8_t* index, const uint8_t* src, uint8_t* dst) const {
+            for (int j = 0; j < 8; ++j) dst[j] = (index[j] & 0x80) ? 0 : src[index[j]];
+        }
+    };
+
+    struct ScalarDequantize {
+        const float* table;
+        void operator()(const uint8_t* index, const uint8_t* src, float* dst) const {
+            for (int j = 0; j < 8; ++j) dst[j] = table[(index[j] & 0x80) ? 0 : src[index[j]]];
+        }
+    };
+
+    size_t expand_levels_sw(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count, uint8_t* out) {
+        return walk(bitmask, first_bit, cells, values, value_count, out, Levels{}, ScalarLevels{});
+    }
+
+    size_t expand_values_sw(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count,
+                            const float* table, float* out) {
+        return walk(bitmask, first_bit, cells, values, value_count, out, Dequantize{table}, ScalarDequantize{table});
+    }
+
+#ifdef LEVELII_HAVE_SSSE3_EXPAND
+    struct ShuffleLevels {
+        __attribute__((target("ssse3"))) inline void operator()(const uint8_t* index, const uint8_t* src, uint8_t* dst) const {
+            __m128i vals = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+            __m128i idx = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(index));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(vals, idx));
+        }
+    };
+
+    struct ShuffleDequantize {
+        const float* table;
+        __attribute__((target("ssse3"))) inline void operator()(const uint8_t* index, const uint8_t* src, float* dst) const {
+            alignas(8) uint8_t levels[8];
+            __m128i vals = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+            __m128i idx = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(index));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(levels), _mm_shuffle_epi8(vals, idx));
+            for (int j = 0; j < 8; ++j) dst[j] = table[levels[j]];
+        }
+    };
+
+    // flatten inlines walk and the shuffle, so the whole loop is compiled for SSSE3
+    __attribute__((target("ssse3"), flatten))
+    size_t expand_levels_hw(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count, uint8_t* out) {
+        return walk(bitmask, first_bit, cells, values, value_count, out, Levels{}, ShuffleLevels{});
+    }
+
+    __attribute__((target("ssse3"), flatten))
+    size_t expand_values_hw(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count,
+                            const float* table, float* out) {
+        return walk(bitmask, first_bit, cells, values, value_count, out, Dequantize{table}, ShuffleDequantize{table});
+    }
+#endif
+
+    using ExpandLevels = size_t (*)(const uint8_t*, size_t, size_t, const uint8_t*, size_t, uint8_t*);
+    using ExpandValues = size_t (*)(const uint8_t*, size_t, size_t, const uint8_t*, size_t, const float*, float*);
+
+    struct Impl {
+        ExpandLevels levels = expand_levels_sw;
+        ExpandValues values = expand_values_sw;
+
+        Impl() {
+#ifdef LEVELII_HAVE_SSSE3_EXPAND
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("ssse3")) {
+                levels = expand_levels_hw;
+                values = expand_values_hw;
+            }
+#endif
+        }
+    };
+
+    const Impl& impl() {
+        static const Impl selected;
+        return selected;
+    }
+}
+
+namespace BitmaskCodec {
+
+DequantTable dequant_table(float value_min, float value_max, float empty) {
+    DequantTable table;
+    table.value[0] = empty;
+    for (int v = 1; v < 256; ++v) {
+        table.value[v] = value_min + (v / 255.0f) * (value_max - value_min);
+    }
+    return table;
+}
+
+size_t expand(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count, uint8_t* out) {
+    return impl().levels(bitmask, first_bit, cells, values, value_count, out);
+}
+
+size_t expand(const uint8_t* bitmask, size_t first_bit, size_t cells, const uint8_t* values, size_t value_count,
+              const DequantTable& table, float* out) {
+    return impl().values(bitmask, first_bit, cells, values, value_count, table.value, out);
+}
+
+bool simd_accelerated() {
+    return impl().levels != expand_levels_sw;
+}
+
+RankIndex::RankIndex(const uint8_t* bitmask, size_t bits) : bitmask_(bitmask), bits_(bits) {
+    const size_t words = (bits + 63) / 64;
+    superblocks_.reserve(words / 8 + 1);
+    for (size_t w = 0; w < words; ++w) {
+        if (w % 8 == 0) superblocks_.push_back(static_cast<uint32_t>(ones_));
+        ones_ += __builtin_popcountll(word(w));
+    }
+    // Bits past the end of the last byte are not part of the grid
+    if (bits % 8) ones_ -= __builtin_popcountll(word(words - 1) & ((uint64_t{1} << (64 - bits % 64)) - 1));
+}
+
+// 64 bits starting at bit index * 64, MSB first like the mask; bytes past the end read as zero
+uint64_t RankIndex::word(size_t index) const {
+    const size_t begin = index * 8;
+    const size_t bytes = (bits_ + 7) / 8;
+    uint64_t w = 0;
+    if (begin + 8 <= bytes) {
+        std::memcpy(&w, bitmask_ + begin, 8);
+    } else {
+        std::memcpy(&w, bitmask_ + begin, bytes - begin);
+    }
+    return __builtin_bswap64(w);
+}
+
+size_t RankIndex::rank(size_t bit) const {
+    if (bit >= bits_) return ones_;
+    const size_t target = bit / 64;
+    size_t count = superblocks_[bit / SUPERBLOCK_BITS];
+    for (size_t w = bit / SUPERBLOCK_BITS * 8; w < target; ++w) count += __builtin_popcountll(word(w));
+    if (bit % 64) count += __builtin_popcountll(word(target) >> (64 - bit % 64));
+    return count;
+}
+
+} // namespace BitmaskCodec
@@ -0,0 +1,90 @@
+/**
+ * BulkDiscovery.cpp - Implementation
+ */
+
+#include "levelii/BulkDiscovery.h"
+#include <algorithm>
+
+namespace {
+    // "YYYY/MM/DD/"
+    const size_t DAY_PREFIX_SIZE = 11;
+
+    /**
+     * Where a listing positioned at `cursor` can continue without missing
+     * anything: past the station's mark when the mark is in this prefix, past
+     * the whole station when the mark is in a later day.
+     */
+    std::string seek(const std::string& prefix, const std::string& cursor, const std::map<std::string, std::string>& marks) {
+        std::string station = BulkDiscovery::station_of(cursor);
+        if (station.empty()) return cursor;
+        auto it = marks.find(station);
+        if (it == marks.end() || it->second.empty()) return cursor;
+        const std::string& mark = it->second;
+        if (mark.compare(0, prefix.size(), prefix) == 0) return std::max(cursor, mark);
+        // '0' sorts right after '/', so this is after every key of the station and before the next one
+        if (mark > prefix) return std::max(cursor, prefix + station + "0");
+        return cursor;
+    }
+}
+
+namespace BulkDiscovery {
+
+std::string station_of(const std::string& key) {
+    if (key.size() <= DAY_PREFIX_SIZE || key[DAY_PREFIX_SIZE - 1] != '/') return "";
+    size_t end = key.find('/', DAY_PREFIX_SIZE);
+    return key.substr(DAY_PREFIX_SIZE, end == std::string::npos ? std::string::npos : end - DAY_PREFIX_SIZE);
+}
+
+std::vector<Range> partition(const std::string& prefix, const std::map<std::string, std::string>& marks, size_t count) {
+    std::vector<std::string> stations;
+    for (const auto& [station, mark] : marks) {
+        if (!mark.empty()) stations.push_back(station);
+    }
+    count = std::max<size_t>(1, std::min(count, stations.size()));
+
+    std::vector<Range> ranges(count);
+    for (size_t i = 1; i < count; ++i) {
+        const std::string& first = stations[i * stations.size() / count];
+        ranges[i - 1].end = prefix + first + "/";
+        ranges[i].start_after = prefix + first;
+    }
+    return ranges;
+}
+
+void scan(const std::string& prefix, const Range& range, const std::map<std::string, std::string>& marks, const ListPage& list,
+          Result& result, const std::function<bool()>& stopped) {
+    std::string cursor = seek(prefix, range.start_after, marks);
+    while (!(stopped && stopped())) {
+        if (!range.end.empty() && cursor >= range.end) return;
+
+        Page page;
+        ++result.requests;
+        if (!list(prefix, cursor, page)) {
+            result.complete = false;
+            return;
+        }
+        result.keys_listed += page.keys.size();
+
+        for (const auto& key : page.keys) {
+            if (!range.end.empty() && key >= range.end) return;
+            std::string station = station_of(key);
+            if (station.empty()) continue;
+            auto it = marks.find(station);
+            if (it == marks.end() || key > it->second) result.keys[station].push_back(key);
+        }
+        if (!page.truncated || page.keys.empty()) return;
+        cursor = seek(prefix, page.keys.back(), marks);
+    }
+}
+
+void merge(Result& into, Result&& from) {
+    for (auto& [station, keys] : from.keys) {
+        auto& target = into.keys[station];
+        target.insert(target.end(), keys.begin(), keys.end());
+    }
+    into.requests += from.requests;
+    into.keys_listed += from.keys_listed;
+    into.complete = into.complete && from.complete;
+}
+
+} // namespace BulkDiscovery
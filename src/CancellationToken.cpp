@@ -0,0 +1,28 @@
+/**
+ * CancellationToken.cpp - Implementation
+ */
+
+#include "levelii/CancellationToken.h"
+#include <algorithm>
+
+CancellationToken::CancellationToken() : state_(std::make_shared<State>()) {}
+
+CancellationToken CancellationToken::child(Clock::time_point deadline) const {
+    auto state = std::make_shared<State>();
+    // Inherited deadlines fold into one, so a check reads the clock at most once
+    state->deadline = std::min(deadline, state_->deadline);
+    state->parent = state_;
+    return CancellationToken(std::move(state));
+}
+
+void CancellationToken::cancel() const {
+    state_->cancelled.store(true, std::memory_order_relaxed);
+}
+
+CancellationToken::Reason CancellationToken::reason() const {
+    for (const State* state = state_.get(); state; state = state->parent.get()) {
+        if (state->cancelled.load(std::memory_order_relaxed)) return Reason::Cancelled;
+    }
+    if (state_->deadline != Clock::time_point::max() && Clock::now() >= state_->deadline) return Reason::DeadlineExceeded;
+    return Reason::None;
+}
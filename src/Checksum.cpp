@@ -0,0 +1,103 @@
+/**
+ * Checksum.cpp - Implementation
+ */
+
+#include "levelii/Checksum.h"
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define LEVELII_HAVE_SSE42_CRC 1
+#endif
+
+namespace {
+    constexpr uint32_t CRC32C_POLY = 0x82F63B78u; // Reflected Castagnoli polynomial
+
+    struct Crc32cTables {
+        uint32_t t[8][256];
+
+        Crc32cTables() {
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t crc = i;
+                for (int k = 0; k < 8; ++k) {
+                    crc = (crc >> 1) ^ ((crc & 1) ? CRC32C_POLY : 0);
+                }
+                t[0][i] = crc;
+            }
+            for (uint32_t i = 0; i < 256; ++i) {
+                for (int s = 1; s < 8; ++s) {
+                    t[s][i] = (t[s - 1][i] >> 8) ^ t[0][t[s - 1][i] & 0xFF];
+                }
+            }
+        }
+    };
+
+    const Crc32cTables& tables() {
+        static const Crc32cTables instance;
+        return instance;
+    }
+
+    uint32_t crc32c_sw(uint32_t crc, const uint8_t* p, size_t n) {
+        const auto& t = tables().t;
+        while (n >= 8) {
+            uint32_t lo, hi;
+            std::memcpy(&lo, p, 4);
+            std::memcpy(&hi, p + 4, 4);
+            lo ^= crc;
+            crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+                  t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+            p += 8;
+            n -= 8;
+        }
+        while (n--) {
+            crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF];
+        }
+        return crc;
+    }
+
+#ifdef LEVELII_HAVE_SSE42_CRC
+    __attribute__((target("sse4.2")))
+    uint32_t crc32c_hw(uint32_t crc, const uint8_t* p, size_t n) {
+        uint64_t c = crc;
+        while (n >= 8) {
+            uint64_t v;
+            std::memcpy(&v, p, 8);
+            c = _mm_crc32_u64(c, v);
+            p += 8;
+            n -= 8;
+        }
+        uint32_t c32 = static_cast<uint32_t>(c);
+        while (n--) {
+            c32 = _mm_crc32_u8(c32, *p++);
+        }
+        return c32;
+    }
+#endif
+
+    using Crc32cImpl = uint32_t (*)(uint32_t, const uint8_t*, size_t);
+
+    Crc32cImpl select_impl() {
+#ifdef LEVELII_HAVE_SSE42_CRC
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("sse4.2")) return crc32c_hw;
+#endif
+        return crc32c_sw;
+    }
+
+    Crc32cImpl impl() {
+        static const Crc32cImpl selected = select_impl();
+        return selected;
+    }
+}
+
+namespace Checksum {
+
+uint32_t crc32c(const uint8_t* data, size_t size, uint32_t crc) {
+    return ~impl()(~crc, data, size);
+}
+
+bool crc32c_hardware_accelerated() {
+    return impl() != crc32c_sw;
+}
+
+} // namespace Checksum
@@ -37,6 +37,7 @@ void SQLiteDatabase::initialize_schema() {
         "    product_name TEXT,"
         "    timestamp TEXT,"
         "    filename TEXT,"
+        "    crc32c INTEGER,"
         "    PRIMARY KEY (station, product_name, timestamp, filename)"
         ");"
         "CREATE INDEX IF NOT EXISTS idx_levelii_station_product ON levelii_frames (station, product_name);"
@@ -45,6 +46,18 @@ void SQLiteDatabase::initialize_schema() {
     if (!execute(sql)) {
         std::cerr << "Failed to initialize SQLite schema" << std::endl;
     }
+
+    // Databases created before checksums were recorded lack the crc32c column
+    bool has_crc = false;
+    for (const auto& column : query("PRAGMA table_info(levelii_frames);")) {
+        if (column.value("name", "") == "crc32c") {
+            has_crc = true;
+            break;
+        }
+    }
+    if (!has_crc) {
+        execute("ALTER TABLE levelii_frames ADD COLUMN crc32c INTEGER;");
+    }
 }
 
 bool SQLiteDatabase::execute(const std::string& sql) {
@@ -64,12 +77,16 @@ bool SQLiteDatabase::insert_frame(const std::string& table,
                                 int product_code,
                                 const std::string& product_name,
                                 const std::string& timestamp,
-                                const std::string& filename) {
+                                const std::string& filename,
+                                int64_t crc32c) {
     std::lock_guard<std::mutex> lock(db_mutex_);
     sqlite3_stmt* stmt;
-    std::string sql = "INSERT OR REPLACE INTO " + table + 
-                     " (station, product_code, product_name, timestamp, filename) "
-                     "VALUES (?, ?, ?, ?, ?);";
+    // An upsert rather than INSERT OR REPLACE: the row keeps its rowid, which the scrubber walks in order
+    std::string sql = "INSERT INTO " + table + 
+                     " (station, product_code, product_name, timestamp, filename, crc32c) "
+                     "VALUES (?, ?, ?, ?, ?, ?) "
+                     "ON CONFLICT (station, product_name, timestamp, filename) DO UPDATE SET "
+                     "product_code = excluded.product_code, crc32c = excluded.crc32c;";
 
     int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
     if (rc != SQLITE_OK) {
@@ -82,6 +99,11 @@ bool SQLiteDatabase::insert_frame(const std::string& table,
     sqlite3_bind_text(stmt, 3, product_name.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 4, timestamp.c_str(), -1, SQLITE_TRANSIENT);
     sqlite3_bind_text(stmt, 5, filename.c_str(), -1, SQLITE_TRANSIENT);
+    if (crc32c >= 0) {
+        sqlite3_bind_int64(stmt, 6, crc32c);
+    } else {
+        sqlite3_bind_null(stmt, 6);
+    }
 
     rc = sqlite3_step(stmt);
     if (rc != SQLITE_DONE) {
@@ -97,14 +119,97 @@ bool SQLiteDatabase::insert_frame(const std::string& table,
 nlohmann::json SQLiteDatabase::query(const std::string& sql) {
     std::lock_guard<std::mutex> lock(db_mutex_);
     sqlite3_stmt* stmt;
-    nlohmann::json results = nlohmann::json::array();
 
     int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
     if (rc != SQLITE_OK) {
         std::cerr << "Failed to prepare query: " << sqlite3_errmsg(db_) << std::endl;
-        return results;
+        return nlohmann::json::array();
+    }
+
+    nlohmann::json results = collect_rows(stmt);
+    sqlite3_finalize(stmt);
+    return results;
+}
+
+bool SQLiteDatabase::execute_params(const std::string& sql, const std::vector<std::string>& params) {
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    sqlite3_stmt* stmt;
+
+    int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        std::cerr << "Failed to prepare statement: " << sqlite3_errmsg(db_) << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < params.size(); ++i) {
+        sqlite3_bind_text(stmt, static_cast<int>(i + 1), params[i].c_str(), -1, SQLITE_TRANSIENT);
+    }
+
+    rc = sqlite3_step(stmt);
+    if (rc != SQLITE_DONE) {
+        std::cerr << "Execution failed: " << sqlite3_errmsg(db_) << std::endl;
+        sqlite3_finalize(stmt);
+        return false;
+    }
+
+    sqlite3_finalize(stmt);
+    return true;
+}
+
+bool SQLiteDatabase::execute_transaction(const std::vector<std::pair<std::string, std::vector<std::string>>>& statements) {
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    if (sqlite3_exec(db_, "BEGIN IMMEDIATE;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to begin transaction: " << sqlite3_errmsg(db_) << std::endl;
+        return false;
+    }
+
+    for (const auto& [sql, params] : statements) {
+        sqlite3_stmt* stmt;
+        int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+        if (rc == SQLITE_OK) {
+            for (size_t i = 0; i < params.size(); ++i) {
+                sqlite3_bind_text(stmt, static_cast<int>(i + 1), params[i].c_str(), -1, SQLITE_TRANSIENT);
+            }
+            rc = sqlite3_step(stmt);
+            sqlite3_finalize(stmt);
+        }
+        if (rc != SQLITE_DONE) {
+            std::cerr << "Transaction failed: " << sqlite3_errmsg(db_) << " (SQL: " << sql << ")" << std::endl;
+            sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+            return false;
+        }
+    }
+
+    if (sqlite3_exec(db_, "COMMIT;", nullptr, nullptr, nullptr) != SQLITE_OK) {
+        std::cerr << "Failed to commit transaction: " << sqlite3_errmsg(db_) << std::endl;
+        sqlite3_exec(db_, "ROLLBACK;", nullptr, nullptr, nullptr);
+        return false;
+    }
+    return true;
+}
+
+nlohmann::json SQLiteDatabase::query_params(const std::string& sql, const std::vector<std::string>& params) {
+    std::lock_guard<std::mutex> lock(db_mutex_);
+    sqlite3_stmt* stmt;
+
+    int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
+    if (rc != SQLITE_OK) {
+        std::cerr << "Failed to prepare query: " << sqlite3_errmsg(db_) << std::endl;
+        return nlohmann::json::array();
+    }
+
+    for (size_t i = 0; i < params.size(); ++i) {
+        sqlite3_bind_text(stmt, static_cast<int>(i + 1), params[i].c_str(), -1, SQLITE_TRANSIENT);
     }
 
+    nlohmann::json results = collect_rows(stmt);
+    sqlite3_finalize(stmt);
+    return results;
+}
+
+nlohmann::json SQLiteDatabase::collect_rows(sqlite3_stmt* stmt) {
+    nlohmann::json results = nlohmann::json::array();
+
     int col_count = sqlite3_column_count(stmt);
     while (sqlite3_step(stmt) == SQLITE_ROW) {
         nlohmann::json row;
@@ -113,7 +218,7 @@ nlohmann::json SQLiteDatabase::query(const std::string& sql) {
             int col_type = sqlite3_column_type(stmt, i);
 
             if (col_type == SQLITE_INTEGER) {
-                row[col_name] = sqlite3_column_int(stmt, i);
+                row[col_name] = sqlite3_column_int64(stmt, i);
             } else if (col_type == SQLITE_FLOAT) {
                 row[col_name] = sqlite3_column_double(stmt, i);
             } else if (col_type == SQLITE_TEXT) {
@@ -124,8 +229,6 @@ nlohmann::json SQLiteDatabase::query(const std::string& sql) {
         }
         results.push_back(row);
     }
-
-    sqlite3_finalize(stmt);
     return results;
 }
 
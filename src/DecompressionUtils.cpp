@@ -4,11 +4,18 @@
  */
 
 #include "levelii/DecompressionUtils.h"
+#include "levelii/ParallelFor.h"
+#include "levelii/ContextPool.h"
 #include <bzlib.h>
 #include <iostream>
 #include <cstring>
+#include <cstdlib>
 #include <limits>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <new>
 
 namespace RadarDecompression {
 
@@ -17,11 +24,88 @@ namespace {
 // Enable verbose logging for decompression
 constexpr bool VERBOSE_LOGGING = false;
 
+std::atomic<uint64_t> bz2_arena_allocations_total{0};
+
+// ============================================================================
+// Pooled bzip2 decoder memory
+// ============================================================================
+// With small=0 every BZ2_bzDecompressInit asks for the same buffers: the ~64 KB
+// decoder state, then up to 3.6 MB of block tables. An arena keeps them after
+// BZ2_bzDecompressEnd, so later streams decoded through it allocate nothing.
+class Bz2Arena {
+public:
+    // A bz_stream whose allocations are served by this arena
+    bz_stream make_stream() {
+        bz_stream stream{};
+        stream.bzalloc = &Bz2Arena::allocate;
+        stream.bzfree = &Bz2Arena::release;
+        stream.opaque = this;
+        return stream;
+    }
+
+private:
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+        bool used = false;
+    };
+
+    static void* allocate(void* opaque, int items, int size) {
+        return static_cast<Bz2Arena*>(opaque)->take(static_cast<size_t>(items) * static_cast<size_t>(size));
+    }
+
+    static void release(void* opaque, void* ptr) {
+        static_cast<Bz2Arena*>(opaque)->give_back(ptr);
+    }
+
+    void* take(size_t bytes) {
+        Block* best = nullptr;
+        for (auto& block : blocks_) {
+            if (!block.used && block.size >= bytes && (!best || block.size < best->size)) best = &block;
+        }
+        if (!best) {
+            // Regrow an idle block that is too small (a stream with a larger block size) rather than keep both
+            for (auto& block : blocks_) {
+                if (!block.used) {
+                    best = &block;
+                    break;
+                }
+            }
+            if (!best) {
+                blocks_.emplace_back();
+                best = &blocks_.back();
+            }
+            best->data.reset(new (std::nothrow) char[bytes]);
+            best->size = best->data ? bytes : 0;
+            if (!best->data) return nullptr;
+            bz2_arena_allocations_total++;
+        }
+        best->used = true;
+        return best->data.get();
+    }
+
+    void give_back(void* ptr) {
+        for (auto& block : blocks_) {
+            if (block.data.get() == ptr) {
+                block.used = false;
+                return;
+            }
+        }
+    }
+
+    std::vector<Block> blocks_;
+};
+
+levelii::ContextPool<Bz2Arena>& bz2_arenas() {
+    static levelii::ContextPool<Bz2Arena> pool;
+    return pool;
+}
+
 // ============================================================================
 // Decompress bzip2 data (ULTRA-OPTIMIZED - TARGET: <100ms)
 // ============================================================================
-bool decompress_bz2_raw(const uint8_t* data, size_t size, 
-                        std::vector<uint8_t>& decompressed) {
+bool decompress_bz2_stream(const uint8_t* data, size_t size,
+                           std::vector<uint8_t>& decompressed) {
     decompressed.clear();
     if (size == 0) return false;
     
@@ -32,10 +116,8 @@ bool decompress_bz2_raw(const uint8_t* data, size_t size,
     size_t initial_guess = std::min(size * 8, MAX_INITIAL_ALLOC);
     decompressed.resize(initial_guess);
     
-    bz_stream stream;
-    stream.bzalloc = nullptr;
-    stream.bzfree = nullptr;
-    stream.opaque = nullptr;
+    auto arena = bz2_arenas().acquire();
+    bz_stream stream = arena->make_stream();
     stream.avail_in = size;
     stream.next_in = const_cast<char*>(reinterpret_cast<const char*>(data));
     stream.avail_out = decompressed.size();
@@ -85,9 +167,166 @@ bool decompress_bz2_raw(const uint8_t* data, size_t size,
     }
 }
 
+// ============================================================================
+// Parallel bzip2: split one stream at its block boundaries
+// ============================================================================
+// A stream is "BZh<level>", then blocks that each open with the 48-bit magic
+// 0x314159265359 and the block CRC, then 0x177245385090 and the combined CRC.
+// Blocks sit at arbitrary bit offsets but are otherwise independent, so each
+// one is re-wrapped as a one-block stream and decoded on its own; libbz2 checks
+// the block CRC and the combined CRC is recomputed here.
+
+constexpr uint64_t BZ2_BLOCK_MAGIC = 0x314159265359ULL;
+constexpr uint64_t BZ2_EOS_MAGIC = 0x177245385090ULL;
+constexpr size_t BZ2_STREAM_HEADER_SIZE = 4;
+
+// `n` <= 57 bits starting at bit `pos`, most significant first; bytes past the end read as 0
+uint64_t read_bits(const uint8_t* data, size_t size, uint64_t pos, unsigned n) {
+    uint64_t value = 0;
+    size_t byte = pos / 8;
+    for (size_t i = 0; i < 8; ++i) value = (value << 8) | (byte + i < size ? data[byte + i] : 0);
+    return (value << (pos % 8)) >> (64 - n);
+}
+
+struct Bz2Layout {
+    std::vector<uint64_t> block_bits;  // Bit offset of each block magic
+    uint64_t end_bits = 0;             // Bit offset of the end-of-stream magic
+    uint32_t stream_crc = 0;
+};
+
+/**
+ * Locate the blocks of the first stream in `data`. For a magic starting at bit
+ * 8*(q-1)+s, byte q lies wholly inside it, so a 256-entry table of the shifts
+ * each byte value could belong to leaves ~1 in 30 positions for a full compare.
+ */
+bool find_bz2_blocks(const uint8_t* data, size_t size, Bz2Layout& layout) {
+    static const std::array<uint16_t, 256> shifts_for_byte = [] {
+        std::array<uint16_t, 256> table{};
+        for (unsigned s = 0; s < 8; ++s) {
+            table[(BZ2_BLOCK_MAGIC >> (32 + s)) & 0xFF] |= 1u << s;
+            table[(BZ2_EOS_MAGIC >> (32 + s)) & 0xFF] |= 1u << (8 + s);
+        }
+        return table;
+    }();
+
+    if (size < BZ2_STREAM_HEADER_SIZE + 10 || data[0] != 'B' || data[1] != 'Z' || data[2] != 'h' ||
+        data[3] < '1' || data[3] > '9') {
+        return false;
+    }
+    const uint64_t total_bits = static_cast<uint64_t>(size) * 8;
+    for (size_t q = BZ2_STREAM_HEADER_SIZE + 1; q < size; ++q) {
+        uint16_t shifts = shifts_for_byte[data[q]];
+        if (!shifts) continue;
+        for (unsigned s = 0; s < 8; ++s) {
+            bool block = shifts & (1u << s);
+            bool eos = shifts & (1u << (8 + s));
+            if (!block && !eos) continue;
+            uint64_t pos = static_cast<uint64_t>(q - 1) * 8 + s;
+            if (pos + 48 + 32 > total_bits) return false;
+            uint64_t magic = read_bits(data, size, pos, 48);
+            if (block && magic == BZ2_BLOCK_MAGIC) {
+                layout.block_bits.push_back(pos);
+            } else if (eos && magic == BZ2_EOS_MAGIC) {
+                layout.end_bits = pos;
+                layout.stream_crc = static_cast<uint32_t>(read_bits(data, size, pos + 48, 32));
+                return !layout.block_bits.empty() && layout.block_bits[0] == BZ2_STREAM_HEADER_SIZE * 8;
+            }
+        }
+    }
+    return false;
+}
+
+// Bits [begin, end) of `data` as a complete one-block stream with the given block CRC
+std::vector<uint8_t> standalone_block(const uint8_t* data, size_t size, uint64_t begin, uint64_t end, uint32_t block_crc) {
+    const uint64_t bits = end - begin;
+    const size_t whole_bytes = bits / 8;
+    std::vector<uint8_t> out(data, data + BZ2_STREAM_HEADER_SIZE);
+    out.reserve(BZ2_STREAM_HEADER_SIZE + whole_bytes + 12);
+
+    const size_t first = begin / 8;
+    const unsigned shift = begin % 8;
+    if (shift == 0) {
+        out.insert(out.end(), data + first, data + first + whole_bytes);
+    } else {
+        for (size_t i = 0; i < whole_bytes; ++i) {
+            out.push_back(static_cast<uint8_t>((data[first + i] << shift) | (data[first + i + 1] >> (8 - shift))));
+        }
+    }
+
+    // Leftover block bits, then end-of-stream magic and the combined CRC, which for one block is its own CRC
+    uint64_t acc = 0;
+    unsigned acc_bits = 0;
+    auto put = [&](uint64_t value, unsigned n) {
+        for (unsigned i = n; i-- > 0;) {
+            acc = (acc << 1) | ((value >> i) & 1);
+            if (++acc_bits == 8) {
+                out.push_back(static_cast<uint8_t>(acc));
+                acc = 0;
+                acc_bits = 0;
+            }
+        }
+    };
+    unsigned tail = bits % 8;
+    if (tail) put(read_bits(data, size, begin + whole_bytes * 8, tail), tail);
+    put(BZ2_EOS_MAGIC, 48);
+    put(block_crc, 32);
+    if (acc_bits) out.push_back(static_cast<uint8_t>(acc << (8 - acc_bits)));
+    return out;
+}
+
+/**
+ * Decode the blocks of a single stream concurrently. Returns false, leaving the
+ * caller to fall back to a sequential decode, when the stream has one block,
+ * when a block boundary was misidentified, or on any CRC failure.
+ */
+bool decompress_bz2_blocks(const uint8_t* data, size_t size, std::vector<uint8_t>& decompressed, int threads) {
+    Bz2Layout layout;
+    if (!find_bz2_blocks(data, size, layout) || layout.block_bits.size() < 2) return false;
+
+    const size_t blocks = layout.block_bits.size();
+    std::vector<std::vector<uint8_t>> outputs(blocks);
+    std::vector<uint32_t> crcs(blocks);
+    std::atomic<bool> ok{true};
+    levelii::parallel_for(blocks, threads, [&](size_t i) {
+        if (!ok) return;
+        uint64_t begin = layout.block_bits[i];
+        uint64_t end = i + 1 < blocks ? layout.block_bits[i + 1] : layout.end_bits;
+        if (end - begin < 48 + 32) {
+            ok = false;
+            return;
+        }
+        crcs[i] = static_cast<uint32_t>(read_bits(data, size, begin + 48, 32));
+        auto stream = standalone_block(data, size, begin, end, crcs[i]);
+        if (!decompress_bz2_stream(stream.data(), stream.size(), outputs[i])) ok = false;
+    });
+    if (!ok) return false;
+
+    uint32_t combined = 0;
+    size_t total = 0;
+    for (size_t i = 0; i < blocks; ++i) {
+        combined = ((combined << 1) | (combined >> 31)) ^ crcs[i];
+        total += outputs[i].size();
+    }
+    if (combined != layout.stream_crc) return false;
+
+    decompressed.resize(total);
+    size_t offset = 0;
+    for (auto& output : outputs) {
+        std::memcpy(decompressed.data() + offset, output.data(), output.size());
+        offset += output.size();
+    }
+    return true;
+}
+
+bool decompress_bz2_raw(const uint8_t* data, size_t size,
+                        std::vector<uint8_t>& decompressed, int threads) {
+    if (threads > 1 && decompress_bz2_blocks(data, size, decompressed, threads)) return true;
+    return decompress_bz2_stream(data, size, decompressed);
+}
+
 bool decompress_bz2(const std::vector<uint8_t>& compressed, 
-                    std::vector<uint8_t>& decompressed) {
-    return decompress_bz2_raw(compressed.data(), compressed.size(), decompressed);
+                    std::vector<uint8_t>& decompressed, int threads) {
+    return decompress_bz2_raw(compressed.data(), compressed.size(), decompressed, threads);
 }
 
 // ============================================================================
@@ -109,6 +348,7 @@ bool decompress_ldm(const std::vector<uint8_t>& data,
     
     size_t offset = VOLUME_HEADER_SIZE;
     int stream_count = 0;
+    auto arena = bz2_arenas().acquire();  // One set of decoder buffers serves every record
     
     // 2. Process LDM Compressed Records
     // Each record: 4-byte big-endian control word + compressed block
@@ -130,10 +370,7 @@ bool decompress_ldm(const std::vector<uint8_t>& data,
             block_size = data.size() - offset;
         }
 
-        bz_stream stream;
-        stream.bzalloc = nullptr;
-        stream.bzfree = nullptr;
-        stream.opaque = nullptr;
+        bz_stream stream = arena->make_stream();
         stream.avail_in = block_size;
         stream.next_in = const_cast<char*>(reinterpret_cast<const char*>(data.data() + offset));
         
@@ -218,8 +455,32 @@ bool decompress_ldm(const std::vector<uint8_t>& data,
 // ============================================================================
 // Auto-detect and decompress NEXRAD data
 // ============================================================================
+size_t complete_ldm_prefix(const uint8_t* data, size_t size) {
+    if (size < VOLUME_HEADER_SIZE + CONTROL_WORD_SIZE + 3 ||
+        (std::memcmp(data, "AR2V", 4) != 0 && std::memcmp(data, "ARCHIVE2", 8) != 0) ||
+        std::memcmp(data + VOLUME_HEADER_SIZE + CONTROL_WORD_SIZE, "BZh", 3) != 0) {
+        return 0;
+    }
+
+    size_t offset = VOLUME_HEADER_SIZE;
+    while (offset + CONTROL_WORD_SIZE <= size) {
+        int32_t control_word = static_cast<int32_t>((static_cast<uint32_t>(data[offset]) << 24) |
+                                                    (static_cast<uint32_t>(data[offset + 1]) << 16) |
+                                                    (static_cast<uint32_t>(data[offset + 2]) << 8) |
+                                                    static_cast<uint32_t>(data[offset + 3]));
+        size_t block_size = std::abs(static_cast<int64_t>(control_word));
+        if (block_size == 0 || block_size > size - offset - CONTROL_WORD_SIZE) break;
+        offset += CONTROL_WORD_SIZE + block_size;
+    }
+    return offset > VOLUME_HEADER_SIZE ? offset : 0;
+}
+
+uint64_t bz2_arena_allocations() {
+    return bz2_arena_allocations_total.load();
+}
+
 bool auto_decompress(const std::vector<uint8_t>& data, 
-                     std::vector<uint8_t>& decompressed) {
+                     std::vector<uint8_t>& decompressed, int threads) {
     if (data.empty()) {
         decompressed.clear();
         return false;
@@ -227,9 +488,21 @@ bool auto_decompress(const std::vector<uint8_t>& data,
     
     // Check if data is bzip2 compressed (starts with "BZ")
     if (data.size() > 2 && data[0] == 'B' && data[1] == 'Z') {
-        return decompress_bz2(data, decompressed);
+        return decompress_bz2(data, decompressed, threads);
     }
     
+    // Uncompressed Archive II: volume header followed directly by CTM/message bytes
+    // rather than a control word + bzip2 block (or a bare bzip2 stream)
+    auto bz_magic_at = [&data](size_t pos) {
+        return data.size() > pos + 2 && data[pos] == 'B' && data[pos + 1] == 'Z' && data[pos + 2] == 'h';
+    };
+    if (data.size() >= VOLUME_HEADER_SIZE + CONTROL_WORD_SIZE &&
+        (std::memcmp(data.data(), "AR2V", 4) == 0 || std::memcmp(data.data(), "ARCHIVE2", 8) == 0) &&
+        !bz_magic_at(VOLUME_HEADER_SIZE) && !bz_magic_at(VOLUME_HEADER_SIZE + CONTROL_WORD_SIZE)) {
+        decompressed = data;
+        return true;
+    }
+
     // Check for LDM compressed format
     if (data.size() >= VOLUME_HEADER_SIZE + CONTROL_WORD_SIZE) {
         // LDM format typically has AR2V magic or specific headers
@@ -240,11 +513,11 @@ bool auto_decompress(const std::vector<uint8_t>& data,
                 data[VOLUME_HEADER_SIZE] == 'B' && data[VOLUME_HEADER_SIZE+1] == 'Z') {
                 return decompress_bz2_raw(data.data() + VOLUME_HEADER_SIZE, 
                                           data.size() - VOLUME_HEADER_SIZE, 
-                                          decompressed);
+                                          decompressed, threads);
             }
             
             // Try treating as raw bzip2 even if not starting with BZ or after VolumeHeader
-            return decompress_bz2(data, decompressed);
+            return decompress_bz2(data, decompressed, threads);
         }
         return true;
     }
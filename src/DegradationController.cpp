@@ -0,0 +1,111 @@
+/**
+ * DegradationController.cpp - Implementation
+ */
+
+#include "levelii/DegradationController.h"
+
+namespace {
+    double seconds_between(DegradationController::Clock::time_point from, DegradationController::Clock::time_point to) {
+        return std::chrono::duration<double>(to - from).count();
+    }
+}
+
+DegradationController::DegradationController() : DegradationController(Config()) {}
+
+DegradationController::DegradationController(const Config& config)
+    : config_(config), changed_at_(Clock::now()) {}
+
+void DegradationController::set_config(const Config& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+DegradationController::Level DegradationController::update(double wait_seconds, size_t backlog, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!config_.enabled) {
+        if (level_ != Level::Full) set_level(Level::Full, now);
+        calm_ = false;
+        return level_;
+    }
+
+    bool overloaded = wait_seconds > config_.degrade_wait_seconds || backlog > config_.degrade_backlog;
+    bool caught_up = wait_seconds < config_.restore_wait_seconds && backlog < config_.restore_backlog;
+
+    if (overloaded) {
+        calm_ = false;
+        if (level_ != Level::LatestOnly && seconds_between(changed_at_, now) >= config_.step_seconds) {
+            set_level(static_cast<Level>(static_cast<int>(level_) + 1), now);
+            stats_.degrades++;
+        }
+    } else if (caught_up) {
+        if (!calm_) {
+            calm_ = true;
+            calm_since_ = now;
+        }
+        // Every step up needs its own quiet period
+        if (level_ != Level::Full && seconds_between(calm_since_, now) >= config_.hold_seconds) {
+            set_level(static_cast<Level>(static_cast<int>(level_) - 1), now);
+            stats_.restores++;
+            calm_since_ = now;
+        }
+    } else {
+        // Between the marks: hold the current level
+        calm_ = false;
+    }
+    return level_;
+}
+
+void DegradationController::set_level(Level level, Clock::time_point now) {
+    stats_.seconds_at_level[static_cast<size_t>(level_)] += seconds_between(changed_at_, now);
+    level_ = level;
+    changed_at_ = now;
+}
+
+DegradationController::Level DegradationController::level() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return level_;
+}
+
+void DegradationController::count_volumetric_skipped(uint64_t volumes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.volumetric_skipped += volumes;
+}
+
+void DegradationController::count_tilts_skipped(uint64_t tilts) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.tilts_skipped += tilts;
+}
+
+void DegradationController::count_products_dropped(uint64_t products) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.products_dropped += products;
+}
+
+void DegradationController::count_stale_skipped(uint64_t volumes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.stale_skipped += volumes;
+}
+
+void DegradationController::count_backfilled(uint64_t volumes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.backfilled += volumes;
+}
+
+DegradationController::Stats DegradationController::stats(Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    stats.level = level_;
+    if (now > changed_at_) stats.seconds_at_level[static_cast<size_t>(level_)] += seconds_between(changed_at_, now);
+    return stats;
+}
+
+const char* DegradationController::level_name(Level level) {
+    switch (level) {
+        case Level::Full: return "full";
+        case Level::NoVolumetric: return "no_volumetric";
+        case Level::BaseTilts: return "base_tilts";
+        case Level::PriorityProducts: return "priority_products";
+        case Level::LatestOnly: return "latest_only";
+    }
+    return "unknown";
+}
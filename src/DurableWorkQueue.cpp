@@ -0,0 +1,105 @@
+/**
+ * DurableWorkQueue.cpp - Implementation
+ */
+
+#include "levelii/DurableWorkQueue.h"
+#include <iostream>
+
+DurableWorkQueue::DurableWorkQueue(levelii::SQLiteDatabase& db, int max_attempts)
+    : db_(db), max_attempts_(max_attempts) {
+    db_.execute(
+        "CREATE TABLE IF NOT EXISTS levelii_work_queue ("
+        "    object_key TEXT PRIMARY KEY,"
+        "    station TEXT,"
+        "    bucket TEXT,"
+        "    timestamp TEXT,"
+        "    attempts INTEGER DEFAULT 0"
+        ");"
+        "CREATE TABLE IF NOT EXISTS levelii_work_sources ("
+        "    station TEXT,"
+        "    timestamp TEXT,"
+        "    bucket TEXT,"
+        "    object_key TEXT,"
+        "    PRIMARY KEY (station, timestamp)"
+        ");");
+
+    for (const auto& row : db_.query("SELECT object_key FROM levelii_work_queue;")) {
+        outstanding_.insert(row["object_key"].get<std::string>());
+    }
+}
+
+std::vector<DurableWorkQueue::Item> DurableWorkQueue::add(const std::vector<Item>& items) {
+    std::vector<Item> added;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& item : items) {
+        if (outstanding_.count(item.key)) continue;
+        if (!db_.execute_params(
+                "INSERT OR IGNORE INTO levelii_work_queue (object_key, station, bucket, timestamp) VALUES (?, ?, ?, ?);",
+                {item.key, item.station, item.bucket, item.timestamp})) {
+            // Still hand the item on: losing durability is better than losing the frame
+            std::cerr << "❌ Failed to persist work item " << item.key << std::endl;
+        }
+        outstanding_.insert(item.key);
+        added.push_back(item);
+    }
+    return added;
+}
+
+void DurableWorkQueue::ack(const std::vector<std::string>& keys) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& key : keys) {
+        if (outstanding_.erase(key)) {
+            db_.execute_transaction({
+                {"INSERT OR REPLACE INTO levelii_work_sources (station, timestamp, bucket, object_key) "
+                 "SELECT station, timestamp, bucket, object_key FROM levelii_work_queue WHERE object_key = ?;", {key}},
+                {"DELETE FROM levelii_work_queue WHERE object_key = ?;", {key}}});
+        }
+    }
+}
+
+bool DurableWorkQueue::source(const std::string& station, const std::string& timestamp, Item& out) const {
+    auto rows = db_.query_params("SELECT bucket, object_key FROM levelii_work_sources WHERE station = ? AND timestamp = ?;",
+                                 {station, timestamp});
+    if (rows.empty()) return false;
+    out = {station, rows[0]["object_key"], rows[0]["bucket"], timestamp};
+    return true;
+}
+
+bool DurableWorkQueue::retry(const std::string& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!outstanding_.count(key)) return false;
+    db_.execute_params("UPDATE levelii_work_queue SET attempts = attempts + 1 WHERE object_key = ?;", {key});
+
+    // Same budget as recover(): attempts counts deliveries after the first
+    auto rows = db_.query_params("SELECT attempts FROM levelii_work_queue WHERE object_key = ?;", {key});
+    if (!rows.empty() && rows[0]["attempts"].get<int>() <= max_attempts_) return true;
+
+    std::cerr << "❌ Dropping work item " << key << " after " << max_attempts_ << " failed attempts" << std::endl;
+    outstanding_.erase(key);
+    db_.execute_params("DELETE FROM levelii_work_queue WHERE object_key = ?;", {key});
+    return false;
+}
+
+std::vector<DurableWorkQueue::Item> DurableWorkQueue::recover() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    db_.execute("UPDATE levelii_work_queue SET attempts = attempts + 1;");
+
+    auto dropped = db_.query_params("SELECT object_key FROM levelii_work_queue WHERE attempts > ?;", {std::to_string(max_attempts_)});
+    for (const auto& row : dropped) {
+        std::string key = row["object_key"];
+        std::cerr << "❌ Dropping work item " << key << " after " << max_attempts_ << " unfinished attempts" << std::endl;
+        outstanding_.erase(key);
+    }
+    db_.execute_params("DELETE FROM levelii_work_queue WHERE attempts > ?;", {std::to_string(max_attempts_)});
+
+    std::vector<Item> items;
+    for (const auto& row : db_.query("SELECT object_key, station, bucket, timestamp FROM levelii_work_queue ORDER BY rowid ASC;")) {
+        items.push_back({row["station"], row["object_key"], row["bucket"], row["timestamp"]});
+    }
+    return items;
+}
+
+size_t DurableWorkQueue::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return outstanding_.size();
+}
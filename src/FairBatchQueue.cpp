@@ -0,0 +1,143 @@
+/**
+ * FairBatchQueue.cpp - Implementation
+ */
+
+#include "levelii/FairBatchQueue.h"
+#include <algorithm>
+
+FairBatchQueue::FairBatchQueue(size_t max_batch, size_t quantum)
+    : max_batch_(std::max<size_t>(1, max_batch)), quantum_(std::max<size_t>(1, quantum)) {}
+
+void FairBatchQueue::set_weight(const std::string& station, double weight) {
+    stations_[station].weight = weight > 0.0 ? weight : 1.0;
+}
+
+void FairBatchQueue::set_weights(const std::map<std::string, double>& weights) {
+    for (auto& [name, st] : stations_) {
+        auto it = weights.find(name);
+        st.weight = (it != weights.end() && it->second > 0.0) ? it->second : 1.0;
+    }
+    for (const auto& [name, weight] : weights) set_weight(name, weight);
+}
+
+void FairBatchQueue::push(std::vector<DiscoveryItem> items) {
+    const auto now = std::chrono::steady_clock::now();
+    for (auto& item : items) {
+        item.queued_at = now;
+        Station& st = stations_[item.station];
+        // Discovery lists keys in order, so this is almost always an append
+        auto pos = std::upper_bound(st.items.begin(), st.items.end(), item.timestamp,
+                                    [](const std::string& ts, const DiscoveryItem& queued) { return ts < queued.timestamp; });
+        std::string name = item.station;
+        st.items.insert(pos, std::move(item));
+        ++items_;
+
+        if (!st.scheduled) {
+            st.scheduled = true;
+            round_.push_back(name);
+        }
+        if (!st.fresh && st.items.back().timestamp > st.newest_dispatched) {
+            st.fresh = true;
+            fresh_.push_back(name);
+        }
+    }
+}
+
+bool FairBatchQueue::pop_fresh(DiscoveryBatch& batch) {
+    while (!fresh_.empty()) {
+        std::string name = std::move(fresh_.front());
+        fresh_.pop_front();
+        Station& st = stations_[name];
+        st.fresh = false;
+        // Already handed out by the round robin since it was marked
+        if (st.items.empty() || st.items.back().timestamp <= st.newest_dispatched) continue;
+
+        st.newest_dispatched = st.items.back().timestamp;
+        batch.station = name;
+        batch.items.clear();
+        batch.items.push_back(std::move(st.items.back()));
+        st.items.pop_back();
+        --items_;
+        return true;
+    }
+    return false;
+}
+
+bool FairBatchQueue::pop(DiscoveryBatch& batch) {
+    if (pop_fresh(batch)) return true;
+
+    while (!round_.empty()) {
+        const std::string name = round_.front();
+        Station& st = stations_[name];
+        if (st.items.empty()) {
+            st.scheduled = false;
+            st.deficit = 0.0;
+            round_.pop_front();
+            continue;
+        }
+
+        // A turn starts with fresh credit and may span several batches
+        if (st.deficit < 1.0) st.deficit += static_cast<double>(quantum_) * st.weight;
+        size_t count = std::min({max_batch_, st.items.size(), static_cast<size_t>(st.deficit)});
+        if (count == 0) {
+            // Weight below 1/quantum: credit builds up over several rounds
+            round_.pop_front();
+            round_.push_back(name);
+            continue;
+        }
+
+        batch.station = name;
+        batch.items.clear();
+        for (size_t i = 0; i < count; ++i) {
+            batch.items.push_back(std::move(st.items.front()));
+            st.items.pop_front();
+        }
+        items_ -= count;
+        st.deficit -= static_cast<double>(count);
+        st.newest_dispatched = std::max(st.newest_dispatched, batch.items.back().timestamp);
+
+        if (st.items.empty()) {
+            st.scheduled = false;
+            st.deficit = 0.0;
+            round_.pop_front();
+        } else if (st.deficit < 1.0) {
+            round_.pop_front();
+            round_.push_back(name);
+        }
+        return true;
+    }
+    return false;
+}
+
+size_t FairBatchQueue::batches() const {
+    size_t total = 0;
+    for (const auto& [name, st] : stations_) total += (st.items.size() + max_batch_ - 1) / max_batch_;
+    return total;
+}
+
+size_t FairBatchQueue::stations() const {
+    size_t total = 0;
+    for (const auto& [name, st] : stations_) total += !st.items.empty();
+    return total;
+}
+
+std::string FairBatchQueue::newest(const std::string& station) const {
+    auto it = stations_.find(station);
+    if (it == stations_.end()) return "";
+    const Station& st = it->second;
+    if (!st.items.empty() && st.items.back().timestamp > st.newest_dispatched) return st.items.back().timestamp;
+    return st.newest_dispatched;
+}
+
+void FairBatchQueue::clear() {
+    for (auto& [name, st] : stations_) {
+        st.items.clear();
+        st.newest_dispatched.clear();
+        st.deficit = 0.0;
+        st.scheduled = false;
+        st.fresh = false;
+    }
+    fresh_.clear();
+    round_.clear();
+    items_ = 0;
+}
@@ -4,14 +4,25 @@
 
 #include "levelii/FrameStorageManager.h"
 #include "levelii/ZlibUtils.h"
+#include "levelii/Checksum.h"
+#include "levelii/ParallelFor.h"
+#include "levelii/BitmaskCodec.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
+#include <map>
 #include <cstring>
 #include <mutex>
+#include <ctime>
+#include <cmath>
+#include <limits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace {
     constexpr bool VERBOSE_LOGGING = false;
@@ -23,6 +34,168 @@ namespace {
     void log_error(const std::string& msg) {
         std::cerr << "❌ " << msg << std::endl;
     }
+
+    // Enough of a .RDA to read the checksum subfield from its gzip header
+    constexpr size_t CRC_HEADER_PREFIX = 64;
+
+    int64_t stored_crc(const std::vector<uint8_t>& compressed) {
+        uint32_t crc = 0;
+        if (ZlibUtils::verify_gzip_crc(compressed.data(), compressed.size(), &crc, false) != ZlibUtils::GzipCrcStatus::Valid) return -1;
+        return crc;
+    }
+
+    // An inflated .RDA is [u32 metadata size][metadata JSON][payload]; sets where the payload starts
+    bool split_frame(const uint8_t* data, size_t size, json& metadata, size_t& payload_offset, const std::string& path) {
+        if (size < 4) return false;
+        uint32_t metadata_size;
+        std::memcpy(&metadata_size, data, 4);
+        if (4 + static_cast<size_t>(metadata_size) > size) return false;
+
+        try {
+            metadata = json::parse(data + 4, data + 4 + metadata_size);
+        } catch (const std::exception& e) {
+            log_error("Failed to parse bitmask metadata in " + path + ": " + e.what());
+            return false;
+        }
+        payload_offset = 4 + metadata_size;
+        return true;
+    }
+
+    size_t count_bits(const uint8_t* mask, size_t begin, size_t end) {
+        size_t count = 0;
+        for (; begin < end && (begin & 7); ++begin) count += (mask[begin >> 3] >> (7 - (begin & 7))) & 1;
+        for (; begin + 8 <= end; begin += 8) count += __builtin_popcount(mask[begin >> 3]);
+        for (; begin < end; ++begin) count += (mask[begin >> 3] >> (7 - (begin & 7))) & 1;
+        return count;
+    }
+
+    /**
+     * Split a tilt into RAY_BLOCK-ray gzip members: every bitmask block, then
+     * every value block. Inflated back to back they are exactly [bitmask][values].
+     * The index records each member's compressed size and the value count
+     * before each block.
+     */
+    bool compress_ray_blocks(const std::vector<uint8_t>& bitmask, const std::vector<uint8_t>& values, uint16_t num_rays,
+                             uint16_t num_gates, int level, std::vector<std::vector<uint8_t>>& members, json& index) {
+        const size_t block_bytes = RAY_BLOCK * num_gates / 8;  // RAY_BLOCK is a multiple of 8, so blocks end on a byte
+        if (block_bytes == 0 || bitmask.size() != (static_cast<size_t>(num_rays) * num_gates + 7) / 8) return false;
+        const size_t blocks = (bitmask.size() + block_bytes - 1) / block_bytes;
+
+        std::vector<size_t> value_starts(blocks + 1);
+        size_t count = 0;
+        for (size_t b = 0; b < blocks; ++b) {
+            value_starts[b] = std::min(count, values.size());
+            size_t begin = b * block_bytes;
+            count += count_bits(bitmask.data() + begin, 0, std::min(block_bytes, bitmask.size() - begin) * 8);
+        }
+        value_starts[blocks] = values.size();
+
+        members.assign(2 * blocks, std::vector<uint8_t>());
+        std::vector<size_t> mask_sizes(blocks), value_sizes(blocks);
+        for (size_t b = 0; b < blocks; ++b) {
+            size_t begin = b * block_bytes;
+            members[b] = ZlibUtils::gzip_compress(bitmask.data() + begin, std::min(block_bytes, bitmask.size() - begin), level);
+            size_t value_count = value_starts[b + 1] - value_starts[b];
+            if (value_count) members[blocks + b] = ZlibUtils::gzip_compress(values.data() + value_starts[b], value_count, level);
+            if (members[b].empty() || (value_count && members[blocks + b].empty())) return false;
+            mask_sizes[b] = members[b].size();
+            value_sizes[b] = members[blocks + b].size();
+        }
+        index = {{"n", RAY_BLOCK}, {"b", mask_sizes}, {"v", value_sizes}, {"c", value_starts}};
+        return true;
+    }
+
+    // Cell count of a loaded frame (all tilts of a volumetric one); false if the payload is shorter than its bitmask
+    bool frame_cells(const json& metadata, size_t payload_size, size_t& cells) {
+        cells = static_cast<size_t>(metadata.value("r", 0)) * metadata.value("g", 0);
+        if (metadata.contains("tilts")) cells *= metadata["tilts"].size();
+        return cells > 0 && payload_size >= (cells + 7) / 8;
+    }
+
+    /**
+     * Compress one tilt: the metadata member followed by its ray blocks, or a
+     * single [metadata][bitmask][values] member when the grid cannot be blocked.
+     */
+    std::vector<uint8_t> encode_frame(json metadata, const std::vector<uint8_t>& bitmask, const std::vector<uint8_t>& values,
+                                      uint16_t num_rays, uint16_t num_gates, int level) {
+        // Ray blocks let load_frame_sector inflate part of the tilt; the whole file still inflates to the usual layout
+        std::vector<std::vector<uint8_t>> blocks;
+        json block_index;
+        bool blocked = compress_ray_blocks(bitmask, values, num_rays, num_gates, level, blocks, block_index);
+        if (blocked) metadata["ix"] = std::move(block_index);
+
+        std::string metadata_str = metadata.dump();
+        uint32_t metadata_size = metadata_str.size();
+
+        std::vector<uint8_t> uncompressed;
+        uncompressed.reserve(4 + metadata_size + (blocked ? 0 : bitmask.size() + values.size()));
+        uncompressed.insert(uncompressed.end(), reinterpret_cast<uint8_t*>(&metadata_size), reinterpret_cast<uint8_t*>(&metadata_size) + 4);
+        uncompressed.insert(uncompressed.end(), metadata_str.begin(), metadata_str.end());
+        if (!blocked) {
+            uncompressed.insert(uncompressed.end(), bitmask.begin(), bitmask.end());
+            uncompressed.insert(uncompressed.end(), values.begin(), values.end());
+        }
+
+        return blocked ? ZlibUtils::gzip_compress_members_with_crc(uncompressed.data(), uncompressed.size(), blocks, level)
+                       : ZlibUtils::gzip_compress_with_crc(uncompressed.data(), uncompressed.size(), level);
+    }
+
+    // Re-encode a stored file at another level; single tilts are re-blocked, which also indexes files older than ray blocks
+    bool recompress_frame(const std::vector<uint8_t>& compressed, int level, std::vector<uint8_t>& out, const std::string& path) {
+        std::vector<uint8_t> raw;
+        json metadata;
+        size_t payload_offset = 0;
+        if (!ZlibUtils::gzip_decompress(compressed.data(), compressed.size(), raw) ||
+            !split_frame(raw.data(), raw.size(), metadata, payload_offset, path)) {
+            return false;
+        }
+        if (metadata.contains("tilts")) {
+            out = ZlibUtils::gzip_compress_with_crc(raw.data(), raw.size(), level);
+            return !out.empty();
+        }
+
+        const uint16_t num_rays = metadata.value("r", 0);
+        const uint16_t num_gates = metadata.value("g", 0);
+        const size_t mask_bytes = (static_cast<size_t>(num_rays) * num_gates + 7) / 8;
+        if (raw.size() - payload_offset < mask_bytes) return false;
+        const auto payload = raw.begin() + payload_offset;
+        std::vector<uint8_t> bitmask(payload, payload + mask_bytes);
+        std::vector<uint8_t> values(payload + mask_bytes, raw.end());
+        metadata.erase("ix");
+        out = encode_frame(std::move(metadata), bitmask, values, num_rays, num_gates, level);
+        return !out.empty();
+    }
+
+    std::string volume_key(const std::string& station, const std::string& product, const std::string& timestamp) {
+        return station + "/" + product + "/" + timestamp;
+    }
+
+    // YYYYMMDD_HHMMSS (UTC) to seconds since the epoch; -1 if it does not parse
+    std::time_t parse_timestamp(const std::string& timestamp) {
+        std::tm tm_utc{};
+        if (std::sscanf(timestamp.c_str(), "%4d%2d%2d_%2d%2d%2d", &tm_utc.tm_year, &tm_utc.tm_mon, &tm_utc.tm_mday,
+                        &tm_utc.tm_hour, &tm_utc.tm_min, &tm_utc.tm_sec) != 6) {
+            return -1;
+        }
+        tm_utc.tm_year -= 1900;
+        tm_utc.tm_mon -= 1;
+        return timegm(&tm_utc);
+    }
+
+    // Ray under an azimuth, as the writer rounds it; not wrapped into [0, num_rays)
+    long azimuth_ray(float azimuth, size_t num_rays) {
+        return static_cast<long>(std::floor(azimuth * (num_rays / 360.0f) + 0.01f));
+    }
+
+    bool pread_all(int fd, uint8_t* out, size_t size, size_t offset = 0) {
+        size_t done = 0;
+        while (done < size) {
+            ssize_t n = ::pread(fd, out + done, size - done, static_cast<off_t>(offset + done));
+            if (n <= 0) return false;
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
 }
 
 FrameStorageManager::FrameStorageManager(const std::string& base_path)
@@ -32,6 +205,7 @@ FrameStorageManager::FrameStorageManager(const std::string& base_path)
     // Initialize SQLite database
     std::string db_path = base_path_ + "/index.db";
     db_ = std::make_unique<levelii::SQLiteDatabase>(db_path);
+    work_queue_ = std::make_unique<DurableWorkQueue>(*db_);
 
     // Initial scan to populate statistics
     size_t usage = 0;
@@ -55,7 +229,11 @@ FrameStorageManager::FrameStorageManager(const std::string& base_path)
 }
 
 FrameStorageManager::~FrameStorageManager() {
+    stop_tiering();
+    stop_scrubber();
     shutdown_async_storage();
+    // Upload callbacks write to the index, stop them before db_ goes away
+    object_sink_.reset();
 }
 
 void FrameStorageManager::enqueue_async_write(AsyncWriteTask&& task) {
@@ -76,11 +254,9 @@ void FrameStorageManager::shutdown_async_storage() {
     if (!async_storage_running_.load()) return;
     
     {
+        // Queued tasks are still written: the storage loop only exits once the queue is empty
         std::lock_guard<std::mutex> lock(write_queue_mutex_);
         async_storage_stop_.store(true);
-        while (!write_queue_.empty()) {
-            write_queue_.pop();
-        }
     }
     write_queue_cv_.notify_all();
     write_queue_full_cv_.notify_all();
@@ -150,6 +326,147 @@ bool FrameStorageManager::ensure_directory_exists(const std::string& path) const
     }
 }
 
+bool FrameStorageManager::write_frame_file(const std::string& file_path, const std::vector<uint8_t>& compressed) {
+    // Write then rename so readers and the scrubber never see a partially written file
+    std::string tmp_path = file_path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+        if (!file) return false;
+    }
+    std::error_code ec;
+    fs::rename(tmp_path, file_path, ec);
+    if (ec) {
+        fs::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+bool FrameStorageManager::read_frame_file(const std::string& file_path, CompressedFrameData& out_data) {
+    std::ifstream file(file_path, std::ios::binary);
+    if (!file) return false;
+
+    file.seekg(0, std::ios::end);
+    size_t compressed_size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> compressed(compressed_size);
+    file.read(reinterpret_cast<char*>(compressed.data()), compressed_size);
+    if (!file) return false;
+    file.close();
+
+    // Files written before checksums existed report Missing and are inflated unchecked
+    if (ZlibUtils::verify_gzip_crc(compressed.data(), compressed.size()) == ZlibUtils::GzipCrcStatus::Mismatch) {
+        log_error("Checksum mismatch in " + file_path);
+        return false;
+    }
+
+    // Inflated in place, presized from the gzip trailer; the payload is served as a view into it
+    std::vector<uint8_t>& decompressed = out_data.inflated;
+    out_data.binary_data = ByteView();
+    size_t payload_offset = 0;
+    if (!ZlibUtils::gzip_decompress(compressed.data(), compressed.size(), decompressed) ||
+        !split_frame(decompressed.data(), decompressed.size(), out_data.metadata, payload_offset, file_path)) {
+        return false;
+    }
+    out_data.binary_data = ByteView(decompressed.data() + payload_offset, decompressed.size() - payload_offset);
+    return true;
+}
+
+bool FrameStorageManager::load_volume(const std::string& station, const std::string& product, const std::string& timestamp, const std::vector<float>& tilts, VolumeData& out, int threads) const {
+    struct Slot {
+        std::string path;
+        int fd = -1;
+        std::vector<uint8_t> compressed;
+        size_t offset = 0;      // Position of this tilt's inflated file in out.inflated
+        size_t capacity = 0;    // Space reserved there, from the gzip trailer
+        size_t size = 0;
+        size_t payload = 0;
+        std::vector<uint8_t> spill;  // Inflated output that did not fit its reservation
+    };
+
+    out.tilts.assign(tilts.size(), VolumeData::Tilt());
+    out.inflated.clear();
+    if (threads <= 0) threads = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+
+    // Open every file and ask for all of them before reading any, so the kernel can fetch them concurrently
+    std::vector<Slot> slots(tilts.size());
+    const std::string dir = volume_dir(station, product, timestamp, true);
+    for (size_t i = 0; i < tilts.size(); ++i) {
+        out.tilts[i].tilt = tilts[i];
+        slots[i].path = dir + "/" + format_filename(timestamp, tilts[i]);
+        int fd = ::open(slots[i].path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if (fd < 0) continue;
+        if (::fstat(fd, &st) != 0 || st.st_size <= 0) {
+            ::close(fd);
+            continue;
+        }
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        slots[i].fd = fd;
+        slots[i].compressed.resize(static_cast<size_t>(st.st_size));
+    }
+
+    levelii::parallel_for(slots.size(), threads, [&](size_t i) {
+        Slot& slot = slots[i];
+        if (slot.fd < 0) return;
+        bool ok = pread_all(slot.fd, slot.compressed.data(), slot.compressed.size());
+        ::close(slot.fd);
+        slot.fd = -1;
+        if (ok && ZlibUtils::verify_gzip_crc(slot.compressed.data(), slot.compressed.size()) == ZlibUtils::GzipCrcStatus::Mismatch) {
+            log_error("Checksum mismatch in " + slot.path);
+            ok = false;
+        }
+        if (!ok) slot.compressed.clear();
+    });
+
+    // Lay the tilts out back to back in one buffer
+    size_t total = 0;
+    for (Slot& slot : slots) {
+        if (slot.compressed.empty()) continue;
+        slot.capacity = ZlibUtils::gzip_inflated_size(slot.compressed.data(), slot.compressed.size());
+        slot.offset = total;
+        total += slot.capacity;
+    }
+    out.inflated.resize(total);
+
+    levelii::parallel_for(slots.size(), threads, [&](size_t i) {
+        Slot& slot = slots[i];
+        if (slot.compressed.empty()) return;
+        const uint8_t* inflated = out.inflated.data() + slot.offset;
+        if (!ZlibUtils::gzip_decompress_into(slot.compressed.data(), slot.compressed.size(), out.inflated.data() + slot.offset,
+                                             slot.capacity, slot.size)) {
+            // Trailer did not describe the whole file (e.g. concatenated members); inflate it on its own
+            if (!ZlibUtils::gzip_decompress(slot.compressed.data(), slot.compressed.size(), slot.spill)) return;
+            inflated = slot.spill.data();
+            slot.size = slot.spill.size();
+        }
+        std::vector<uint8_t>().swap(slot.compressed);
+        out.tilts[i].loaded = split_frame(inflated, slot.size, out.tilts[i].metadata, slot.payload, slot.path);
+    });
+
+    // Spilled tilts move to the end; views are only taken once the buffer has its final size
+    for (Slot& slot : slots) {
+        if (slot.spill.empty()) continue;
+        slot.offset = out.inflated.size();
+        out.inflated.insert(out.inflated.end(), slot.spill.begin(), slot.spill.end());
+    }
+
+    bool all_loaded = true;
+    for (size_t i = 0; i < slots.size(); ++i) {
+        VolumeData::Tilt& tilt = out.tilts[i];
+        if (!tilt.loaded) {
+            all_loaded = false;
+            continue;
+        }
+        const Slot& slot = slots[i];
+        tilt.binary_data = ByteView(out.inflated.data() + slot.offset + slot.payload, slot.size - slot.payload);
+    }
+    return all_loaded;
+}
+
 std::string FrameStorageManager::format_filename(const std::string& timestamp, float tilt) const {
     std::ostringstream oss;
     oss << std::fixed << std::setprecision(1) << tilt << ".RDA";
@@ -157,15 +474,10 @@ std::string FrameStorageManager::format_filename(const std::string& timestamp, f
 }
 
 std::string FrameStorageManager::get_frame_path(const std::string& station, const std::string& product, const std::string& timestamp, float tilt) const {
-    std::ostringstream oss;
-    oss << base_path_ << "/" << station << "/" << product << "/" << timestamp << "/" << format_filename(timestamp, tilt);
-    return oss.str();
+    return volume_dir(station, product, timestamp) + "/" + format_filename(timestamp, tilt);
 }
 
-bool FrameStorageManager::save_frame_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, uint16_t num_rays, uint16_t num_gates, float gate_spacing, float first_gate, const std::vector<uint8_t>& bitmask, const std::vector<uint8_t>& values, const RadarFrame::DualPolMetadata& dualpol_meta, bool auto_update_index) {
-    std::string dir = base_path_ + "/" + station + "/" + product + "/" + timestamp;
-    if (!ensure_directory_exists(dir)) return false;
-    
+bool FrameStorageManager::save_frame_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, uint16_t num_rays, uint16_t num_gates, float gate_spacing, float first_gate, const std::vector<uint8_t>& bitmask, const std::vector<uint8_t>& values, const RadarFrame::DualPolMetadata& dualpol_meta, bool auto_update_index, size_t* stored_bytes) {
     json metadata = {
         {"s", station}, {"p", product}, {"t", timestamp}, {"e", tilt},
         {"f", "b"}, {"r", num_rays}, {"g", num_gates}, {"gs", gate_spacing},
@@ -179,30 +491,19 @@ bool FrameStorageManager::save_frame_bitmask(const std::string& station, const s
         };
     }
     
-    std::string metadata_str = metadata.dump();
-    uint32_t metadata_size = metadata_str.size();
-    
-    std::vector<uint8_t> uncompressed;
-    uncompressed.reserve(4 + metadata_size + bitmask.size() + values.size());
-    uncompressed.insert(uncompressed.end(), reinterpret_cast<uint8_t*>(&metadata_size), reinterpret_cast<uint8_t*>(&metadata_size) + 4);
-    uncompressed.insert(uncompressed.end(), metadata_str.begin(), metadata_str.end());
-    uncompressed.insert(uncompressed.end(), bitmask.begin(), bitmask.end());
-    uncompressed.insert(uncompressed.end(), values.begin(), values.end());
-    
-    auto compressed = ZlibUtils::gzip_compress(uncompressed.data(), uncompressed.size());
+    int tier = 0;
+    std::string dir = volume_dir(station, product, timestamp, false, &tier);
+    if (!ensure_directory_exists(dir)) return false;
+    auto compressed = encode_frame(std::move(metadata), bitmask, values, num_rays, num_gates, tier_level(tier));
     if (compressed.empty()) return false;
     
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(1) << tilt << ".RDA";
-    std::string file_path = dir + "/" + oss.str();
+    std::string filename = format_filename(timestamp, tilt);
+    std::string file_path = dir + "/" + filename;
     
     bool existed = fs::exists(file_path);
     size_t old_size = existed ? fs::file_size(file_path) : 0;
     
-    std::ofstream file(file_path, std::ios::binary);
-    if (!file.is_open()) return false;
-    file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
-    file.close();
+    if (!write_frame_file(file_path, compressed)) return false;
     
     {
         std::lock_guard<std::mutex> lock(stats_mutex_);
@@ -211,87 +512,349 @@ bool FrameStorageManager::save_frame_bitmask(const std::string& station, const s
         }
         total_disk_usage_ += (compressed.size() - old_size);
     }
+    if (stored_bytes) *stored_bytes = compressed.size();
     
-    if (auto_update_index) {
-        db_->insert_frame("levelii_frames", station, 0, product, timestamp, oss.str());
+    index_frame(station, product, timestamp, filename, stored_crc(compressed), auto_update_index);
+
+    if (timeseries_) {
+        timeseries_->append_frame(station, product, timestamp, tilt, num_rays, num_gates, gate_spacing, first_gate, bitmask, values);
     }
     return true;
 }
 
-bool FrameStorageManager::load_frame_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, CompressedFrameData& out_data) const {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(1) << tilt << ".RDA";
-    std::string file_path = base_path_ + "/" + station + "/" + product + "/" + timestamp + "/" + oss.str();
-    
-    if (!fs::exists(file_path)) return false;
-    
-    std::ifstream file(file_path, std::ios::binary);
-    if (!file) return false;
-    
-    file.seekg(0, std::ios::end);
-    size_t compressed_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    std::vector<uint8_t> compressed(compressed_size);
-    file.read(reinterpret_cast<char*>(compressed.data()), compressed_size);
-    file.close();
-    
-    auto decompressed = ZlibUtils::gzip_decompress(compressed.data(), compressed.size());
-    if (decompressed.size() < 4) return false;
-    
-    uint32_t metadata_size;
-    std::memcpy(&metadata_size, decompressed.data(), 4);
-    if (4 + metadata_size > decompressed.size()) return false;
-    
+struct FrameStorageManager::FrameLoad {
+    std::mutex mutex;
+    std::condition_variable done_cv;
+    bool done = false;
+    size_t joined = 0;                             // Guarded by frame_loads_mutex_
+    std::shared_ptr<CompressedFrameData> result;   // nullptr if the load failed
+};
+
+std::shared_ptr<FrameStorageManager::CompressedFrameData> FrameStorageManager::load_frame_coalesced(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, bool& exclusive) const {
+    const std::string filename = format_filename(timestamp, tilt);
+    const std::string key = volume_key(station, product, timestamp) + "/" + filename;
+
+    std::shared_ptr<FrameLoad> load;
+    bool leader = false;
+    {
+        std::lock_guard<std::mutex> lock(frame_loads_mutex_);
+        auto& slot = frame_loads_[key];
+        if (!slot) {
+            slot = std::make_shared<FrameLoad>();
+            leader = true;
+        } else {
+            slot->joined++;
+        }
+        load = slot;
+    }
+
+    if (!leader) {
+        frames_coalesced_.fetch_add(1, std::memory_order_relaxed);
+        exclusive = false;
+        std::unique_lock<std::mutex> lock(load->mutex);
+        load->done_cv.wait(lock, [&load] { return load->done; });
+        return load->result;
+    }
+
+    // Whatever happens, the entry is removed and waiters are released
+    auto data = std::make_shared<CompressedFrameData>();
+    auto finish = [&](std::shared_ptr<CompressedFrameData> result) {
+        size_t joined = 0;
+        {
+            std::lock_guard<std::mutex> lock(frame_loads_mutex_);
+            joined = load->joined;
+            frame_loads_.erase(key);
+        }
+        {
+            std::lock_guard<std::mutex> lock(load->mutex);
+            load->result = std::move(result);
+            load->done = true;
+        }
+        load->done_cv.notify_all();
+        return joined;
+    };
+
+    bool ok = false;
     try {
-        std::string metadata_str(reinterpret_cast<const char*>(decompressed.data() + 4), metadata_size);
-        out_data.metadata = json::parse(metadata_str);
-        out_data.binary_data.assign(decompressed.begin() + 4 + metadata_size, decompressed.end());
-    } catch (const std::exception& e) {
-        log_error("Failed to parse bitmask metadata in " + file_path + ": " + e.what());
-        return false;
+        ok = read_frame_file(volume_dir(station, product, timestamp, true) + "/" + filename, *data);
+    } catch (...) {
+        finish(nullptr);
+        throw;
+    }
+    frames_loaded_.fetch_add(1, std::memory_order_relaxed);
+    if (!ok) data.reset();
+
+    // Nobody joined: the result can be handed out without a copy. Once the
+    // entry is gone nobody can join any more.
+    exclusive = finish(data) == 0;
+    return data;
+}
+
+bool FrameStorageManager::load_frame_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, CompressedFrameData& out_data) const {
+    bool exclusive = false;
+    auto data = load_frame_coalesced(station, product, timestamp, tilt, exclusive);
+    if (!data) return false;
+    if (exclusive) {
+        out_data = std::move(*data);
+    } else {
+        out_data = *data;
     }
-    
     return true;
 }
 
-bool FrameStorageManager::load_volumetric_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, CompressedFrameData& out_data) const {
-    std::string file_path = base_path_ + "/" + station + "/" + product + "/" + timestamp + "/volumetric.RDA";
-    
-    if (!fs::exists(file_path)) return false;
-    
-    std::ifstream file(file_path, std::ios::binary);
-    if (!file) return false;
-    
-    file.seekg(0, std::ios::end);
-    size_t compressed_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-    
-    std::vector<uint8_t> compressed(compressed_size);
-    file.read(reinterpret_cast<char*>(compressed.data()), compressed_size);
-    file.close();
-    
-    auto decompressed = ZlibUtils::gzip_decompress(compressed.data(), compressed.size());
-    if (decompressed.size() < 4) return false;
-    
-    uint32_t metadata_size;
-    std::memcpy(&metadata_size, decompressed.data(), 4);
-    if (4 + metadata_size > decompressed.size()) return false;
-    
-    try {
-        std::string metadata_str(reinterpret_cast<const char*>(decompressed.data() + 4), metadata_size);
-        out_data.metadata = json::parse(metadata_str);
-        out_data.binary_data.assign(decompressed.begin() + 4 + metadata_size, decompressed.end());
-    } catch (const std::exception& e) {
-        log_error("Failed to parse volumetric bitmask metadata in " + file_path + ": " + e.what());
+std::shared_ptr<const FrameStorageManager::CompressedFrameData> FrameStorageManager::load_frame_shared(const std::string& station, const std::string& product, const std::string& timestamp, float tilt) const {
+    bool exclusive = false;
+    return load_frame_coalesced(station, product, timestamp, tilt, exclusive);
+}
+
+FrameStorageManager::ReadStats FrameStorageManager::get_read_stats() const {
+    ReadStats stats;
+    stats.loads = frames_loaded_.load(std::memory_order_relaxed);
+    stats.coalesced = frames_coalesced_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool FrameStorageManager::load_frame_grid(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, std::vector<uint8_t>& grid, json* metadata) const {
+    CompressedFrameData data;
+    size_t cells = 0;
+    if (!load_frame_bitmask(station, product, timestamp, tilt, data) || !frame_cells(data.metadata, data.binary_data.size(), cells)) return false;
+    const size_t mask_bytes = (cells + 7) / 8;
+    grid.resize(cells);
+    BitmaskCodec::expand(data.binary_data.data(), 0, cells, data.binary_data.data() + mask_bytes, data.binary_data.size() - mask_bytes, grid.data());
+    if (metadata) *metadata = std::move(data.metadata);
+    return true;
+}
+
+bool FrameStorageManager::load_frame_grid(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, const QuantizationParams& params, std::vector<float>& grid, json* metadata) const {
+    CompressedFrameData data;
+    size_t cells = 0;
+    if (!load_frame_bitmask(station, product, timestamp, tilt, data) || !frame_cells(data.metadata, data.binary_data.size(), cells)) return false;
+    const size_t mask_bytes = (cells + 7) / 8;
+    const auto table = BitmaskCodec::dequant_table(params.value_min, params.value_max, std::numeric_limits<float>::quiet_NaN());
+    grid.resize(cells);
+    BitmaskCodec::expand(data.binary_data.data(), 0, cells, data.binary_data.data() + mask_bytes, data.binary_data.size() - mask_bytes, table, grid.data());
+    if (metadata) *metadata = std::move(data.metadata);
+    return true;
+}
+
+bool FrameStorageManager::load_frame_sector(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, float azimuth_start, float azimuth_end, float min_range, float max_range, FrameSector& out) const {
+    out = FrameSector();
+    std::string path = volume_dir(station, product, timestamp, true) + "/" + format_filename(timestamp, tilt);
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    struct FdCloser {
+        int fd;
+        ~FdCloser() { ::close(fd); }
+    } closer{fd};
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size <= 0) return false;
+    const size_t file_size = static_cast<size_t>(st.st_size);
+
+    // The first gzip member holds the metadata and block index; read more only if it is longer than the guess
+    std::vector<uint8_t> head;
+    std::vector<uint8_t> header;
+    size_t header_end = 0;
+    for (size_t want = std::min<size_t>(file_size, 4096);; want = std::min(file_size, want * 4)) {
+        head.resize(want);
+        if (!pread_all(fd, head.data(), want)) return false;
+        if (ZlibUtils::gzip_decompress_member(head.data(), want, header, header_end)) break;
+        if (want == file_size) return false;
+    }
+    out.bytes_read = head.size();
+    size_t payload_offset = 0;
+    if (!split_frame(header.data(), header.size(), out.metadata, payload_offset, path)) return false;
+
+    const json& meta = out.metadata;
+    const size_t num_rays = meta.value("r", 0);
+    const size_t num_gates = meta.value("g", 0);
+    const float gate_spacing = meta.value("gs", 0.0f);
+    const float first_gate = meta.value("fg", 0.0f);
+    if (num_rays == 0 || num_gates == 0 || gate_spacing <= 0.0f || meta.contains("tilts")) return false;
+
+    size_t first_ray = 0;
+    size_t rows = num_rays;
+    if (azimuth_end - azimuth_start < 360.0f) {
+        float start = std::fmod(azimuth_start, 360.0f);
+        if (start < 0.0f) start += 360.0f;
+        float width = std::fmod(azimuth_end - azimuth_start, 360.0f);
+        if (width < 0.0f) width += 360.0f;
+        long ray = azimuth_ray(start, num_rays);
+        long last = azimuth_ray(start + width, num_rays);
+        first_ray = static_cast<size_t>(ray) % num_rays;
+        rows = std::min(num_rays, static_cast<size_t>(last - ray + 1));
+    }
+    long gate_begin = std::max(0L, static_cast<long>(std::floor((min_range - first_gate) / gate_spacing)));
+    long gate_last = static_cast<long>(num_gates) - 1;
+    if (max_range > 0.0f) gate_last = std::min(gate_last, static_cast<long>(std::floor((max_range - first_gate) / gate_spacing)));
+    if (gate_last < gate_begin) return false;
+
+    out.first_ray = static_cast<uint16_t>(first_ray);
+    out.num_rays = static_cast<uint16_t>(rows);
+    out.first_gate = static_cast<uint16_t>(gate_begin);
+    out.num_gates = static_cast<uint16_t>(gate_last - gate_begin + 1);
+    out.values.assign(rows * out.num_gates, 0);
+
+    // Each ray is read from a block: a bitmask slice starting at block_first_ray and the values it selects
+    struct Block {
+        std::vector<uint8_t> mask;
+        std::vector<uint8_t> values;
+        bool decoded = false;
+    };
+    std::vector<Block> blocks;
+    size_t block_rays = num_rays;
+    const uint8_t* whole = header.data() + payload_offset;
+    const size_t mask_bytes = (num_rays * num_gates + 7) / 8;
+
+    if (meta.contains("ix")) {
+        block_rays = meta["ix"].value("n", RAY_BLOCK);
+        if (block_rays == 0 || block_rays * num_gates % 8 != 0) return false;
+        blocks.resize((num_rays + block_rays - 1) / block_rays);
+    } else {
+        // No index: the first member was the whole file, already read and inflated
+        if (ZlibUtils::verify_gzip_crc(head.data(), head.size()) == ZlibUtils::GzipCrcStatus::Mismatch) {
+            log_error("Checksum mismatch in " + path);
+            return false;
+        }
+        if (header.size() - payload_offset < mask_bytes) return false;
+    }
+
+    std::vector<uint8_t> compressed;
+    auto read_member = [&](size_t offset, size_t size, size_t raw, std::vector<uint8_t>& target) -> bool {
+        target.resize(raw);
+        if (raw == 0) return true;
+        compressed.resize(size);
+        size_t produced = 0;
+        if (offset + size > file_size || !pread_all(fd, compressed.data(), size, offset) ||
+            !ZlibUtils::gzip_decompress_into(compressed.data(), size, target.data(), raw, produced) || produced != raw) {
+            return false;
+        }
+        out.bytes_read += size;
+        return true;
+    };
+
+    auto decode_block = [&](size_t b) -> bool {
+        Block& block = blocks[b];
+        if (block.decoded) return true;
+        const json& index = meta["ix"];
+        const auto& mask_sizes = index["b"];
+        const auto& value_sizes = index["v"];
+        const auto& value_starts = index["c"];
+        if (mask_sizes.size() != blocks.size() || value_sizes.size() != blocks.size() || value_starts.size() != blocks.size() + 1) return false;
+
+        // Members follow the header: every bitmask block, then every value block
+        size_t mask_offset = header_end;
+        size_t value_offset = header_end;
+        for (size_t i = 0; i < blocks.size(); ++i) {
+            if (i < b) mask_offset += mask_sizes[i].get<size_t>();
+            value_offset += mask_sizes[i].get<size_t>();
+        }
+        for (size_t i = 0; i < b; ++i) value_offset += value_sizes[i].get<size_t>();
+
+        const size_t block_bytes = block_rays * num_gates / 8;
+        const size_t mask_len = std::min(block_bytes, mask_bytes - b * block_bytes);
+        const size_t value_count = value_starts[b + 1].get<size_t>() - value_starts[b].get<size_t>();
+        if (!read_member(mask_offset, mask_sizes[b].get<size_t>(), mask_len, block.mask) ||
+            !read_member(value_offset, value_sizes[b].get<size_t>(), value_count, block.values)) {
+            log_error("Corrupt ray block " + std::to_string(b) + " in " + path);
+            return false;
+        }
+        block.decoded = true;
+        return true;
+    };
+
+    // Without an index, value positions come from one pass over the bitmask
+    std::vector<size_t> ray_value_starts;
+    if (blocks.empty()) {
+        ray_value_starts.resize(num_rays);
+        size_t count = 0;
+        for (size_t ray = 0; ray < num_rays; ++ray) {
+            ray_value_starts[ray] = count;
+            count += count_bits(whole, ray * num_gates, (ray + 1) * num_gates);
+        }
+    }
+
+    for (size_t row = 0; row < rows; ++row) {
+        const size_t ray = (first_ray + row) % num_rays;
+        const uint8_t* mask = whole;
+        const uint8_t* values = whole + mask_bytes;
+        size_t value_count = header.size() - payload_offset - mask_bytes;
+        size_t ray_bit = ray * num_gates;
+        if (!blocks.empty()) {
+            const size_t b = ray / block_rays;
+            if (!decode_block(b)) return false;
+            mask = blocks[b].mask.data();
+            values = blocks[b].values.data();
+            value_count = blocks[b].values.size();
+            ray_bit = (ray - b * block_rays) * num_gates;
+        }
+
+        size_t v = blocks.empty() ? ray_value_starts[ray] + count_bits(mask, ray_bit, ray_bit + gate_begin)
+                                  : count_bits(mask, 0, ray_bit + gate_begin);
+        if (v < value_count) {
+            BitmaskCodec::expand(mask, ray_bit + gate_begin, out.num_gates, values + v, value_count - v,
+                                 out.values.data() + row * out.num_gates);
+        }
+    }
+    return true;
+}
+
+bool FrameStorageManager::open_frame_points(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, FramePoints& out) const {
+    out = FramePoints();
+    CompressedFrameData data;
+    size_t cells = 0;
+    if (!load_frame_bitmask(station, product, timestamp, tilt, data) || data.metadata.contains("tilts") ||
+        !frame_cells(data.metadata, data.binary_data.size(), cells)) {
         return false;
     }
-    
+    out.num_rays_ = data.metadata.value("r", 0);
+    out.num_gates_ = data.metadata.value("g", 0);
+    out.gate_spacing_ = data.metadata.value("gs", 0.0f);
+    out.first_gate_ = data.metadata.value("fg", 0.0f);
+    if (out.gate_spacing_ <= 0.0f) return false;
+    out.frame_ = std::move(data);
+
+    const size_t mask_bytes = (cells + 7) / 8;
+    const uint8_t* payload = out.frame_.binary_data.data();
+    out.rank_ = BitmaskCodec::RankIndex(payload, cells);
+    out.values_ = payload + mask_bytes;
+    out.value_count_ = out.frame_.binary_data.size() - mask_bytes;
     return true;
 }
 
-bool FrameStorageManager::save_volumetric_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, const std::vector<float>& tilts, uint16_t num_rays, uint16_t num_gates, float gate_spacing, float first_gate, const std::vector<uint8_t>& bitmask, const std::vector<uint8_t>& values, const RadarFrame::DualPolMetadata& dualpol_meta, bool auto_update_index) {
-    std::string dir = base_path_ + "/" + station + "/" + product + "/" + timestamp;
+bool FrameStorageManager::sample_frame_points(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, const std::vector<FramePoints::Point>& points, std::vector<uint8_t>& levels) const {
+    FramePoints frame;
+    if (!open_frame_points(station, product, timestamp, tilt, frame)) return false;
+    frame.sample(points, levels);
+    return true;
+}
+
+uint8_t FrameStorageManager::FramePoints::level(size_t ray, size_t gate) const {
+    if (ray >= num_rays_ || gate >= num_gates_) return 0;
+    const size_t bit = ray * num_gates_ + gate;
+    if (!rank_.test(bit)) return 0;
+    const size_t v = rank_.rank(bit);
+    return v < value_count_ ? values_[v] : 0;
+}
+
+void FrameStorageManager::FramePoints::sample(const std::vector<Point>& points, std::vector<uint8_t>& levels) const {
+    levels.assign(points.size(), 0);
+    if (num_rays_ == 0) return;
+    for (size_t i = 0; i < points.size(); ++i) {
+        float azimuth = std::fmod(points[i].azimuth, 360.0f);
+        if (azimuth < 0.0f) azimuth += 360.0f;
+        const float offset = (points[i].range - first_gate_) / gate_spacing_;
+        if (!(offset >= 0.0f) || offset >= static_cast<float>(num_gates_)) continue;
+        levels[i] = level(static_cast<size_t>(azimuth_ray(azimuth, num_rays_)) % num_rays_, static_cast<size_t>(offset));
+    }
+}
+
+bool FrameStorageManager::load_volumetric_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, CompressedFrameData& out_data) const {
+    return read_frame_file(volume_dir(station, product, timestamp, true) + "/volumetric.RDA", out_data);
+}
+
+bool FrameStorageManager::save_volumetric_bitmask(const std::string& station, const std::string& product, const std::string& timestamp, const std::vector<float>& tilts, uint16_t num_rays, uint16_t num_gates, float gate_spacing, float first_gate, const std::vector<uint8_t>& bitmask, const std::vector<uint8_t>& values, const RadarFrame::DualPolMetadata& dualpol_meta, bool auto_update_index, size_t* stored_bytes) {
+    int tier = 0;
+    std::string dir = volume_dir(station, product, timestamp, false, &tier);
     if (!ensure_directory_exists(dir)) return false;
     
     json metadata = {
@@ -317,7 +880,7 @@ bool FrameStorageManager::save_volumetric_bitmask(const std::string& station, co
     uncompressed.insert(uncompressed.end(), bitmask.begin(), bitmask.end());
     uncompressed.insert(uncompressed.end(), values.begin(), values.end());
     
-    auto compressed = ZlibUtils::gzip_compress(uncompressed.data(), uncompressed.size());
+    auto compressed = ZlibUtils::gzip_compress_with_crc(uncompressed.data(), uncompressed.size(), tier_level(tier));
     if (compressed.empty()) return false;
     
     std::string file_path = dir + "/volumetric.RDA";
@@ -325,10 +888,7 @@ bool FrameStorageManager::save_volumetric_bitmask(const std::string& station, co
     bool existed = fs::exists(file_path);
     size_t old_size = existed ? fs::file_size(file_path) : 0;
     
-    std::ofstream file(file_path, std::ios::binary);
-    if (!file.is_open()) return false;
-    file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
-    file.close();
+    if (!write_frame_file(file_path, compressed)) return false;
     
     {
         std::lock_guard<std::mutex> lock(stats_mutex_);
@@ -337,27 +897,75 @@ bool FrameStorageManager::save_volumetric_bitmask(const std::string& station, co
         }
         total_disk_usage_ += (compressed.size() - old_size);
     }
+    if (stored_bytes) *stored_bytes = compressed.size();
     
-    if (auto_update_index) {
-        db_->insert_frame("levelii_frames", station, 0, product, timestamp, "volumetric.RDA");
-    }
+    index_frame(station, product, timestamp, "volumetric.RDA", stored_crc(compressed), auto_update_index);
     return true;
 }
 
+void FrameStorageManager::index_frame(const std::string& station, const std::string& product, const std::string& timestamp,
+                                      const std::string& filename, int64_t crc32c, bool now) {
+    if (now) {
+        db_->insert_frame("levelii_frames", station, 0, product, timestamp, filename, crc32c);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pending_index_mutex_);
+    pending_index_[station + "/" + product].push_back({timestamp, filename, crc32c});
+}
+
 void FrameStorageManager::update_index(const std::string& station, const std::string& product) {
-    // Scan directory and update SQLite for any missing entries
-    std::string product_dir = base_path_ + "/" + station + "/" + product;
-    if (!fs::exists(product_dir)) return;
+    // Rows saved since the last call, with the checksums recorded when they were written. Existing rows are
+    // updated in place so they keep their rowid and the scrubber's cursor stays valid.
+    std::vector<PendingIndexRow> pending;
+    {
+        std::lock_guard<std::mutex> lock(pending_index_mutex_);
+        auto it = pending_index_.find(station + "/" + product);
+        if (it != pending_index_.end()) {
+            pending = std::move(it->second);
+            pending_index_.erase(it);
+        }
+    }
+    std::vector<std::pair<std::string, std::vector<std::string>>> statements;
+    for (const auto& row : pending) {
+        statements.push_back({"INSERT INTO levelii_frames (station, product_code, product_name, timestamp, filename, crc32c) "
+                              "VALUES (?, 0, ?, ?, ?, NULLIF(CAST(? AS INTEGER), -1)) "
+                              "ON CONFLICT (station, product_name, timestamp, filename) DO UPDATE SET crc32c = excluded.crc32c;",
+                              {station, product, row.timestamp, row.filename, std::to_string(row.crc32c)}});
+    }
 
-    for (const auto& ts_entry : fs::directory_iterator(product_dir)) {
+    // Scan the hot tier for files written some other way and add their rows; indexed files are not reopened.
+    // Colder tiers are left alone: move_volume keeps the index current for everything it moves.
+    std::unordered_set<std::string> indexed;
+    for (const auto& row : pending) indexed.insert(row.timestamp + "/" + row.filename);
+    for (const auto& row : db_->query_params("SELECT timestamp, filename FROM levelii_frames WHERE station = ? AND product_name = ?;",
+                                             {station, product})) {
+        indexed.insert(row["timestamp"].get<std::string>() + "/" + row["filename"].get<std::string>());
+    }
+    std::string product_dir = base_path_ + "/" + station + "/" + product;
+    std::error_code ec;
+    for (const auto& ts_entry : fs::directory_iterator(product_dir, ec)) {
         if (!ts_entry.is_directory()) continue;
         std::string timestamp = ts_entry.path().filename().string();
-        for (const auto& file_entry : fs::directory_iterator(ts_entry)) {
-            if (file_entry.is_regular_file() && file_entry.path().extension() == ".RDA") {
-                db_->insert_frame("levelii_frames", station, 0, product, timestamp, file_entry.path().filename().string());
+        bool checked_tier = false;
+        for (const auto& file_entry : fs::directory_iterator(ts_entry, ec)) {
+            if (!file_entry.is_regular_file() || file_entry.path().extension() != ".RDA") continue;
+            std::string filename = file_entry.path().filename().string();
+            if (indexed.count(timestamp + "/" + filename)) continue;
+            // Old copies waiting for removal after a tier move are not indexed
+            if (!checked_tier) {
+                if (volume_tier(station, product, timestamp) != 0) break;
+                checked_tier = true;
             }
+            std::vector<uint8_t> header(CRC_HEADER_PREFIX);
+            std::ifstream file(file_entry.path(), std::ios::binary);
+            file.read(reinterpret_cast<char*>(header.data()), header.size());
+            header.resize(file.gcount());
+            statements.push_back({"INSERT OR IGNORE INTO levelii_frames (station, product_code, product_name, timestamp, filename, crc32c) "
+                                  "VALUES (?, 0, ?, ?, ?, NULLIF(CAST(? AS INTEGER), -1));",
+                                  {station, product, timestamp, filename, std::to_string(stored_crc(header))}});
         }
     }
+    if (!statements.empty()) db_->execute_transaction(statements);
 }
 
 json FrameStorageManager::get_index(const std::string& station, const std::string& product) const {
@@ -411,7 +1019,7 @@ std::vector<FrameStorageManager::FrameMetadata> FrameStorageManager::list_frames
             }
         } catch (...) { meta.tilt = 0.0f; }
         
-        meta.file_path = base_path_ + "/" + meta.station + "/" + meta.product + "/" + meta.timestamp + "/" + filename;
+        meta.file_path = volume_dir(meta.station, meta.product, meta.timestamp) + "/" + filename;
         
         std::error_code ec;
         meta.file_size = fs::exists(meta.file_path, ec) ? fs::file_size(meta.file_path, ec) : 0;
@@ -428,26 +1036,565 @@ bool FrameStorageManager::has_timestamp_product(const std::string& station, cons
     return !results.empty();
 }
 
+void FrameStorageManager::enable_timeseries_archive(int retention_hours) {
+    timeseries_retention_hours_ = retention_hours;
+    if (!timeseries_) {
+        timeseries_ = std::make_unique<TimeSeriesArchive>(base_path_ + "/_timeseries", *db_);
+    }
+}
+
+std::vector<TimeSeriesArchive::Sample> FrameStorageManager::query_timeseries(const TimeSeriesArchive::Query& q) const {
+    if (!timeseries_) return {};
+    return timeseries_->query(q);
+}
+
+void FrameStorageManager::enable_object_sink(std::unique_ptr<ObjectStoreClient> client, const ObjectSinkConfig& config) {
+    db_->execute(
+        "CREATE TABLE IF NOT EXISTS levelii_uploads ("
+        "    station TEXT,"
+        "    product_name TEXT,"
+        "    timestamp TEXT,"
+        "    object_key TEXT,"
+        "    status TEXT,"
+        "    attempts INTEGER DEFAULT 0,"
+        "    PRIMARY KEY (station, product_name, timestamp)"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_levelii_uploads_status ON levelii_uploads (status);");
+
+    object_sink_ = std::make_unique<ObjectSink>(std::move(client), config,
+        [this](const ObjectSink::Volume& volume, const std::string& key, bool success) {
+            db_->execute_params(
+                "UPDATE levelii_uploads SET status = ?, object_key = ?, attempts = attempts + 1 "
+                "WHERE station = ? AND product_name = ? AND timestamp = ?;",
+                {success ? "uploaded" : "failed", key, volume.station, volume.product, volume.timestamp});
+            if (success) {
+                log_info("Uploaded " + key);
+            } else {
+                log_error("Upload failed for " + key);
+            }
+        });
+
+    // Resume volumes that were written but never confirmed as uploaded
+    json pending = db_->query(
+        "SELECT station, product_name, timestamp FROM levelii_uploads "
+        "WHERE status IN ('pending', 'failed') ORDER BY timestamp ASC;");
+    for (const auto& row : pending) {
+        publish_volume(row["station"], row["product_name"], row["timestamp"]);
+    }
+}
+
+void FrameStorageManager::publish_volume(const std::string& station, const std::string& product, const std::string& timestamp) {
+    if (!object_sink_) return;
+
+    ObjectSink::Volume volume{station, product, timestamp, {}};
+    std::string dir = volume_dir(station, product, timestamp);
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(dir, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".RDA") {
+            volume.files.emplace_back(entry.path().filename().string(), entry.path().string());
+        }
+    }
+    if (volume.files.empty()) {
+        db_->execute_params("DELETE FROM levelii_uploads WHERE station = ? AND product_name = ? AND timestamp = ?;",
+                            {station, product, timestamp});
+        return;
+    }
+    std::sort(volume.files.begin(), volume.files.end());
+
+    db_->execute_params(
+        "INSERT INTO levelii_uploads (station, product_name, timestamp, object_key, status) "
+        "VALUES (?, ?, ?, ?, 'pending') "
+        "ON CONFLICT (station, product_name, timestamp) DO UPDATE SET status = 'pending';",
+        {station, product, timestamp, object_sink_->object_key(station, product, timestamp)});
+
+    object_sink_->enqueue(std::move(volume));
+}
+
+void FrameStorageManager::flush_object_sink() {
+    if (object_sink_) object_sink_->flush();
+}
+
+ObjectSink::Stats FrameStorageManager::get_object_sink_stats() const {
+    return object_sink_ ? object_sink_->get_stats() : ObjectSink::Stats{};
+}
+
+bool FrameStorageManager::is_upload_pending(const std::string& station, const std::string& product, const std::string& timestamp) const {
+    if (!object_sink_) return false;
+    json rows = db_->query_params(
+        "SELECT 1 FROM levelii_uploads WHERE station = ? AND product_name = ? AND timestamp = ? AND status IN ('pending', 'failed') LIMIT 1;",
+        {station, product, timestamp});
+    return !rows.empty();
+}
+
+void FrameStorageManager::start_scrubber(const ScrubberConfig& config, CorruptFrameCallback on_corrupt) {
+    stop_scrubber();
+    scrubber_stop_.store(false);
+    scrubber_thread_ = std::thread([this, config, on_corrupt]() { scrub_loop(config, on_corrupt); });
+}
+
+void FrameStorageManager::stop_scrubber() {
+    if (!scrubber_thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(scrubber_mutex_);
+        scrubber_stop_.store(true);
+    }
+    scrubber_cv_.notify_all();
+    scrubber_thread_.join();
+}
+
+FrameStorageManager::ScrubStats FrameStorageManager::get_scrub_stats() const {
+    std::lock_guard<std::mutex> lock(scrub_stats_mutex_);
+    return scrub_stats_;
+}
+
+bool FrameStorageManager::scrubber_wait(std::chrono::milliseconds duration) {
+    std::unique_lock<std::mutex> lock(scrubber_mutex_);
+    return !scrubber_cv_.wait_for(lock, duration, [this]() { return scrubber_stop_.load(); });
+}
+
+void FrameStorageManager::scrub_loop(ScrubberConfig config, CorruptFrameCallback on_corrupt) {
+    const size_t BATCH_SIZE = 64;
+    const double bytes_per_ms = std::max<size_t>(config.bytes_per_second, 1) / 1000.0;
+    int64_t cursor = 0;
+
+    while (!scrubber_stop_.load()) {
+        // Walk by rowid so rows inserted or purged mid-pass do not restart the walk
+        json rows = db_->query_params(
+            "SELECT rowid AS id, station, product_name, timestamp, filename, crc32c FROM levelii_frames "
+            "WHERE rowid > ? ORDER BY rowid LIMIT " + std::to_string(BATCH_SIZE) + ";",
+            {std::to_string(cursor)});
+
+        if (rows.empty()) {
+            cursor = 0;
+            {
+                std::lock_guard<std::mutex> lock(scrub_stats_mutex_);
+                scrub_stats_.passes_completed++;
+            }
+            if (!scrubber_wait(std::chrono::seconds(config.pass_interval_seconds))) break;
+            continue;
+        }
+
+        for (const auto& row : rows) {
+            if (scrubber_stop_.load()) break;
+            cursor = row["id"].get<int64_t>();
+
+            std::string station = row["station"];
+            std::string product = row["product_name"];
+            std::string timestamp = row["timestamp"];
+            std::string filename = row["filename"];
+            std::string file_path = volume_dir(station, product, timestamp) + "/" + filename;
+
+            std::ifstream file(file_path, std::ios::binary);
+            if (!file) continue; // Removed by cleanup since the batch was read
+            std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            file.close();
+
+            uint32_t header_crc = 0;
+            auto status = ZlibUtils::verify_gzip_crc(data.data(), data.size(), &header_crc);
+            bool indexed = !row["crc32c"].is_null();
+            bool corrupt = status == ZlibUtils::GzipCrcStatus::Mismatch ||
+                           (status == ZlibUtils::GzipCrcStatus::Missing && indexed) ||
+                           (status == ZlibUtils::GzipCrcStatus::Valid && indexed && header_crc != static_cast<uint32_t>(row["crc32c"].get<int64_t>()));
+
+            {
+                std::lock_guard<std::mutex> lock(scrub_stats_mutex_);
+                scrub_stats_.files_checked++;
+                scrub_stats_.bytes_checked += data.size();
+                if (status == ZlibUtils::GzipCrcStatus::Missing && !indexed) scrub_stats_.unchecked++;
+                if (corrupt) scrub_stats_.corrupt_found++;
+            }
+
+            if (corrupt) {
+                log_error("Scrubber found corrupt frame " + file_path);
+                std::error_code ec;
+                if (fs::remove(file_path, ec)) {
+                    std::lock_guard<std::mutex> lock(stats_mutex_);
+                    total_disk_usage_ -= data.size();
+                    total_frame_count_--;
+                }
+                db_->execute_params("DELETE FROM levelii_frames WHERE rowid = ?;", {std::to_string(cursor)});
+                if (on_corrupt) on_corrupt(station, product, timestamp, filename);
+            }
+
+            auto budget = std::chrono::milliseconds(static_cast<int64_t>(data.size() / bytes_per_ms));
+            if (budget.count() > 0 && !scrubber_wait(budget)) break;
+        }
+    }
+}
+
+void FrameStorageManager::enable_tiering(const TieringConfig& config) {
+    stop_tiering();
+    db_->execute(
+        "CREATE TABLE IF NOT EXISTS levelii_tiers ("
+        "    station TEXT,"
+        "    product_name TEXT,"
+        "    timestamp TEXT,"
+        "    tier INTEGER,"
+        "    PRIMARY KEY (station, product_name, timestamp)"
+        ");");
+
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        tiering_ = config;
+        // Tier numbers follow age, whatever order the tiers were listed in
+        std::stable_sort(tiering_.tiers.begin(), tiering_.tiers.end(),
+                         [](const TieringConfig::Tier& a, const TieringConfig::Tier& b) { return a.min_age_minutes < b.min_age_minutes; });
+        volume_tiers_.clear();
+        stale_copies_.clear();
+        for (const auto& row : db_->query("SELECT station, product_name, timestamp, tier FROM levelii_tiers;")) {
+            std::string key = volume_key(row["station"], row["product_name"], row["timestamp"]);
+            int tier = row["tier"].is_number() ? row["tier"].get<int>() : 0;
+            if (tier > 0 && tier <= static_cast<int>(config.tiers.size())) {
+                volume_tiers_[key] = tier;
+            } else {
+                log_error("Volume " + key + " is recorded in tier " + std::to_string(tier) + ", which is not configured");
+            }
+        }
+    }
+
+    // A move interrupted before its commit leaves a partial copy in the target tier, one interrupted after it
+    // leaves the old copy behind. Either way the copy the index names is complete: drop the other one. Copies
+    // the index does not know about at all are adopted where they are.
+    for (int tier = 0; tier <= static_cast<int>(config.tiers.size()); ++tier) {
+        const std::string root = tier_root(tier);
+        ensure_directory_exists(root);
+        std::error_code ec;
+        int64_t usage = 0;
+        int count = 0;
+        for (const auto& station_entry : fs::directory_iterator(root, ec)) {
+            if (!station_entry.is_directory() || station_entry.path().filename() == "_timeseries") continue;
+            std::string station = station_entry.path().filename().string();
+            for (const auto& prod_entry : fs::directory_iterator(station_entry, ec)) {
+                if (!prod_entry.is_directory()) continue;
+                std::string product = prod_entry.path().filename().string();
+                for (const auto& ts_entry : fs::directory_iterator(prod_entry, ec)) {
+                    if (!ts_entry.is_directory()) continue;
+                    std::string timestamp = ts_entry.path().filename().string();
+                    int64_t dir_usage = 0;
+                    int dir_count = 0;
+                    for (const auto& entry : fs::directory_iterator(ts_entry, ec)) {
+                        if (!entry.is_regular_file()) continue;
+                        dir_usage += entry.file_size();
+                        if (entry.path().extension() == ".RDA") dir_count++;
+                    }
+
+                    // The constructor already counted everything under base_path
+                    int recorded = volume_tier(station, product, timestamp);
+                    if (recorded == tier) {
+                        if (tier == 0) continue;
+                    } else if (fs::exists(volume_dir(station, product, timestamp))) {
+                        log_info("Removing leftover copy " + ts_entry.path().string());
+                        fs::remove_all(ts_entry.path(), ec);
+                        if (tier > 0) continue;
+                        dir_usage = -dir_usage;
+                        dir_count = -dir_count;
+                    } else {
+                        if (tier > 0) {
+                            db_->execute_params("INSERT OR REPLACE INTO levelii_tiers (station, product_name, timestamp, tier) VALUES (?, ?, ?, ?);",
+                                                {station, product, timestamp, std::to_string(tier)});
+                        } else {
+                            db_->execute_params("DELETE FROM levelii_tiers WHERE station = ? AND product_name = ? AND timestamp = ?;",
+                                                {station, product, timestamp});
+                        }
+                        std::lock_guard<std::mutex> lock(tier_mutex_);
+                        if (tier > 0) {
+                            volume_tiers_[volume_key(station, product, timestamp)] = tier;
+                        } else {
+                            volume_tiers_.erase(volume_key(station, product, timestamp));
+                            continue;
+                        }
+                    }
+                    usage += dir_usage;
+                    count += dir_count;
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        total_disk_usage_ += usage;
+        total_frame_count_ += count;
+    }
+
+    tiering_stop_.store(false);
+    if (config.scan_interval_seconds > 0) {
+        tiering_thread_ = std::thread([this]() { tiering_loop(); });
+    }
+}
+
+void FrameStorageManager::stop_tiering() {
+    if (!tiering_thread_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(tiering_wait_mutex_);
+        tiering_stop_.store(true);
+    }
+    tiering_cv_.notify_all();
+    tiering_thread_.join();
+}
+
+bool FrameStorageManager::tiering_wait(std::chrono::milliseconds duration) {
+    std::unique_lock<std::mutex> lock(tiering_wait_mutex_);
+    return !tiering_cv_.wait_for(lock, duration, [this]() { return tiering_stop_.load(); });
+}
+
+void FrameStorageManager::tiering_loop() {
+    while (!tiering_stop_.load()) {
+        migrate_tiers();
+        if (!tiering_wait(std::chrono::seconds(tiering_.scan_interval_seconds))) break;
+    }
+}
+
+std::string FrameStorageManager::tier_root(int tier) const {
+    return tier == 0 ? base_path_ : tiering_.tiers[tier - 1].root;
+}
+
+int FrameStorageManager::tier_level(int tier) const {
+    int level = tier > 0 ? tiering_.tiers[tier - 1].gzip_level : 0;
+    if (level <= 0) level = tiering_enabled() ? tiering_.hot_gzip_level : 9;
+    return std::clamp(level, 1, ZlibUtils::max_level());
+}
+
+std::string FrameStorageManager::volume_dir(const std::string& station, const std::string& product, const std::string& timestamp, bool read, int* tier) const {
+    int found = 0;
+    if (tiering_enabled()) {
+        std::string key = volume_key(station, product, timestamp);
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        if (read) volume_reads_[key]++;
+        auto it = volume_tiers_.find(key);
+        if (it != volume_tiers_.end()) found = it->second;
+    }
+    if (tier) *tier = found;
+    return tier_root(found) + "/" + station + "/" + product + "/" + timestamp;
+}
+
+int FrameStorageManager::volume_tier(const std::string& station, const std::string& product, const std::string& timestamp) const {
+    int tier = 0;
+    volume_dir(station, product, timestamp, false, &tier);
+    return tier;
+}
+
+FrameStorageManager::TieringStats FrameStorageManager::get_tiering_stats() const {
+    std::lock_guard<std::mutex> lock(tier_mutex_);
+    return tiering_stats_;
+}
+
+size_t FrameStorageManager::migrate_tiers() {
+    if (!tiering_enabled()) return 0;
+    {
+        std::lock_guard<std::mutex> pass(migrate_mutex_);
+        remove_stale_copies();
+    }
+
+    std::unordered_map<std::string, int> reads;
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        reads.swap(volume_reads_);
+    }
+
+    const std::time_t now = std::time(nullptr);
+    const int tier_count = static_cast<int>(tiering_.tiers.size());
+    const double bytes_per_ms = std::max<size_t>(tiering_.bytes_per_second, 1) / 1000.0;
+    json volumes = db_->query(
+        "SELECT DISTINCT f.station, f.product_name, f.timestamp, COALESCE(t.tier, 0) AS tier FROM levelii_frames f "
+        "LEFT JOIN levelii_tiers t ON t.station = f.station AND t.product_name = f.product_name AND t.timestamp = f.timestamp;");
+
+    size_t moved = 0;
+    for (const auto& row : volumes) {
+        if (tiering_stop_.load()) break;
+        std::string station = row["station"];
+        std::string product = row["product_name"];
+        std::string timestamp = row["timestamp"];
+        const int from = row["tier"].get<int>();
+        const std::time_t taken = parse_timestamp(timestamp);
+        if (taken < 0 || from > tier_count) continue;
+
+        int to = 0;
+        for (int i = 0; i < tier_count; ++i) {
+            if ((now - taken) / 60 >= tiering_.tiers[i].min_age_minutes) to = i + 1;
+        }
+        // Volumes read since the last pass are not demoted; frequently read ones come back to the hot tier
+        auto it = reads.find(volume_key(station, product, timestamp));
+        const int read_count = it == reads.end() ? 0 : it->second;
+        if (read_count >= tiering_.hot_reads) {
+            to = 0;
+        } else if (read_count > 0 && to > from) {
+            to = from;
+        }
+        if (to == from) continue;
+
+        // Held per volume so cleanup can run between moves; the throttle sleeps outside it
+        size_t bytes_read = 0;
+        {
+            std::lock_guard<std::mutex> pass(migrate_mutex_);
+            if (move_volume(station, product, timestamp, from, to, bytes_read)) moved++;
+        }
+        auto budget = std::chrono::milliseconds(static_cast<int64_t>(bytes_read / bytes_per_ms));
+        if (budget.count() > 0 && !tiering_wait(budget)) break;
+    }
+
+    std::lock_guard<std::mutex> lock(tier_mutex_);
+    tiering_stats_.scans_completed++;
+    return moved;
+}
+
+bool FrameStorageManager::move_volume(const std::string& station, const std::string& product, const std::string& timestamp, int from, int to,
+                                      size_t& bytes_read) {
+    const std::string source = tier_root(from) + "/" + station + "/" + product + "/" + timestamp;
+    const std::string target = tier_root(to) + "/" + station + "/" + product + "/" + timestamp;
+    // Level 0 copies files unchanged; promotions are re-encoded at the hot level
+    const int level = to == 0 ? tier_level(0) : std::min(tiering_.tiers[to - 1].gzip_level, ZlibUtils::max_level());
+
+    std::vector<std::string> files;
+    std::error_code ec;
+    for (const auto& entry : fs::directory_iterator(source, ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".RDA") files.push_back(entry.path().filename().string());
+    }
+    if (files.empty() || !ensure_directory_exists(target)) return false;
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> statements;
+    std::vector<std::string> written;
+    size_t bytes_written = 0;
+    bool ok = true;
+    for (const auto& filename : files) {
+        std::ifstream in(source + "/" + filename, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::vector<uint8_t> encoded;
+        // A corrupt file stays where it is for the scrubber rather than being carried into another tier
+        if (data.empty() || ZlibUtils::verify_gzip_crc(data.data(), data.size()) == ZlibUtils::GzipCrcStatus::Mismatch ||
+            (level > 0 && !recompress_frame(data, level, encoded, source + "/" + filename))) {
+            log_error("Cannot move " + source + "/" + filename + " to tier " + std::to_string(to));
+            ok = false;
+            break;
+        }
+        const std::vector<uint8_t>& stored = level > 0 ? encoded : data;
+        if (!write_frame_file(target + "/" + filename, stored)) {
+            ok = false;
+            break;
+        }
+        written.push_back(target + "/" + filename);
+        bytes_read += data.size();
+        bytes_written += stored.size();
+        statements.push_back({"UPDATE levelii_frames SET crc32c = NULLIF(CAST(? AS INTEGER), -1) "
+                              "WHERE station = ? AND product_name = ? AND timestamp = ? AND filename = ?;",
+                              {std::to_string(stored_crc(stored)), station, product, timestamp, filename}});
+        if (tiering_stop_.load()) {
+            ok = false;
+            break;
+        }
+    }
+
+    if (ok) {
+        if (to == 0) {
+            statements.push_back({"DELETE FROM levelii_tiers WHERE station = ? AND product_name = ? AND timestamp = ?;",
+                                  {station, product, timestamp}});
+        } else {
+            statements.push_back({"INSERT OR REPLACE INTO levelii_tiers (station, product_name, timestamp, tier) VALUES (?, ?, ?, ?);",
+                                  {station, product, timestamp, std::to_string(to)}});
+        }
+        ok = db_->execute_transaction(statements);
+    }
+
+    if (!ok) {
+        for (const auto& path : written) fs::remove(path, ec);
+        fs::remove(target, ec);
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        tiering_stats_.failures++;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        if (to == 0) {
+            volume_tiers_.erase(volume_key(station, product, timestamp));
+        } else {
+            volume_tiers_[volume_key(station, product, timestamp)] = to;
+        }
+        stale_copies_.push_back(source);
+        (to < from ? tiering_stats_.volumes_promoted : tiering_stats_.volumes_demoted)++;
+        tiering_stats_.bytes_read += bytes_read;
+        tiering_stats_.bytes_written += bytes_written;
+    }
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        total_disk_usage_ += bytes_written;
+        total_frame_count_ += static_cast<int>(files.size());
+    }
+    log_info("Moved " + volume_key(station, product, timestamp) + " from tier " + std::to_string(from) + " to " + std::to_string(to));
+    return true;
+}
+
+void FrameStorageManager::remove_stale_copies() {
+    std::vector<std::string> stale;
+    {
+        std::lock_guard<std::mutex> lock(tier_mutex_);
+        stale.swap(stale_copies_);
+    }
+    for (const auto& dir : stale) {
+        size_t usage = 0;
+        int count = 0;
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(dir, ec)) {
+            if (!entry.is_regular_file()) continue;
+            usage += entry.file_size();
+            if (entry.path().extension() == ".RDA") count++;
+        }
+        fs::remove_all(dir, ec);
+        // Product and station directories go too once empty; remove() leaves non-empty ones alone
+        fs::path product_dir = fs::path(dir).parent_path();
+        fs::remove(product_dir, ec);
+        fs::remove(product_dir.parent_path(), ec);
+
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        total_disk_usage_ -= usage;
+        total_frame_count_ -= count;
+    }
+}
+
 void FrameStorageManager::cleanup_old_frames(int max_frames_per_station) {
     if (!fs::exists(base_path_)) return;
-    
-    for (const auto& station_entry : fs::directory_iterator(base_path_)) {
-        if (!station_entry.is_directory()) continue;
-        
-        std::unordered_map<std::string, std::vector<std::string>> products;
-        for (const auto& prod_entry : fs::directory_iterator(station_entry)) {
-            if (!prod_entry.is_directory()) continue;
-            for (const auto& ts_entry : fs::directory_iterator(prod_entry)) {
-                if (ts_entry.is_directory()) products[prod_entry.path().filename().string()].push_back(ts_entry.path().filename().string());
+    // Not while a volume is half copied between tiers
+    std::lock_guard<std::mutex> pass(migrate_mutex_);
+
+    if (timeseries_) {
+        std::time_t cutoff = std::time(nullptr) - static_cast<std::time_t>(timeseries_retention_hours_) * 3600;
+        std::tm tm_utc{};
+        gmtime_r(&cutoff, &tm_utc);
+        char cutoff_ts[16];
+        std::strftime(cutoff_ts, sizeof(cutoff_ts), "%Y%m%d_%H%M%S", &tm_utc);
+        timeseries_->prune_before(cutoff_ts);
+    }
+
+    // A station's volumes can be spread over every tier root
+    std::vector<std::string> roots;
+    for (int tier = 0; tier <= static_cast<int>(tiering_.tiers.size()); ++tier) {
+        if (fs::exists(tier_root(tier))) roots.push_back(tier_root(tier));
+    }
+    std::map<std::string, std::unordered_map<std::string, std::vector<std::string>>> stations;
+    for (const auto& root : roots) {
+        for (const auto& station_entry : fs::directory_iterator(root)) {
+            if (!station_entry.is_directory()) continue;
+            if (station_entry.path().filename() == "_timeseries") continue;
+
+            auto& products = stations[station_entry.path().filename().string()];
+            for (const auto& prod_entry : fs::directory_iterator(station_entry)) {
+                if (!prod_entry.is_directory()) continue;
+                for (const auto& ts_entry : fs::directory_iterator(prod_entry)) {
+                    if (ts_entry.is_directory()) products[prod_entry.path().filename().string()].push_back(ts_entry.path().filename().string());
+                }
             }
         }
-        
+    }
+
+    for (auto& [station, products] : stations) {
         for (auto& [prod, timestamps] : products) {
             std::sort(timestamps.rbegin(), timestamps.rend());
+            // A volume just moved between tiers has two copies until the next pass
+            timestamps.erase(std::unique(timestamps.begin(), timestamps.end()), timestamps.end());
             if (timestamps.size() > static_cast<size_t>(max_frames_per_station)) {
                 for (size_t i = max_frames_per_station; i < timestamps.size(); ++i) {
-                    std::string prod_dir = station_entry.path().string() + "/" + prod + "/" + timestamps[i];
-                    if (fs::exists(prod_dir)) {
+                    // Keep volumes on disk until the sink has confirmed them
+                    if (is_upload_pending(station, prod, timestamps[i])) continue;
+                    for (const auto& root : roots) {
+                        std::string prod_dir = root + "/" + station + "/" + prod + "/" + timestamps[i];
+                        if (!fs::exists(prod_dir)) continue;
                         size_t removed_usage = 0;
                         int removed_count = 0;
                         for (const auto& entry : fs::recursive_directory_iterator(prod_dir)) {
@@ -464,35 +1611,54 @@ void FrameStorageManager::cleanup_old_frames(int max_frames_per_station) {
                             total_disk_usage_ -= removed_usage;
                             total_frame_count_ -= removed_count;
                         }
-                        
+
                         // Cleanup empty parent product directory
-                        fs::path prod_dir = fs::path(prod_dir).parent_path();
-                        if (fs::is_empty(prod_dir)) {
-                            fs::remove(prod_dir);
+                        fs::path product_dir = fs::path(prod_dir).parent_path();
+                        if (fs::is_empty(product_dir)) {
+                            fs::remove(product_dir);
                         }
                     }
+                    if (object_sink_) {
+                        db_->execute_params("DELETE FROM levelii_uploads WHERE station = ? AND product_name = ? AND timestamp = ?;",
+                                            {station, prod, timestamps[i]});
+                    }
+                    if (tiering_enabled()) {
+                        db_->execute_params("DELETE FROM levelii_tiers WHERE station = ? AND product_name = ? AND timestamp = ?;",
+                                            {station, prod, timestamps[i]});
+                        std::lock_guard<std::mutex> lock(tier_mutex_);
+                        volume_tiers_.erase(volume_key(station, prod, timestamps[i]));
+                    }
                 }
             }
-            db_->purge_old_records("levelii_frames", station_entry.path().filename().string(), max_frames_per_station);
-        }
-        
-        // Cleanup empty station directory (no timestamp directories left)
-        bool has_timestamp_dirs = false;
-        for (const auto& entry : fs::directory_iterator(station_entry)) {
-            if (entry.is_directory()) {
-                has_timestamp_dirs = true;
-                break;
-            }
+            db_->purge_old_records("levelii_frames", station, max_frames_per_station);
+            // Source keys are kept for requeueing corrupt volumes, so only while the volume has frames
+            db_->execute_params("DELETE FROM levelii_work_sources WHERE station = ? AND "
+                                "timestamp NOT IN (SELECT timestamp FROM levelii_frames WHERE station = ?);",
+                                {station, station});
         }
-        
-        if (!has_timestamp_dirs) {
-            for (const auto& entry : fs::directory_iterator(station_entry)) {
-                if (entry.is_regular_file()) {
-                    fs::remove(entry.path());
+
+        for (const auto& root : roots) {
+            fs::path station_dir = fs::path(root) / station;
+            if (!fs::exists(station_dir)) continue;
+
+            // Cleanup empty station directory (no timestamp directories left)
+            bool has_timestamp_dirs = false;
+            for (const auto& entry : fs::directory_iterator(station_dir)) {
+                if (entry.is_directory()) {
+                    has_timestamp_dirs = true;
+                    break;
                 }
             }
-            if (fs::is_empty(station_entry)) {
-                fs::remove(station_entry);
+
+            if (!has_timestamp_dirs) {
+                for (const auto& entry : fs::directory_iterator(station_dir)) {
+                    if (entry.is_regular_file()) {
+                        fs::remove(entry.path());
+                    }
+                }
+                if (fs::is_empty(station_dir)) {
+                    fs::remove(station_dir);
+                }
             }
         }
     }
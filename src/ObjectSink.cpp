@@ -0,0 +1,288 @@
+/**
+ * ObjectSink.cpp - Implementation
+ */
+
+#include "levelii/ObjectSink.h"
+#include <nlohmann/json.hpp>
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+using json = nlohmann::json;
+
+namespace {
+    constexpr char PACK_MAGIC[4] = {'R', 'D', 'A', 'P'};
+
+    void log_error(const std::string& msg) {
+        std::cerr << "❌ " << msg << std::endl;
+    }
+
+    // The packed layout is read by other tools, so it is little-endian whatever the host is
+    void append_le32(std::vector<uint8_t>& out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+
+    uint32_t read_le32(const uint8_t* data) {
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(data[i]) << (8 * i);
+        return value;
+    }
+}
+
+ObjectSink::ObjectSink(std::unique_ptr<ObjectStoreClient> client, const ObjectSinkConfig& config, CompletionCallback on_complete)
+    : client_(std::move(client)), config_(config), on_complete_(std::move(on_complete)) {
+    int workers = std::max(1, config_.max_concurrent_uploads);
+    for (int i = 0; i < workers; ++i) {
+        workers_.emplace_back([this]() { this->worker_loop(); });
+    }
+}
+
+ObjectSink::~ObjectSink() {
+    shutdown();
+}
+
+bool ObjectSink::enqueue(Volume volume) {
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        space_cv_.wait(lock, [this]() {
+            return queue_.size() < config_.max_queued_volumes || stop_;
+        });
+        if (stop_) return false;
+        queue_.push_back({std::move(volume), 0});
+    }
+    queue_cv_.notify_one();
+    return true;
+}
+
+void ObjectSink::flush() {
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+    idle_cv_.wait(lock, [this]() {
+        return stop_ || (queue_.empty() && in_flight_ == 0);
+    });
+}
+
+void ObjectSink::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (stop_ && workers_.empty()) return;
+        stop_ = true;
+        queue_.clear();
+        retry_.clear();
+    }
+    queue_cv_.notify_all();
+    space_cv_.notify_all();
+    idle_cv_.notify_all();
+    stop_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+}
+
+ObjectSink::Stats ObjectSink::get_stats() const {
+    Stats stats;
+    stats.volumes_uploaded = volumes_uploaded_.load();
+    stats.volumes_failed = volumes_failed_.load();
+    stats.bytes_uploaded = bytes_uploaded_.load();
+    stats.retries = retries_.load();
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stats.queued = queue_.size();
+    stats.in_flight = in_flight_;
+    stats.waiting_retry = retry_.size();
+    return stats;
+}
+
+std::string ObjectSink::object_key(const std::string& station, const std::string& product, const std::string& timestamp) const {
+    std::string key = station + "/" + product + "/" + timestamp + ".rdapack";
+    return config_.key_prefix.empty() ? key : config_.key_prefix + "/" + key;
+}
+
+void ObjectSink::worker_loop() {
+    while (true) {
+        Queued item;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            // New volumes first; a failed one goes back in once its delay is up
+            while (!stop_ && queue_.empty()) {
+                if (retry_.empty()) {
+                    queue_cv_.wait(lock);
+                    continue;
+                }
+                auto due = retry_.begin()->first;
+                if (due <= std::chrono::steady_clock::now()) {
+                    queue_.push_back(std::move(retry_.begin()->second));
+                    retry_.erase(retry_.begin());
+                } else {
+                    queue_cv_.wait_until(lock, due);
+                }
+            }
+            if (stop_) break;
+            item = std::move(queue_.front());
+            queue_.pop_front();
+            in_flight_++;
+        }
+        space_cv_.notify_one();
+        const Volume& volume = item.volume;
+
+        std::string key = object_key(volume.station, volume.product, volume.timestamp);
+        std::vector<uint8_t> packed = pack_volume(volume);
+
+        bool success = false;
+        if (packed.empty()) {
+            log_error("Failed to pack volume " + key);
+        } else {
+            success = upload(key, packed);
+        }
+
+        if (success) {
+            volumes_uploaded_.fetch_add(1);
+            bytes_uploaded_.fetch_add(packed.size());
+        } else {
+            volumes_failed_.fetch_add(1);
+        }
+
+        if (on_complete_) {
+            try {
+                on_complete_(volume, key, success);
+            } catch (const std::exception& e) {
+                log_error("Upload completion callback failed: " + std::string(e.what()));
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex_);
+            in_flight_--;
+            // An unreadable volume is not retried here; the caller republishes it from what is on disk
+            if (!success && !packed.empty() && !stop_) {
+                int64_t delay_ms = config_.volume_retry_base_ms;
+                for (int i = 0; i < item.failures && delay_ms < config_.volume_retry_max_ms; ++i) delay_ms *= 2;
+                delay_ms = std::min<int64_t>(delay_ms, config_.volume_retry_max_ms);
+                item.failures++;
+                retry_.emplace(std::chrono::steady_clock::now() + std::chrono::milliseconds(delay_ms), std::move(item));
+            }
+        }
+        queue_cv_.notify_one();
+        idle_cv_.notify_all();
+    }
+}
+
+bool ObjectSink::with_retry(const std::string& what, const std::function<bool(std::string&)>& request) {
+    int delay_ms = config_.retry_base_delay_ms;
+    for (int attempt = 0; attempt <= config_.max_retries; ++attempt) {
+        std::string error;
+        if (request(error)) return true;
+
+        if (attempt == config_.max_retries) {
+            log_error(what + " failed after " + std::to_string(attempt + 1) + " attempts: " + error);
+            break;
+        }
+        retries_.fetch_add(1);
+
+        // Back off, but wake immediately on shutdown
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        if (stop_cv_.wait_for(lock, std::chrono::milliseconds(delay_ms), [this]() { return stop_; })) {
+            return false;
+        }
+        delay_ms *= 2;
+    }
+    return false;
+}
+
+bool ObjectSink::upload(const std::string& key, const std::vector<uint8_t>& data) {
+    if (data.size() <= config_.multipart_threshold || config_.part_size == 0) {
+        return with_retry("PutObject " + key, [&](std::string& error) {
+            return client_->put_object(key, data.data(), data.size(), error);
+        });
+    }
+
+    std::string upload_id;
+    if (!with_retry("CreateMultipartUpload " + key, [&](std::string& error) {
+            return client_->create_multipart_upload(key, upload_id, error);
+        })) {
+        return false;
+    }
+
+    std::vector<std::string> etags;
+    for (size_t offset = 0; offset < data.size(); offset += config_.part_size) {
+        size_t size = std::min(config_.part_size, data.size() - offset);
+        int part_number = static_cast<int>(etags.size()) + 1;
+        std::string etag;
+        if (!with_retry("UploadPart " + key + " #" + std::to_string(part_number), [&](std::string& error) {
+                return client_->upload_part(key, upload_id, part_number, data.data() + offset, size, etag, error);
+            })) {
+            client_->abort_multipart_upload(key, upload_id);
+            return false;
+        }
+        etags.push_back(etag);
+    }
+
+    if (!with_retry("CompleteMultipartUpload " + key, [&](std::string& error) {
+            return client_->complete_multipart_upload(key, upload_id, etags, error);
+        })) {
+        client_->abort_multipart_upload(key, upload_id);
+        return false;
+    }
+    return true;
+}
+
+std::vector<uint8_t> ObjectSink::pack_volume(const Volume& volume) {
+    json files = json::array();
+    std::vector<std::vector<uint8_t>> contents;
+    contents.reserve(volume.files.size());
+
+    uint64_t offset = 0;
+    for (const auto& [name, path] : volume.files) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return {};
+        size_t size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        std::vector<uint8_t> bytes(size);
+        if (!file.read(reinterpret_cast<char*>(bytes.data()), size)) return {};
+
+        files.push_back({{"n", name}, {"o", offset}, {"z", size}});
+        offset += size;
+        contents.push_back(std::move(bytes));
+    }
+
+    json header = {
+        {"s", volume.station}, {"p", volume.product}, {"t", volume.timestamp}, {"files", files}
+    };
+    std::string header_str = header.dump();
+    uint32_t header_size = header_str.size();
+
+    std::vector<uint8_t> packed;
+    packed.reserve(sizeof(PACK_MAGIC) + 4 + header_size + offset);
+    packed.insert(packed.end(), PACK_MAGIC, PACK_MAGIC + sizeof(PACK_MAGIC));
+    append_le32(packed, header_size);
+    packed.insert(packed.end(), header_str.begin(), header_str.end());
+    for (const auto& bytes : contents) {
+        packed.insert(packed.end(), bytes.begin(), bytes.end());
+    }
+    return packed;
+}
+
+bool ObjectSink::unpack_volume(const uint8_t* data, size_t size, std::vector<std::pair<std::string, std::vector<uint8_t>>>& out_files) {
+    out_files.clear();
+    if (size < sizeof(PACK_MAGIC) + 4 || std::memcmp(data, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0) return false;
+
+    uint32_t header_size = read_le32(data + sizeof(PACK_MAGIC));
+    size_t payload_start = sizeof(PACK_MAGIC) + 4 + static_cast<size_t>(header_size);
+    if (payload_start > size) return false;
+
+    try {
+        json header = json::parse(data + sizeof(PACK_MAGIC) + 4, data + payload_start);
+        for (const auto& f : header["files"]) {
+            uint64_t offset = f["o"];
+            uint64_t file_size = f["z"];
+            if (payload_start + offset + file_size > size) return false;
+            const uint8_t* begin = data + payload_start + offset;
+            out_files.emplace_back(f["n"].get<std::string>(), std::vector<uint8_t>(begin, begin + file_size));
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return true;
+}
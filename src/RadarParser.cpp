@@ -5,6 +5,7 @@
 #include "levelii/NEXRAD_Types.h"
 #include "levelii/ByteReader.h"
 #include "levelii/MessageSegmenter.h"
+#include "levelii/ParallelFor.h"
 #include <iostream>
 #include <vector>
 #include <string>
@@ -14,6 +15,11 @@
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace {
 
@@ -65,6 +71,408 @@ std::string format_timestamp(uint32_t julian_day, uint32_t ms) {
     return std::string(buffer);
 }
 
+// ============================================================================
+// Volume plan (Message 5) and per-sweep moment decoding
+// ============================================================================
+
+bool decode_volume_plan(const uint8_t* payload, size_t size, VolumePlan& plan) {
+    auto header = nexrad::safe_read_struct<nexrad::Message5Header>(payload, size, 0, "Message5Header");
+    if (!header) return false;
+    uint16_t num_cuts = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&(*header)->num_cuts));
+    if (num_cuts == 0 || num_cuts > 32 ||
+        nexrad::MESSAGE5_HEADER_SIZE + static_cast<size_t>(num_cuts) * nexrad::MESSAGE5_CUT_SIZE > size) {
+        return false;
+    }
+
+    plan.vcp_number = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&(*header)->pattern_number));
+    plan.cuts.resize(num_cuts);
+    for (uint16_t i = 0; i < num_cuts; ++i) {
+        const auto* cut = reinterpret_cast<const nexrad::Message5ElevationCut*>(
+            payload + nexrad::MESSAGE5_HEADER_SIZE + i * nexrad::MESSAGE5_CUT_SIZE);
+        auto& planned = plan.cuts[i];
+        planned.elevation_deg = static_cast<float>(read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&cut->elevation_angle))) * (180.0f / 32768.0f);
+        planned.waveform = cut->waveform;
+        planned.channel_config = cut->channel_config;
+        planned.super_res = cut->super_res;
+        planned.expected_radials = (cut->super_res & nexrad::SUPER_RES_HALF_DEGREE_AZIMUTH) ? 720 : 360;
+    }
+    return true;
+}
+
+// A Message 31 (or legacy Message 1) radial whose moment data is decoded when its sweep closes
+struct PendingRadial {
+    const uint8_t* payload;
+    size_t size;
+    float azimuth;
+    bool legacy = false;  // Message 1: reflectivity only, at fixed offsets
+};
+
+struct MomentView {
+    uint16_t num_gates;
+    uint16_t word_size;
+    float first_gate;
+    float gate_spacing;
+    float scale;
+    float offset;
+    const uint8_t* gates;
+};
+
+bool is_moment_block(const char* name, uint8_t moment) {
+    switch (moment) {
+        case 1: return strncmp(name, "REF", 3) == 0;
+        case 2: return strncmp(name, "VEL", 3) == 0;
+        case 3: return strncmp(name, "SW", 2) == 0;
+        case 4: return strncmp(name, "ZDR", 3) == 0;
+        case 5: return strncmp(name, "PHI", 3) == 0;
+        case 6: return strncmp(name, "RHO", 3) == 0;
+        default: return false;
+    }
+}
+
+bool find_moment(const PendingRadial& radial, uint8_t moment, MomentView& out) {
+    if (radial.legacy) {
+        if (moment != 1 || radial.size < 46) return false;
+        uint16_t num_gates = read_be<uint16_t>(radial.payload + 24);
+        if (num_gates == 0 || radial.size < static_cast<size_t>(46 + num_gates)) return false;
+        out = {num_gates, 8, static_cast<float>(read_be<uint16_t>(radial.payload + 20)),
+               static_cast<float>(read_be<uint16_t>(radial.payload + 22)), 2.0f, 66.0f, radial.payload + 46};
+        return true;
+    }
+
+    const auto* m31 = reinterpret_cast<const nexrad::Message31Header*>(radial.payload);
+    uint16_t block_count = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&m31->block_count));
+    for (uint16_t b = 0; b < block_count; ++b) {
+        uint32_t b_off = read_be<uint32_t>(reinterpret_cast<const uint8_t*>(&m31->block_pointers[b]));
+        if (!nexrad::safe_pointer_dereference(b_off, sizeof(nexrad::DataBlock_Header), radial.size, "DBH")) continue;
+        const auto* block_hdr = reinterpret_cast<const nexrad::DataBlock_Header*>(radial.payload + b_off);
+        if (block_hdr->type != 'D' || !is_moment_block(block_hdr->name, moment)) continue;
+
+        auto moment_opt = nexrad::safe_read_struct<nexrad::DataBlock_Moment>(radial.payload, radial.size, b_off, "DBM");
+        if (!moment_opt) continue;
+        const nexrad::DataBlock_Moment* block = *moment_opt;
+        out.num_gates = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&block->num_gates));
+        out.first_gate = static_cast<float>(read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&block->first_gate)));
+        out.gate_spacing = static_cast<float>(read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&block->gate_spacing)));
+        out.scale = read_be_float(reinterpret_cast<const uint8_t*>(&block->scale));
+        out.offset = read_be_float(reinterpret_cast<const uint8_t*>(&block->offset));
+        out.word_size = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&block->data_word_size));
+        if (out.word_size == 0) out.word_size = 8;
+        if (out.num_gates == 0 || out.num_gates > 8000 || out.gate_spacing == 0 || (out.word_size != 8 && out.word_size != 16)) continue;
+
+        size_t data_size = static_cast<size_t>(out.num_gates) * (out.word_size / 8);
+        if (b_off + sizeof(nexrad::DataBlock_Moment) + data_size > radial.size) continue;
+        out.gates = radial.payload + b_off + sizeof(nexrad::DataBlock_Moment);
+        return true;
+    }
+    return false;
+}
+
+// Decoded gate value; `kept` is false for below-threshold and range-folded codes
+float decode_gate(uint16_t raw, const MomentView& view, uint8_t moment, bool& kept) {
+    kept = false;
+    if (raw <= 1) return 0.0f;
+    float val = (static_cast<float>(raw) - view.offset) / view.scale;
+    if (moment == 1 && val < -32.0f) return 0.0f;
+    kept = true;
+    return quantize_value_internal(val, QUANTIZE_VALUES_DEFAULT);
+}
+
+// decode_gate for every 8-bit code under the current scale/offset
+struct MomentTable {
+    bool ready = false;
+    float scale = 0.0f;
+    float offset = 0.0f;
+    float value[256];
+    bool keep[256];
+
+    void prepare(const MomentView& view, uint8_t moment) {
+        if (ready && view.scale == scale && view.offset == offset) return;
+        ready = true;
+        scale = view.scale;
+        offset = view.offset;
+        for (int raw = 0; raw < 256; ++raw) value[raw] = decode_gate(static_cast<uint16_t>(raw), view, moment, keep[raw]);
+    }
+};
+
+// Gate geometry a sweep reports back for the frame and the volume plan
+struct SweepGeometry {
+    uint16_t first_radial_gates = 0;  // Gates on the first radial carrying the moment
+    bool has_range = false;           // A radial with more than 10 gates was seen
+    uint16_t num_gates = 0;           // Output bins per radial after windowing and striding
+    float gate_spacing = 0.0f;
+    float first_gate = 0.0f;
+};
+
+// Gates [begin, end) of a radial that lie inside the requested range window
+struct GateWindow {
+    uint16_t begin = 0;
+    uint16_t end = 0;
+};
+
+GateWindow gate_window(const MomentView& view, const ParseOptions& options) {
+    GateWindow window{0, view.num_gates};
+    if (view.gate_spacing <= 0.0f) return window;
+    if (options.min_range_meters > view.first_gate) {
+        double first = std::ceil((options.min_range_meters - view.first_gate) / view.gate_spacing);
+        window.begin = static_cast<uint16_t>(std::min<double>(first, view.num_gates));
+    }
+    if (options.max_range_meters > 0.0f) {
+        double last = std::floor((options.max_range_meters - view.first_gate) / view.gate_spacing);
+        window.end = last < 0.0 ? 0 : static_cast<uint16_t>(std::min<double>(last + 1.0, view.num_gates));
+    }
+    if (window.end < window.begin) window.end = window.begin;
+    return window;
+}
+
+size_t gate_stride(const ParseOptions& options) {
+    return static_cast<size_t>(std::max(options.gate_stride, 1));
+}
+
+// Bin grid a radial with this geometry produces under `options`
+void set_sweep_range(const MomentView& view, const ParseOptions& options, SweepGeometry& geometry) {
+    GateWindow window = gate_window(view, options);
+    size_t stride = gate_stride(options);
+    geometry.has_range = true;
+    geometry.num_gates = static_cast<uint16_t>((window.end - window.begin + stride - 1) / stride);
+    geometry.gate_spacing = view.gate_spacing * static_cast<float>(stride);
+    geometry.first_gate = view.first_gate + static_cast<float>(window.begin) * view.gate_spacing;
+}
+
+/**
+ * Decode the bins of one radial that fall inside the range window, appending
+ * (azimuth, range, value) rows to `out`, or only counting them when `out` is
+ * null. Gates outside the window, and the gates a Sample stride skips, are
+ * never read.
+ */
+size_t decode_radial(const MomentView& view, float azimuth, uint8_t moment, MomentTable& table,
+                     const ParseOptions& options, std::vector<float>* out) {
+    const GateWindow window = gate_window(view, options);
+    const size_t stride = gate_stride(options);
+    const bool reduce = stride > 1 && options.reduction != GateReduction::Sample;
+    if (view.word_size == 8) table.prepare(view, moment);
+
+    if (!out && !reduce && view.word_size == 8) {
+        size_t bins = 0;
+        for (size_t g = window.begin; g < window.end; g += stride) bins += table.keep[view.gates[g]];
+        return bins;
+    }
+
+    auto gate = [&](size_t g, bool& kept) {
+        if (view.word_size == 8) {
+            uint8_t raw = view.gates[g];
+            kept = table.keep[raw];
+            return table.value[raw];
+        }
+        return decode_gate(read_be<uint16_t>(view.gates + g * 2), view, moment, kept);
+    };
+
+    size_t bins = 0;
+    bool kept;
+    for (size_t g = window.begin; g < window.end; g += stride) {
+        float value;
+        if (!reduce) {
+            value = gate(g, kept);
+        } else {
+            const size_t group_end = std::min<size_t>(g + stride, window.end);
+            float sum = 0.0f;
+            float max = std::numeric_limits<float>::lowest();
+            int count = 0;
+            for (size_t i = g; i < group_end; ++i) {
+                float v = gate(i, kept);
+                if (!kept) continue;
+                sum += v;
+                max = std::max(max, v);
+                ++count;
+                if (!out) break;  // Counting only needs to know the group emits a bin
+            }
+            kept = count > 0;
+            if (kept) {
+                value = options.reduction == GateReduction::Max
+                    ? max : quantize_value_internal(sum / static_cast<float>(count), QUANTIZE_VALUES_DEFAULT);
+            }
+        }
+        if (!kept) continue;
+        ++bins;
+        if (out) {
+            out->push_back(azimuth);
+            out->push_back(view.first_gate + static_cast<float>(g) * view.gate_spacing);
+            out->push_back(value);
+        }
+    }
+    return bins;
+}
+
+/**
+ * Decode one moment of one sweep. Bins that will be kept are counted first so
+ * the sweep's bin buffer is allocated exactly once. Touches nothing but `sweep`,
+ * so different sweeps and moments can be decoded concurrently.
+ */
+SweepGeometry decode_sweep_moment(const std::vector<PendingRadial>& radials, uint8_t moment,
+                                  const ParseOptions& options, RadarFrame::Sweep& sweep) {
+    SweepGeometry geometry;
+    MomentTable table;
+    MomentView view;
+    size_t kept_bins = 0;
+    for (const auto& radial : radials) {
+        if (!find_moment(radial, moment, view)) continue;
+        if (geometry.first_radial_gates == 0) geometry.first_radial_gates = view.num_gates;
+        if (!geometry.has_range && view.num_gates > 10) set_sweep_range(view, options, geometry);
+        kept_bins += decode_radial(view, radial.azimuth, moment, table, options, nullptr);
+    }
+    if (kept_bins == 0) return geometry;
+    sweep.bins.reserve(sweep.bins.size() + kept_bins * 3);
+
+    for (const auto& radial : radials) {
+        if (!find_moment(radial, moment, view)) continue;
+        decode_radial(view, radial.azimuth, moment, table, options, &sweep.bins);
+    }
+    return geometry;
+}
+
+/**
+ * Decode every (sweep, product) pair of the volume, on up to options.decode_threads threads.
+ * Geometry is applied afterwards in sweep order, so the result is identical to
+ * decoding serially.
+ */
+void decode_sweeps(std::unordered_map<std::string, std::unique_ptr<RadarFrame>>& frames,
+                   std::unordered_map<std::string, uint8_t>& product_to_moment,
+                   const std::vector<std::vector<PendingRadial>>& sweep_radials,
+                   VolumePlan& plan, const ParseOptions& options) {
+    struct Task {
+        RadarFrame* frame;
+        uint8_t moment;
+        size_t sweep;
+        SweepGeometry geometry;
+    };
+    std::vector<Task> tasks;
+    for (auto& pair : frames) {
+        RadarFrame* frame = pair.second.get();
+        for (size_t i = 0; i < sweep_radials.size() && i < frame->sweeps.size(); ++i) {
+            if (!sweep_radials[i].empty()) tasks.push_back({frame, product_to_moment[pair.first], i, {}});
+        }
+    }
+
+    auto run = [&](Task& task) {
+        task.geometry = decode_sweep_moment(sweep_radials[task.sweep], task.moment, options, task.frame->sweeps[task.sweep]);
+    };
+    if (options.decode_threads <= 1) {
+        for (auto& task : tasks) run(task);
+    } else {
+        // Largest sweeps first so the last task to finish is a short one
+        std::vector<size_t> order(tasks.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return sweep_radials[tasks[a].sweep].size() > sweep_radials[tasks[b].sweep].size();
+        });
+        levelii::parallel_for(order.size(), options.decode_threads, [&](size_t i) { run(tasks[order[i]]); });
+    }
+
+    // Tasks are grouped per frame in sweep order: the first sweep to report a value wins
+    for (auto& task : tasks) {
+        const SweepGeometry& geometry = task.geometry;
+        RadarFrame& frame = *task.frame;
+        uint8_t elevation_num = frame.sweeps[task.sweep].elevation_num;
+        if (geometry.first_radial_gates && elevation_num > 0 && elevation_num <= plan.cuts.size()) {
+            auto& gates = plan.cuts[elevation_num - 1].gates[task.moment];
+            if (gates == 0) gates = geometry.first_radial_gates;
+        }
+        if (frame.ngates == 0 && geometry.has_range) {
+            frame.ngates = geometry.num_gates;
+            frame.gate_spacing_meters = geometry.gate_spacing;
+            frame.range_spacing_meters = geometry.gate_spacing;
+            frame.first_gate_meters = geometry.first_gate;
+        }
+    }
+}
+
+// ============================================================================
+// Archive II resynchronization
+// ============================================================================
+// After corruption or truncation the parser needs the next real message header.
+// Candidates are found with a vectorized prefilter over the fixed header fields
+// (size < 32768 halfwords, type 1..32, julian date > 10000), then confirmed by
+// following the record structure to where the next message must start. Each
+// byte is examined once, so resync is linear in the size of the garbage.
+
+constexpr size_t ARCHIVE2_RECORD_SIZE = 2432;
+constexpr size_t CTM_HEADER_SIZE = 12;
+
+bool plausible_header(const uint8_t* p) {
+    uint8_t type = p[3];
+    uint16_t size_hw = read_be<uint16_t>(p);
+    uint16_t julian = read_be<uint16_t>(p + 6);
+    return type > 0 && type <= 32 && size_hw >= 8 && size_hw < 32768 && julian > 10000;
+}
+
+// Offset of the message following the one whose header is at `pos`, as the main loop advances
+size_t following_message(const uint8_t* data, size_t pos) {
+    uint8_t type = data[pos + 3];
+    size_t size_bytes = static_cast<size_t>(read_be<uint16_t>(data + pos)) * 2;
+    if (size_bytes < ARCHIVE2_RECORD_SIZE - CTM_HEADER_SIZE && type != 31 && type != 29) {
+        return pos + ARCHIVE2_RECORD_SIZE - CTM_HEADER_SIZE;
+    }
+    return pos + size_bytes;
+}
+
+bool confirmed_header(const uint8_t* data, size_t size, size_t pos) {
+    const size_t header_size = sizeof(nexrad::MessageHeader);
+    if (!plausible_header(data + pos)) return false;
+    if (data[pos + 3] == 31) {
+        // Message 31 payload opens with the ICAO radar identifier
+        if (pos + header_size + 4 > size) return false;
+        for (size_t i = 0; i < 4; ++i) {
+            uint8_t c = data[pos + header_size + i];
+            if (!((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9'))) return false;
+        }
+    }
+    size_t next = following_message(data, pos);
+    if (next > size) return false;
+
+    // The chain must continue: padding to end of file, or another plausible header (with or without CTM)
+    size_t limit = std::min(size, next + ARCHIVE2_RECORD_SIZE);
+    while (next < limit && data[next] == 0) next++;
+    if (next == size) return true;
+    for (size_t skip : { size_t(0), CTM_HEADER_SIZE }) {
+        if (next + skip + header_size <= size && plausible_header(data + next + skip)) return true;
+    }
+    return next + header_size > size;
+}
+
+size_t find_next_header(const uint8_t* data, size_t size, size_t from) {
+    const size_t header_size = sizeof(nexrad::MessageHeader);
+    if (size < header_size) return size;
+    const size_t last = size - header_size;
+    size_t pos = from;
+
+#if defined(__SSE2__)
+    // Lane i tests the header at pos + i; reads reach pos + 6 + 15
+    const __m128i max_type = _mm_set1_epi8(31);
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i min_julian_hi = _mm_set1_epi8(0x27);
+    while (pos + 22 <= size && pos <= last) {
+        __m128i size_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        __m128i type = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 3)), one);
+        __m128i julian_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos + 6));
+        __m128i type_ok = _mm_cmpeq_epi8(_mm_min_epu8(type, max_type), type);
+        __m128i julian_ok = _mm_cmpeq_epi8(_mm_max_epu8(julian_hi, min_julian_hi), julian_hi);
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(type_ok, julian_ok))) &
+                        ~static_cast<unsigned>(_mm_movemask_epi8(size_hi)) & 0xFFFFu;
+        while (mask) {
+            size_t candidate = pos + static_cast<size_t>(__builtin_ctz(mask));
+            if (candidate > last) return size;
+            if (confirmed_header(data, size, candidate)) return candidate;
+            mask &= mask - 1;
+        }
+        pos += 16;
+    }
+#endif
+
+    for (; pos <= last; ++pos) {
+        if (confirmed_header(data, size, pos)) return pos;
+    }
+    return size;
+}
+
 } // anonymous namespace
 
 class NEXRADParser {
@@ -75,7 +483,8 @@ public:
         const std::string& timestamp_hint,
         const std::vector<std::string>& product_types,
         std::vector<uint8_t>* decompressed_out = nullptr,
-        bool generate_3d = true
+        bool generate_3d = true,
+        const ParseOptions& options = {}
     ) {
         auto parse_start = std::chrono::high_resolution_clock::now();
         std::unordered_map<std::string, std::unique_ptr<RadarFrame>> frames;
@@ -118,7 +527,7 @@ public:
         std::vector<uint8_t> local_decompressed;
         std::vector<uint8_t>& decompressed_data = decompressed_out ? *decompressed_out : local_decompressed;
         
-        if (!RadarDecompression::auto_decompress(data, decompressed_data)) {
+        if (!RadarDecompression::auto_decompress(data, decompressed_data, options.decode_threads)) {
             segmenter.clear();
             return frames;
         }
@@ -138,10 +547,17 @@ public:
         int radial_count = 0;
         float min_elevation = 999.0f;
         auto elevation_ray_counts = std::make_shared<std::unordered_map<int, int>>();
+        auto volume_plan = std::make_shared<VolumePlan>();
         
         int current_sweep_idx = -1;
         uint8_t current_elev_num = 0xFF;
         float current_sweep_elevation = -99.0f;
+
+        // This loop only walks message and radial headers; moment data is decoded
+        // per sweep afterwards. Payloads point into parse_data, or into
+        // assembled_radials for the rare segmented message.
+        std::vector<std::vector<PendingRadial>> sweep_radials;
+        std::vector<std::vector<uint8_t>> assembled_radials;
         
         bool is_archive2 = false;
         if (parse_size >= 24 && (std::memcmp(parse_data, "ARCHIVE2", 8) == 0 || 
@@ -172,19 +588,9 @@ public:
             }
 
             if (!found_header && is_archive2) {
-                for (size_t skip = 1; skip <= 4096; ++skip) {
-                    if (offset + skip + sizeof(nexrad::MessageHeader) > parse_size) break;
-                    const nexrad::MessageHeader* test_hdr = reinterpret_cast<const nexrad::MessageHeader*>(parse_data + offset + skip);
-                    if (test_hdr->type > 0 && test_hdr->type <= 32) {
-                         uint16_t size_hw = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&test_hdr->size));
-                         uint16_t julian = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&test_hdr->julian_date));
-                         if (size_hw >= 8 && size_hw < 32768 && julian > 10000) {
-                             msg_header_offset = offset + skip;
-                             found_header = true;
-                             break;
-                         }
-                    }
-                }
+                msg_header_offset = find_next_header(parse_data, parse_size, offset + 1);
+                found_header = msg_header_offset < parse_size;
+                if (!found_header) break;
             }
 
             if (!found_header) {
@@ -205,19 +611,30 @@ public:
             const uint8_t* msg_data_start_seg = parse_data + msg_header_offset + sizeof(nexrad::MessageHeader);
             size_t msg_data_size_seg = message_size_bytes - sizeof(nexrad::MessageHeader);
 
+            // Single-segment messages (every Message 31) are read in place
+            const uint8_t* payload_ptr = msg_data_start_seg;
+            size_t payload_size = msg_data_size_seg;
+            uint8_t effective_type = type;
             nexrad::MessageSegmenter::SegmentedMessage complete_msg;
-            if (!segmenter.add_segment(*msg_header, msg_data_start_seg, msg_data_size_seg, complete_msg)) {
-                message_count++;
-                offset = msg_header_offset + message_size_bytes;
-                if (is_archive2 && message_size_bytes < 2420 && type != 31 && type != 29) {
-                    offset = msg_header_offset + (2432 - 12);
+            if (read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&msg_header->num_segments)) > 1) {
+                if (!segmenter.add_segment(*msg_header, msg_data_start_seg, msg_data_size_seg, complete_msg)) {
+                    message_count++;
+                    offset = msg_header_offset + message_size_bytes;
+                    if (is_archive2 && message_size_bytes < 2420 && type != 31 && type != 29) {
+                        offset = msg_header_offset + (2432 - 12);
+                    }
+                    continue;
+                }
+                effective_type = complete_msg.type;
+                if (effective_type == 31 || effective_type == 1) {
+                    assembled_radials.push_back(std::move(complete_msg.data));
+                    payload_ptr = assembled_radials.back().data();
+                    payload_size = assembled_radials.back().size();
+                } else {
+                    payload_ptr = complete_msg.data.data();
+                    payload_size = complete_msg.data.size();
                 }
-                continue;
             }
-
-            const uint8_t* payload_ptr = complete_msg.data.data();
-            size_t payload_size = complete_msg.data.size();
-            uint8_t effective_type = complete_msg.type;
             
             offset = msg_header_offset + message_size_bytes;
             if (is_archive2 && message_size_bytes < 2420 && type != 31 && type != 29) {
@@ -239,6 +656,7 @@ public:
 
                 if (is_new_sweep) {
                     current_sweep_idx++;
+                    sweep_radials.emplace_back();
                     current_sweep_elevation = elevation;
                     current_elev_num = 0xFF;
                     for (auto& pair : frames) {
@@ -246,10 +664,6 @@ public:
                         sweep.index = current_sweep_idx;
                         sweep.elevation_deg = elevation;
                         sweep.elevation_num = 0xFF;
-                        // Reserve reasonable initial capacity to reduce reallocations
-                        // Typical high-res sweep has ~720 radials * 1800 gates / 1 (DOWNSAMPLE)
-                        // but many gates are empty. 500k floats is ~2MB.
-                        sweep.bins.reserve(100000); 
                     pair.second->sweeps.push_back(std::move(sweep));
                 }
             }
@@ -278,38 +692,17 @@ public:
                             frame.nyquist_velocity[active_key] = nyquist;
                             frame.sweeps[current_sweep_idx].nyquist_velocity = nyquist;
                         }
-
-                        uint16_t num_gates = read_be<uint16_t>(payload_ptr + 24);
-                        float first_gate_m = static_cast<float>(read_be<uint16_t>(payload_ptr + 20));
-                        float gate_size_m = static_cast<float>(read_be<uint16_t>(payload_ptr + 22));
-                        
-                        if (num_gates > 0 && payload_size >= static_cast<size_t>(46 + num_gates)) {
-                            const uint8_t* gate_data = payload_ptr + 46;
-                            if (frame.ngates == 0 && num_gates > 10) {
-                                frame.ngates = (num_gates + DOWNSAMPLE_GATES - 1) / DOWNSAMPLE_GATES;
-                                frame.gate_spacing_meters = gate_size_m * DOWNSAMPLE_GATES;
-                                frame.range_spacing_meters = gate_size_m * DOWNSAMPLE_GATES;
-                                frame.first_gate_meters = first_gate_m;
-                            }
-                            if (frame.sweeps[current_sweep_idx].bins.empty()) {
-                                frame.sweeps[current_sweep_idx].bins.reserve(num_gates * 3);
-                            }
-                                for (uint16_t g = 0; g < num_gates; g += DOWNSAMPLE_GATES) {
-                                    uint8_t raw_value = gate_data[g];
-                                    if (raw_value <= 1) continue;
-                                    float value = (static_cast<float>(raw_value) - 66.0f) * 0.5f;
-                                    if (value < -32.0f) continue;
-                                    value = quantize_value_internal(value, QUANTIZE_VALUES_DEFAULT);
-                                    float range_m = first_gate_m + static_cast<float>(g) * gate_size_m;
-                                    frame.sweeps[current_sweep_idx].bins.push_back(azimuth);
-                                    frame.sweeps[current_sweep_idx].bins.push_back(range_m);
-                                    frame.sweeps[current_sweep_idx].bins.push_back(value);
-                                }
-                            }
-                        }
                     }
                 }
+                // Decoded with the Message 31 sweeps, so bins are counted before they are stored
+                sweep_radials[current_sweep_idx].push_back({payload_ptr, payload_size, azimuth, true});
+            }
                 radial_count++;
+            } else if (effective_type == 5) { // Volume Coverage Pattern
+                if (volume_plan->cuts.empty() && decode_volume_plan(payload_ptr, payload_size, *volume_plan)) {
+                    for (auto& pair : frames) pair.second->sweeps.reserve(volume_plan->cuts.size());
+                    elevation_ray_counts->reserve(volume_plan->cuts.size());
+                }
             } else if (effective_type == 31) { // Generic Digital Radar Data
                 if (payload_size < sizeof(nexrad::Message31Header)) { message_count++; continue; }
                 auto m31_opt = nexrad::safe_read_struct<nexrad::Message31Header>(payload_ptr, payload_size, 0, "Message31Header");
@@ -340,6 +733,7 @@ public:
 
                 if (is_new_sweep) {
                     current_sweep_idx++;
+                    sweep_radials.emplace_back();
                     current_elev_num = elev_num;
                     current_sweep_elevation = elevation;
                     if (radial_status == nexrad::STATUS_START_VOLUME) segmenter.clear();
@@ -348,12 +742,11 @@ public:
                         sweep.index = current_sweep_idx;
                         sweep.elevation_num = elev_num;
                         sweep.elevation_deg = elevation;
-                        // Reserve reasonable initial capacity to reduce reallocations
-                        // Typical high-res sweep has ~720 radials * 1800 gates / 1 (DOWNSAMPLE)
-                        // but many gates are empty. 100k floats is ~400KB.
-                        sweep.bins.reserve(100000); 
                         pair.second->sweeps.push_back(std::move(sweep));
                     }
+                    if (const VolumePlan::Cut* cut = volume_plan->cut(elev_num)) {
+                        sweep_radials.back().reserve(cut->expected_radials);
+                    }
                 }
 
                 if (current_sweep_idx >= 0) {
@@ -408,72 +801,15 @@ public:
                                     if (ur > 0) { f.unambiguous_range_meters = static_cast<float>(ur) * 100.0f; f.max_range_meters = std::max(f.max_range_meters, f.unambiguous_range_meters); }
                                 }
                             }
-                        } else if (block_hdr->type == 'D') {
-                            auto moment_opt = nexrad::safe_read_struct<nexrad::DataBlock_Moment>(payload_ptr, payload_size, b_off, "DBM");
-                            if (!moment_opt) continue;
-                            const nexrad::DataBlock_Moment* moment = *moment_opt;
-                            char dname[4] = {0}; std::memcpy(dname, moment->name, 3);
-                            
-                            uint16_t ng = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&moment->num_gates));
-                            float fg = static_cast<float>(read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&moment->first_gate)));
-                            float gs = static_cast<float>(read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&moment->gate_spacing)));
-                            float sc = read_be_float(reinterpret_cast<const uint8_t*>(&moment->scale));
-                            float ov = read_be_float(reinterpret_cast<const uint8_t*>(&moment->offset));
-                            uint16_t ws = read_be<uint16_t>(reinterpret_cast<const uint8_t*>(&moment->data_word_size));
-                            if (ws == 0) ws = 8;
-                            if (ng == 0 || ng > 8000 || gs == 0 || (ws != 8 && ws != 16)) continue;
-                            
-                            size_t dsize = static_cast<size_t>(ng) * (ws / 8);
-                            if (b_off + sizeof(nexrad::DataBlock_Moment) + dsize > payload_size) continue;
-                            const uint8_t* gdata = payload_ptr + b_off + sizeof(nexrad::DataBlock_Moment);
-
-                            for (auto& pair : frames) {
-                                uint8_t tm = product_to_moment[pair.first];
-                                bool is_target = false;
-                                if (tm == 1 && strncmp(dname, "REF", 3) == 0) is_target = true;
-                                else if (tm == 2 && strncmp(dname, "VEL", 3) == 0) is_target = true;
-                                else if (tm == 3 && strncmp(dname, "SW", 2) == 0) is_target = true;
-                                else if (tm == 4 && strncmp(dname, "ZDR", 3) == 0) is_target = true;
-                                else if (tm == 5 && strncmp(dname, "PHI", 3) == 0) is_target = true;
-                                else if (tm == 6 && strncmp(dname, "RHO", 3) == 0) is_target = true;
-                                
-                                if (!is_target) continue;
-                                auto& f = *pair.second;
-                                if (static_cast<size_t>(current_sweep_idx) >= f.sweeps.size()) {
-                                    if (VERBOSE_LOGGING) std::cerr << "⚠️  Moment block: Sweep index " << current_sweep_idx << " out of bounds (size: " << f.sweeps.size() << ")" << std::endl;
-                                    continue;
-                                }
-                                
-                                if (f.ngates == 0 && ng > 10) { 
-                                    f.ngates = (ng + DOWNSAMPLE_GATES - 1) / DOWNSAMPLE_GATES; 
-                                    f.gate_spacing_meters = gs * DOWNSAMPLE_GATES; 
-                                    f.range_spacing_meters = gs * DOWNSAMPLE_GATES; 
-                                    f.first_gate_meters = fg; 
-                                }
-                                
-                                if (f.sweeps[current_sweep_idx].bins.empty()) {
-                                    f.sweeps[current_sweep_idx].bins.reserve(ng * 3);
-                                }
-                                
-                                for (uint16_t g = 0; g < ng; g += DOWNSAMPLE_GATES) {
-                                    uint16_t raw = (ws == 16) ? read_be<uint16_t>(gdata + g * 2) : gdata[g];
-                                    if (raw <= 1) continue;
-                                    float val = (static_cast<float>(raw) - ov) / sc;
-                                    if (tm == 1 && val < -32.0f) continue;
-                                    val = quantize_value_internal(val, QUANTIZE_VALUES_DEFAULT);
-                                    float range_m = fg + static_cast<float>(g) * gs;
-                                    f.sweeps[current_sweep_idx].bins.push_back(azimuth);
-                                    f.sweeps[current_sweep_idx].bins.push_back(range_m);
-                                    f.sweeps[current_sweep_idx].bins.push_back(val);
-                                }
-                            }
                         }
                     }
+                    sweep_radials[current_sweep_idx].push_back({payload_ptr, payload_size, azimuth});
                 }
                 radial_count++;
             }
             message_count++;
         }
+        decode_sweeps(frames, product_to_moment, sweep_radials, *volume_plan, options);
         
         for (auto& pair : frames) {
             auto& frame = *pair.second;
@@ -486,10 +822,10 @@ public:
             frame.nsweeps = frame.sweeps.size();
             frame.nrays = radial_count;
             frame.elevation_ray_counts = elevation_ray_counts;
+            if (!volume_plan->cuts.empty()) frame.volume_plan = volume_plan;
             if (!frame.sweeps.empty()) frame.elevation_deg = frame.sweeps[0].elevation_deg;
             else frame.elevation_deg = min_elevation;
             
-            for (auto& sweep : frame.sweeps) sweep.bins.shrink_to_fit();
             if (generate_3d && !frame.sweeps.empty()) {
                 try { VolumetricGenerator::generate_volumetric_3d(frame); } catch (...) {}
             }
@@ -524,7 +860,8 @@ std::unordered_map<std::string, std::unique_ptr<RadarFrame>> parse_nexrad_level2
     const std::string& timestamp,
     const std::vector<std::string>& product_types,
     std::vector<uint8_t>* decompressed_buffer,
-    bool generate_3d)
+    bool generate_3d,
+    const ParseOptions& options)
 {
-    return NEXRADParser::parse(data, station, timestamp, product_types, decompressed_buffer, generate_3d);
+    return NEXRADParser::parse(data, station, timestamp, product_types, decompressed_buffer, generate_3d, options);
 }
@@ -0,0 +1,122 @@
+/**
+ * S3ObjectStoreClient.cpp - Implementation
+ */
+
+#include "levelii/S3ObjectStoreClient.h"
+#include <sstream>
+#include <aws/core/auth/AWSCredentialsProvider.h>
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/s3/S3Client.h>
+#include <aws/s3/model/PutObjectRequest.h>
+#include <aws/s3/model/CreateMultipartUploadRequest.h>
+#include <aws/s3/model/UploadPartRequest.h>
+#include <aws/s3/model/CompleteMultipartUploadRequest.h>
+#include <aws/s3/model/CompletedMultipartUpload.h>
+#include <aws/s3/model/CompletedPart.h>
+#include <aws/s3/model/AbortMultipartUploadRequest.h>
+
+namespace {
+    std::shared_ptr<std::iostream> make_body(const uint8_t* data, size_t size) {
+        auto body = std::make_shared<std::stringstream>(std::ios::in | std::ios::out | std::ios::binary);
+        body->write(reinterpret_cast<const char*>(data), size);
+        return body;
+    }
+}
+
+S3ObjectStoreClient::S3ObjectStoreClient(const std::string& bucket, const std::string& endpoint_url, const std::string& region)
+    : bucket_(bucket) {
+    Aws::Client::ClientConfiguration config;
+    config.region = region;
+    config.connectTimeoutMs = 5000;
+    config.requestTimeoutMs = 30000;
+    config.maxConnections = 16;
+
+    bool virtual_addressing = true;
+    if (!endpoint_url.empty()) {
+        std::string host = endpoint_url;
+        config.scheme = Aws::Http::Scheme::HTTPS;
+        if (host.rfind("http://", 0) == 0) {
+            config.scheme = Aws::Http::Scheme::HTTP;
+            host = host.substr(7);
+        } else if (host.rfind("https://", 0) == 0) {
+            host = host.substr(8);
+        }
+        config.endpointOverride = host;
+        // Most S3-compatible servers do not resolve bucket subdomains
+        virtual_addressing = false;
+    }
+
+    client_ = std::make_shared<Aws::S3::S3Client>(
+        std::make_shared<Aws::Auth::DefaultAWSCredentialsProviderChain>(),
+        config,
+        Aws::Client::AWSAuthV4Signer::PayloadSigningPolicy::Never,
+        virtual_addressing
+    );
+}
+
+S3ObjectStoreClient::~S3ObjectStoreClient() = default;
+
+bool S3ObjectStoreClient::put_object(const std::string& key, const uint8_t* data, size_t size, std::string& error) {
+    Aws::S3::Model::PutObjectRequest request;
+    request.WithBucket(bucket_).WithKey(key).WithContentLength(static_cast<long long>(size)).WithContentType("application/octet-stream");
+    request.SetBody(make_body(data, size));
+
+    auto outcome = client_->PutObject(request);
+    if (!outcome.IsSuccess()) {
+        error = outcome.GetError().GetMessage();
+        return false;
+    }
+    return true;
+}
+
+bool S3ObjectStoreClient::create_multipart_upload(const std::string& key, std::string& upload_id, std::string& error) {
+    Aws::S3::Model::CreateMultipartUploadRequest request;
+    request.WithBucket(bucket_).WithKey(key).WithContentType("application/octet-stream");
+
+    auto outcome = client_->CreateMultipartUpload(request);
+    if (!outcome.IsSuccess()) {
+        error = outcome.GetError().GetMessage();
+        return false;
+    }
+    upload_id = outcome.GetResult().GetUploadId();
+    return true;
+}
+
+bool S3ObjectStoreClient::upload_part(const std::string& key, const std::string& upload_id, int part_number, const uint8_t* data, size_t size, std::string& etag, std::string& error) {
+    Aws::S3::Model::UploadPartRequest request;
+    request.WithBucket(bucket_).WithKey(key).WithUploadId(upload_id).WithPartNumber(part_number).WithContentLength(static_cast<long long>(size));
+    request.SetBody(make_body(data, size));
+
+    auto outcome = client_->UploadPart(request);
+    if (!outcome.IsSuccess()) {
+        error = outcome.GetError().GetMessage();
+        return false;
+    }
+    etag = outcome.GetResult().GetETag();
+    return true;
+}
+
+bool S3ObjectStoreClient::complete_multipart_upload(const std::string& key, const std::string& upload_id, const std::vector<std::string>& etags, std::string& error) {
+    Aws::S3::Model::CompletedMultipartUpload completed;
+    for (size_t i = 0; i < etags.size(); ++i) {
+        Aws::S3::Model::CompletedPart part;
+        part.WithETag(etags[i]).WithPartNumber(static_cast<int>(i + 1));
+        completed.AddParts(part);
+    }
+
+    Aws::S3::Model::CompleteMultipartUploadRequest request;
+    request.WithBucket(bucket_).WithKey(key).WithUploadId(upload_id).WithMultipartUpload(completed);
+
+    auto outcome = client_->CompleteMultipartUpload(request);
+    if (!outcome.IsSuccess()) {
+        error = outcome.GetError().GetMessage();
+        return false;
+    }
+    return true;
+}
+
+void S3ObjectStoreClient::abort_multipart_upload(const std::string& key, const std::string& upload_id) {
+    Aws::S3::Model::AbortMultipartUploadRequest request;
+    request.WithBucket(bucket_).WithKey(key).WithUploadId(upload_id);
+    client_->AbortMultipartUpload(request);
+}
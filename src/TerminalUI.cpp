@@ -78,6 +78,22 @@ void TerminalUI::render() {
         }
         ui_buffer << "]  Tasks: " << tp.value("pending_tasks", 0) << "\033[K" << std::endl;
     }
+    if (stats.contains("pipeline")) {
+        // Busy share of each fetch stage since start; the highest one limits throughput
+        ui_buffer << " Stages:";
+        for (const auto& stage : stats["pipeline"]) {
+            ui_buffer << "  " << stage.value("name", std::string()) << " " << std::setw(3)
+                      << static_cast<int>(stage.value("utilization", 0.0) * 100.0) << "% q" << stage.value("queued", 0);
+        }
+        ui_buffer << "\033[K" << std::endl;
+    }
+    if (stats.contains("degradation") && stats["degradation"].value("level", 0) > 0) {
+        // Only while shedding; red so an operator sees the pipeline is behind
+        auto shed = stats["degradation"];
+        ui_buffer << " \033[1;31mShedding: " << shed.value("level_name", std::string()) << "\033[0m"
+                  << "  stale skipped " << shed.value("stale_skipped", 0UL)
+                  << "  tilts skipped " << shed.value("tilts_skipped", 0UL) << "\033[K" << std::endl;
+    }
     if (stats.contains("discovery_pool")) {
         auto dp = stats["discovery_pool"];
         int total = dp.value("worker_count", 0);
@@ -0,0 +1,376 @@
+/**
+ * TimeSeriesArchive.cpp - Implementation
+ */
+
+#include "levelii/TimeSeriesArchive.h"
+#include "levelii/ZlibUtils.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <filesystem>
+#include <algorithm>
+#include <unordered_map>
+#include <map>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+
+namespace fs = std::filesystem;
+using json = nlohmann::json;
+
+namespace {
+    constexpr char RECORD_MAGIC[4] = {'T', 'S', 'R', '1'};
+    constexpr size_t RECORD_HEADER_SIZE = 4 + 4 + 16;
+
+    // Tiles are small and written once per frame, favour speed over ratio
+    constexpr int TILE_COMPRESSION_LEVEL = 1;
+
+    void log_error(const std::string& msg) {
+        std::cerr << "❌ " << msg << std::endl;
+    }
+
+    std::string format_tilt(float tilt) {
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1) << tilt;
+        return oss.str();
+    }
+
+    std::string tile_filename(size_t ray_block, size_t gate_block) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "r%02zu_g%02zu.TSC", ray_block, gate_block);
+        return buf;
+    }
+
+    int azimuth_to_ray(float azimuth, int num_rays) {
+        // Same binning as the tilt writer in BackgroundFrameFetcher; wrapped first so the cast stays in range
+        azimuth = std::fmod(azimuth, 360.0f);
+        if (azimuth < 0.0f) azimuth += 360.0f;
+        int ray = static_cast<int>(std::floor(azimuth * (num_rays / 360.0f) + 0.01f)) % num_rays;
+        return ray < 0 ? ray + num_rays : ray;
+    }
+
+    struct TileRecord {
+        size_t offset;
+        uint32_t size;
+    };
+
+    bool read_tile_file(const std::string& path, std::vector<uint8_t>& buffer,
+                        std::unordered_map<std::string, TileRecord>& records) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return false;
+        size_t size = file.tellg();
+        file.seekg(0, std::ios::beg);
+        buffer.resize(size);
+        file.read(reinterpret_cast<char*>(buffer.data()), size);
+
+        size_t offset = 0;
+        while (offset + RECORD_HEADER_SIZE <= size) {
+            if (std::memcmp(buffer.data() + offset, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0) break;
+            uint32_t rec_size;
+            std::memcpy(&rec_size, buffer.data() + offset + 4, 4);
+            const char* ts = reinterpret_cast<const char*>(buffer.data() + offset + 8);
+            std::string timestamp(ts, strnlen(ts, 16));
+            if (offset + RECORD_HEADER_SIZE + rec_size > size) break; // Torn trailing append
+            records[timestamp] = {offset + RECORD_HEADER_SIZE, rec_size};
+            offset += RECORD_HEADER_SIZE + rec_size;
+        }
+        return true;
+    }
+
+    // Bytes taken by the complete records at the start of a tile file; what follows is a torn append
+    uintmax_t complete_length(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) return 0;
+        const uintmax_t size = static_cast<uintmax_t>(file.tellg());
+        uintmax_t offset = 0;
+        char header[8];
+        while (offset + RECORD_HEADER_SIZE <= size) {
+            file.seekg(static_cast<std::streamoff>(offset));
+            if (!file.read(header, sizeof(header)) || std::memcmp(header, RECORD_MAGIC, sizeof(RECORD_MAGIC)) != 0) break;
+            uint32_t rec_size;
+            std::memcpy(&rec_size, header + 4, 4);
+            if (offset + RECORD_HEADER_SIZE + rec_size > size) break;
+            offset += RECORD_HEADER_SIZE + rec_size;
+        }
+        return offset;
+    }
+
+    bool append_record(const std::string& path, const char* ts_field, const std::vector<uint8_t>& compressed) {
+        std::ofstream file(path, std::ios::binary | std::ios::app);
+        if (!file.is_open()) return false;
+        uint32_t rec_size = static_cast<uint32_t>(compressed.size());
+        file.write(RECORD_MAGIC, sizeof(RECORD_MAGIC));
+        file.write(reinterpret_cast<const char*>(&rec_size), 4);
+        file.write(ts_field, 16);
+        file.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+        file.flush();
+        return file.good();
+    }
+}
+
+TimeSeriesArchive::TimeSeriesArchive(const std::string& root_path, levelii::SQLiteDatabase& db)
+    : root_path_(root_path), db_(db) {
+    db_.execute(
+        "CREATE TABLE IF NOT EXISTS levelii_timeseries ("
+        "    station TEXT,"
+        "    product_name TEXT,"
+        "    tilt TEXT,"
+        "    timestamp TEXT,"
+        "    chunk TEXT,"
+        "    num_rays INTEGER,"
+        "    num_gates INTEGER,"
+        "    gate_spacing REAL,"
+        "    first_gate REAL,"
+        "    PRIMARY KEY (station, product_name, tilt, timestamp)"
+        ");"
+        "CREATE INDEX IF NOT EXISTS idx_levelii_timeseries_chunk ON levelii_timeseries (chunk);");
+}
+
+std::string TimeSeriesArchive::chunk_dir(const std::string& station, const std::string& product, float tilt, const std::string& chunk) const {
+    return root_path_ + "/" + station + "/" + product + "/" + format_tilt(tilt) + "/" + chunk;
+}
+
+std::mutex& TimeSeriesArchive::chunk_mutex(const std::string& dir) {
+    return chunk_mutexes_[std::hash<std::string>{}(dir) % chunk_mutexes_.size()];
+}
+
+bool TimeSeriesArchive::append_frame(const std::string& station, const std::string& product, const std::string& timestamp, float tilt, uint16_t num_rays, uint16_t num_gates, float gate_spacing, float first_gate, const std::vector<uint8_t>& bitmask, const std::vector<uint8_t>& values) {
+    if (num_rays == 0 || num_gates == 0 || timestamp.size() < 11 || timestamp.size() > 16) return false;
+
+    const size_t total = static_cast<size_t>(num_rays) * num_gates;
+    if (bitmask.size() < (total + 7) / 8) return false;
+
+    std::string tilt_str = format_tilt(tilt);
+    std::string chunk = timestamp.substr(0, 11) + "_" + std::to_string(num_rays) + "x" + std::to_string(num_gates);
+    auto archived = [&]() {
+        return !db_.query_params(
+            "SELECT 1 FROM levelii_timeseries WHERE station = ? AND product_name = ? AND tilt = ? AND timestamp = ? LIMIT 1;",
+            {station, product, tilt_str, timestamp}).empty();
+    };
+    if (archived()) return true;
+
+    // Expand the bitmask once, then slice tiles out of the dense grid. None of this
+    // needs a lock, so store workers archive their tilts in parallel.
+    std::vector<uint8_t> grid(total, 0);
+    size_t value_idx = 0;
+    for (size_t b = 0; b < total && value_idx < values.size(); ++b) {
+        if (bitmask[b / 8] & (1 << (7 - (b % 8)))) {
+            grid[b] = values[value_idx++];
+        }
+    }
+
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> tiles;  // Tile file name, gzip tile
+    std::vector<uint8_t> tile;
+    tile.reserve(static_cast<size_t>(TS_TILE_RAYS) * TS_TILE_GATES);
+
+    for (size_t r0 = 0; r0 < num_rays; r0 += TS_TILE_RAYS) {
+        size_t r1 = std::min<size_t>(r0 + TS_TILE_RAYS, num_rays);
+        for (size_t g0 = 0; g0 < num_gates; g0 += TS_TILE_GATES) {
+            size_t g1 = std::min<size_t>(g0 + TS_TILE_GATES, num_gates);
+
+            tile.clear();
+            bool has_echo = false;
+            for (size_t r = r0; r < r1; ++r) {
+                const uint8_t* row = grid.data() + r * num_gates;
+                tile.insert(tile.end(), row + g0, row + g1);
+                if (!has_echo) {
+                    has_echo = std::any_of(row + g0, row + g1, [](uint8_t v) { return v != 0; });
+                }
+            }
+            if (!has_echo) continue;
+
+            auto compressed = ZlibUtils::gzip_compress(tile.data(), tile.size(), TILE_COMPRESSION_LEVEL);
+            if (compressed.empty()) return false;
+            tiles.emplace_back(tile_filename(r0 / TS_TILE_RAYS, g0 / TS_TILE_GATES), std::move(compressed));
+        }
+    }
+
+    std::string dir = chunk_dir(station, product, tilt, chunk);
+    std::shared_lock<std::shared_mutex> prune_lock(prune_mutex_);
+    std::lock_guard<std::mutex> lock(chunk_mutex(dir));
+    if (archived()) return true;
+
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    if (ec) {
+        log_error("Failed to create time-series chunk " + dir + ": " + ec.message());
+        return false;
+    }
+
+    char ts_field[16] = {0};
+    std::memcpy(ts_field, timestamp.data(), timestamp.size());
+
+    // Tile files touched so far and their length before this frame; a failure cuts them back
+    std::vector<std::pair<std::string, uintmax_t>> touched;
+    auto roll_back = [&touched]() {
+        for (const auto& [path, length] : touched) {
+            std::error_code resize_ec;
+            fs::resize_file(path, length, resize_ec);
+        }
+    };
+
+    for (const auto& [name, compressed] : tiles) {
+        std::string path = dir + "/" + name;
+        uintmax_t size = fs::file_size(path, ec);
+        if (ec) size = 0;
+        uintmax_t length = size > 0 ? complete_length(path) : 0;
+        if (length < size) {
+            log_error("Dropping a torn record at byte " + std::to_string(length) + " of " + path);
+            fs::resize_file(path, length, ec);
+            if (ec) {
+                roll_back();
+                return false;
+            }
+        }
+        touched.emplace_back(path, length);
+        if (!append_record(path, ts_field, compressed)) {
+            log_error("Failed to append to time-series tile " + path);
+            roll_back();
+            return false;
+        }
+    }
+
+    std::ostringstream gs, fg;
+    gs << gate_spacing;
+    fg << first_gate;
+    bool recorded = db_.execute_params(
+        "INSERT OR REPLACE INTO levelii_timeseries "
+        "(station, product_name, tilt, timestamp, chunk, num_rays, num_gates, gate_spacing, first_gate) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);",
+        {station, product, tilt_str, timestamp, chunk, std::to_string(num_rays),
+         std::to_string(num_gates), gs.str(), fg.str()});
+    if (!recorded) roll_back();
+    return recorded;
+}
+
+std::vector<TimeSeriesArchive::Sample> TimeSeriesArchive::query(const Query& q) const {
+    std::vector<Sample> samples;
+    if (!std::isfinite(q.azimuth_min) || !std::isfinite(q.azimuth_max) ||
+        !std::isfinite(q.range_min_m) || !std::isfinite(q.range_max_m)) {
+        return samples;
+    }
+
+    json rows = db_.query_params(
+        "SELECT timestamp, chunk, num_rays, num_gates, gate_spacing, first_gate FROM levelii_timeseries "
+        "WHERE station = ? AND product_name = ? AND tilt = ? AND timestamp >= ? AND timestamp <= ? "
+        "ORDER BY timestamp ASC;",
+        {q.station, q.product, format_tilt(q.tilt), q.start, q.end});
+    if (rows.empty()) return samples;
+
+    samples.reserve(rows.size());
+
+    size_t i = 0;
+    while (i < rows.size()) {
+        // Rows are time-ordered, so each chunk is a contiguous run
+        const std::string chunk = rows[i]["chunk"];
+        size_t chunk_end = i;
+        while (chunk_end < rows.size() && rows[chunk_end]["chunk"] == chunk) chunk_end++;
+
+        const int num_rays = rows[i]["num_rays"].get<int>();
+        const int num_gates = rows[i]["num_gates"].get<int>();
+        const float gate_spacing = rows[i]["gate_spacing"].get<float>();
+        const float first_gate = rows[i]["first_gate"].get<float>();
+
+        std::map<std::string, size_t> sample_idx;
+        for (size_t k = i; k < chunk_end; ++k) {
+            Sample s;
+            s.timestamp = rows[k]["timestamp"];
+            sample_idx[s.timestamp] = samples.size();
+            samples.push_back(s);
+        }
+
+        // Resolve the query window to [begin, end) ray intervals and a gate range
+        std::vector<std::pair<int, int>> ray_spans;
+        int r_min = azimuth_to_ray(q.azimuth_min, num_rays);
+        int r_max = azimuth_to_ray(q.azimuth_max, num_rays);
+        if (q.azimuth_min <= q.azimuth_max) {
+            ray_spans.push_back({r_min, r_max + 1});
+        } else {
+            ray_spans.push_back({r_min, num_rays});
+            ray_spans.push_back({0, r_max + 1});
+        }
+
+        // Clamped while still floating point: a far range or a bad chunk row must not overflow the casts
+        int g_min = 0;
+        int g_max = -1;
+        if (gate_spacing > 0 && std::isfinite(gate_spacing) && std::isfinite(first_gate) && num_gates > 0) {
+            const double g_lo = std::floor((static_cast<double>(q.range_min_m) - first_gate) / gate_spacing);
+            const double g_hi = std::floor((static_cast<double>(q.range_max_m) - first_gate) / gate_spacing);
+            if (g_lo <= g_hi && g_hi >= 0.0 && g_lo <= num_gates - 1) {
+                g_min = static_cast<int>(std::max(g_lo, 0.0));
+                g_max = static_cast<int>(std::min(g_hi, num_gates - 1.0));
+            }
+        }
+
+        if (g_min <= g_max) {
+            std::string dir = chunk_dir(q.station, q.product, q.tilt, chunk);
+            std::vector<uint8_t> file_buf;
+            std::vector<uint8_t> tile;
+
+            for (const auto& span : ray_spans) {
+                for (int rb = span.first / TS_TILE_RAYS; rb * TS_TILE_RAYS < span.second; ++rb) {
+                    for (int gb = g_min / TS_TILE_GATES; gb * TS_TILE_GATES <= g_max; ++gb) {
+                        std::unordered_map<std::string, TileRecord> records;
+                        if (!read_tile_file(dir + "/" + tile_filename(rb, gb), file_buf, records)) continue;
+
+                        const int tile_r0 = rb * TS_TILE_RAYS;
+                        const int tile_g0 = gb * TS_TILE_GATES;
+                        const int tile_gates = std::min<int>(TS_TILE_GATES, num_gates - tile_g0);
+                        const int r_begin = std::max(span.first, tile_r0);
+                        const int r_end = std::min({span.second, tile_r0 + TS_TILE_RAYS, num_rays});
+                        const int g_begin = std::max(g_min, tile_g0);
+                        const int g_end = std::min(g_max + 1, tile_g0 + tile_gates);
+
+                        for (const auto& [ts, rec] : records) {
+                            auto it = sample_idx.find(ts);
+                            if (it == sample_idx.end()) continue;
+
+                            tile = ZlibUtils::gzip_decompress(file_buf.data() + rec.offset, rec.size);
+                            if (tile.size() < static_cast<size_t>(r_end - tile_r0) * tile_gates) continue;
+
+                            Sample& s = samples[it->second];
+                            float sum = s.mean * s.count;
+                            for (int r = r_begin; r < r_end; ++r) {
+                                const uint8_t* row = tile.data() + static_cast<size_t>(r - tile_r0) * tile_gates;
+                                for (int g = g_begin; g < g_end; ++g) {
+                                    uint8_t v = row[g - tile_g0];
+                                    if (v == 0) continue;
+                                    if (s.count == 0 || v < s.min) s.min = v;
+                                    if (v > s.max) s.max = v;
+                                    sum += v;
+                                    s.count++;
+                                }
+                            }
+                            s.mean = s.count > 0 ? sum / s.count : 0.0f;
+                        }
+                    }
+                }
+            }
+        }
+
+        i = chunk_end;
+    }
+
+    return samples;
+}
+
+void TimeSeriesArchive::prune_before(const std::string& timestamp) {
+    if (timestamp.size() < 11) return;
+    std::string cutoff = timestamp.substr(0, 11);
+
+    std::unique_lock<std::shared_mutex> lock(prune_mutex_);
+
+    json chunks = db_.query_params(
+        "SELECT DISTINCT station, product_name, tilt, chunk FROM levelii_timeseries WHERE chunk < ?;",
+        {cutoff});
+    for (const auto& row : chunks) {
+        std::string dir = root_path_ + "/" + row["station"].get<std::string>() + "/" +
+                          row["product_name"].get<std::string>() + "/" +
+                          row["tilt"].get<std::string>() + "/" + row["chunk"].get<std::string>();
+        std::error_code ec;
+        fs::remove_all(dir, ec);
+    }
+
+    db_.execute_params("DELETE FROM levelii_timeseries WHERE chunk < ?;", {cutoff});
+}
@@ -1,77 +1,469 @@
 #include "levelii/ZlibUtils.h"
+#include "levelii/Checksum.h"
+#include "levelii/ContextPool.h"
 #include <zlib.h>
 #include <iostream>
 #include <cstring>
+#include <array>
+#include <atomic>
+#include <algorithm>
 
-namespace ZlibUtils {
+#ifdef LEVELII_HAVE_LIBDEFLATE
+#include <libdeflate.h>
+#endif
+
+namespace {
+    // FEXTRA layout written by gzip_compress_with_crc: XLEN=8, SI1='R', SI2='C', LEN=4, CRC32C
+    constexpr uint8_t CRC_SUBFIELD_ID1 = 'R';
+    constexpr uint8_t CRC_SUBFIELD_ID2 = 'C';
+    constexpr size_t CRC_EXTRA_LEN = 8;
+    constexpr size_t CRC_HEADER_SIZE = 10 + 2 + CRC_EXTRA_LEN;
+    constexpr size_t CRC_VALUE_OFFSET = 16;
+    // Multi-member files add 'R','S' with the inflated size of all members, after the CRC subfield
+    constexpr uint8_t SIZE_SUBFIELD_ID2 = 'S';
+    constexpr size_t MEMBERS_EXTRA_LEN = CRC_EXTRA_LEN + 8;
+
+    constexpr int GZIP_WINDOW_BITS = 15 + 16;
+    constexpr size_t GZIP_TRAILER_SIZE = 8;
+    // Deflate cannot expand data by more than this; larger size claims are corrupt
+    constexpr size_t MAX_DEFLATE_RATIO = 1032;
+
+    std::atomic<uint64_t> stream_init_count{0};
+
+    bool gzip_magic(const uint8_t* data, size_t size) {
+        return size >= 2 && data[0] == 0x1f && data[1] == 0x8b;
+    }
+
+    // ISIZE from the trailer, exact for a single-member file under 4 GB; 0 if absent or more than deflate could produce
+    size_t trailer_size(const uint8_t* data, size_t size) {
+        if (size < 10 + GZIP_TRAILER_SIZE) return 0;
+        const uint8_t* trailer = data + size - 4;
+        size_t isize = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | (static_cast<size_t>(trailer[3]) << 24);
+        return isize <= size * MAX_DEFLATE_RATIO ? isize : 0;
+    }
+
+    // Value of a 4-byte 'R',id2 subfield in the first member's FEXTRA
+    bool extra_u32(const uint8_t* data, size_t size, uint8_t id2, uint32_t& value) {
+        if (size < 12 || data[0] != 0x1f || data[1] != 0x8b || !(data[3] & 0x04)) return false;
+        size_t extra_end = 12 + (data[10] | (static_cast<size_t>(data[11]) << 8));
+        if (extra_end > size) return false;
+        for (size_t pos = 12; pos + 4 <= extra_end;) {
+            size_t len = data[pos + 2] | (static_cast<size_t>(data[pos + 3]) << 8);
+            if (data[pos] == CRC_SUBFIELD_ID1 && data[pos + 1] == id2 && len == 4 && pos + 8 <= extra_end) {
+                value = data[pos + 4] | (data[pos + 5] << 8) | (data[pos + 6] << 16) | (static_cast<uint32_t>(data[pos + 7]) << 24);
+                return true;
+            }
+            pos += 4 + len;
+        }
+        return false;
+    }
+
+    // Inflated size of the whole file: the 'R','S' subfield of a multi-member file, else ISIZE
+    size_t recorded_size(const uint8_t* data, size_t size) {
+        uint32_t total = 0;
+        if (extra_u32(data, size, SIZE_SUBFIELD_ID2, total) && total <= size * MAX_DEFLATE_RATIO) return total;
+        return trailer_size(data, size);
+    }
+
+    // Output size to allocate up front
+    size_t inflated_size_hint(const uint8_t* data, size_t size) {
+        size_t isize = recorded_size(data, size);
+        return isize ? isize : size * 4;
+    }
+
+    void patch_crc(std::vector<uint8_t>& file, size_t header_size) {
+        // The CRC covers everything after the first header, so it can be patched in after compressing
+        uint32_t crc = Checksum::crc32c(file.data() + header_size, file.size() - header_size);
+        for (int i = 0; i < 4; ++i) {
+            file[CRC_VALUE_OFFSET + i] = static_cast<uint8_t>(crc >> (8 * i));
+        }
+    }
+
+#ifdef LEVELII_HAVE_LIBDEFLATE
+    constexpr int MAX_LEVEL = 12;
+#else
+    constexpr int MAX_LEVEL = Z_BEST_COMPRESSION;
+#endif
+
+    bool valid_level(int level) {
+        return level >= Z_DEFAULT_COMPRESSION && level <= MAX_LEVEL;
+    }
+
+#ifdef LEVELII_HAVE_LIBDEFLATE
+    // ========================================================================
+    // libdeflate backend: whole-buffer only, several times faster than zlib
+    // ========================================================================
+    struct Deflater {
+        libdeflate_compressor* compressor = nullptr;
+
+        ~Deflater() {
+            if (compressor) libdeflate_free_compressor(compressor);
+        }
+
+        bool begin(int level) {
+            if (compressor) return true;
+            compressor = libdeflate_alloc_compressor(level == Z_DEFAULT_COMPRESSION ? 6 : level);
+            if (compressor) stream_init_count++;
+            return compressor != nullptr;
+        }
+    };
+
+    struct Inflater {
+        libdeflate_decompressor* decompressor = nullptr;
+
+        ~Inflater() {
+            if (decompressor) libdeflate_free_decompressor(decompressor);
+        }
+
+        bool begin() {
+            if (decompressor) return true;
+            decompressor = libdeflate_alloc_decompressor();
+            if (decompressor) stream_init_count++;
+            return decompressor != nullptr;
+        }
+    };
+#else
+    // ========================================================================
+    // zlib backend: streams initialized once per pool entry, reset per call
+    // ========================================================================
+    struct Deflater {
+        z_stream stream{};
+        bool ready = false;
+
+        ~Deflater() {
+            if (ready) deflateEnd(&stream);
+        }
+
+        bool begin(int level) {
+            if (!ready) {
+                if (deflateInit2(&stream, level, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) return false;
+                ready = true;
+                stream_init_count++;
+                return true;
+            }
+            return deflateReset(&stream) == Z_OK;
+        }
+    };
+
+    struct Inflater {
+        z_stream stream{};
+        bool ready = false;
+
+        ~Inflater() {
+            if (ready) inflateEnd(&stream);
+        }
+
+        bool begin() {
+            if (ready) return inflateReset(&stream) == Z_OK;
+            if (inflateInit2(&stream, GZIP_WINDOW_BITS) != Z_OK) return false;
+            ready = true;
+            stream_init_count++;
+            return true;
+        }
+    };
+#endif
+
+    // One pool per level (-1 = Z_DEFAULT_COMPRESSION through MAX_LEVEL), so callers using different levels never re-initialize
+    levelii::ContextPool<Deflater>& deflaters(int level) {
+        static std::array<levelii::ContextPool<Deflater>, MAX_LEVEL + 2> pools;
+        return pools[level + 1];
+    }
+
+    levelii::ContextPool<Inflater>& inflaters() {
+        static levelii::ContextPool<Inflater> pool;
+        return pool;
+    }
+
+#ifdef LEVELII_HAVE_LIBDEFLATE
+    void put_le32(std::vector<uint8_t>& out, size_t at, uint32_t value) {
+        for (int i = 0; i < 4; ++i) out[at + i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+
+    // Same header zlib writes for deflateSetHeader with os = 3 and no name, comment or time
+    size_t write_gzip_header(std::vector<uint8_t>& out, int level, const uint8_t* extra, size_t extra_len) {
+        size_t size = 10 + (extra ? 2 + extra_len : 0);
+        out.resize(size);
+        out[0] = 0x1f;
+        out[1] = 0x8b;
+        out[2] = Z_DEFLATED;
+        out[3] = extra ? 0x04 : 0x00;
+        put_le32(out, 4, 0);
+        out[8] = level >= Z_BEST_COMPRESSION ? 2 : (level >= 0 && level < 2 ? 4 : 0);
+        out[9] = 3;
+        if (extra) {
+            out[10] = static_cast<uint8_t>(extra_len);
+            out[11] = static_cast<uint8_t>(extra_len >> 8);
+            std::memcpy(out.data() + 12, extra, extra_len);
+        }
+        return size;
+    }
+
+    bool deflate_gzip(const uint8_t* data, size_t data_size, int level, const uint8_t* extra, size_t extra_len,
+                      std::vector<uint8_t>& out) {
+        auto deflater = deflaters(level).acquire();
+        if (!deflater->begin(level)) return false;
+
+        size_t header = write_gzip_header(out, level, extra, extra_len);
+        size_t bound = libdeflate_deflate_compress_bound(deflater->compressor, data_size);
+        out.resize(header + bound + GZIP_TRAILER_SIZE);
+        size_t body = libdeflate_deflate_compress(deflater->compressor, data, data_size, out.data() + header, bound);
+        if (body == 0) return false;
+        put_le32(out, header + body, libdeflate_crc32(0, data, data_size));
+        put_le32(out, header + body + 4, static_cast<uint32_t>(data_size));
+        out.resize(header + body + GZIP_TRAILER_SIZE);
+        return true;
+    }
 
-std::vector<uint8_t> gzip_compress(const uint8_t* data, size_t data_size) {
-    std::vector<uint8_t> compressed;
-    if (data_size == 0) return compressed;
-
-    z_stream stream{};
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
-    
-    if (deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 
-                     15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+    bool inflate_gzip(const uint8_t* data, size_t data_size, std::vector<uint8_t>& out, size_t* consumed) {
+        auto inflater = inflaters().acquire();
+        if (!inflater->begin()) return false;
+
+        out.resize(consumed ? data_size * 4 : inflated_size_hint(data, data_size));
+        size_t produced = 0;
+        size_t pos = 0;
+        while (true) {
+            size_t in_used = 0;
+            size_t out_used = 0;
+            auto result = libdeflate_gzip_decompress_ex(inflater->decompressor, data + pos, data_size - pos,
+                                                        out.data() + produced, out.size() - produced, &in_used, &out_used);
+            if (result == LIBDEFLATE_INSUFFICIENT_SPACE) {
+                // Only a member without an exact trailer hint gets here; retry it with more room
+                size_t limit = produced + (data_size - pos) * MAX_DEFLATE_RATIO + 1024;
+                if (out.size() >= limit) return false;
+                out.resize(std::min(limit, std::max<size_t>(out.size() * 2, 4096)));
+                continue;
+            }
+            if (result != LIBDEFLATE_SUCCESS) return false;
+            produced += out_used;
+            pos += in_used;
+            if (consumed) {
+                *consumed = pos;
+                break;
+            }
+            if (!gzip_magic(data + pos, data_size - pos)) break;
+            if (out.size() == produced) out.resize(produced + std::max<size_t>(produced / 2, 4096));
+        }
+        out.resize(produced);
+        return true;
+    }
+
+    bool inflate_gzip_into(const uint8_t* data, size_t data_size, uint8_t* out, size_t capacity, size_t& produced) {
+        auto inflater = inflaters().acquire();
+        if (!inflater->begin()) return false;
+
+        produced = 0;
+        size_t pos = 0;
+        do {
+            size_t in_used = 0;
+            size_t out_used = 0;
+            if (libdeflate_gzip_decompress_ex(inflater->decompressor, data + pos, data_size - pos, out + produced,
+                                              capacity - produced, &in_used, &out_used) != LIBDEFLATE_SUCCESS) {
+                return false;
+            }
+            produced += out_used;
+            pos += in_used;
+        } while (gzip_magic(data + pos, data_size - pos));
+        return true;
+    }
+#else
+    bool deflate_gzip(const uint8_t* data, size_t data_size, int level, const uint8_t* extra, size_t extra_len,
+                      std::vector<uint8_t>& out) {
+        auto deflater = deflaters(level).acquire();
+        if (!deflater->begin(level)) return false;
+
+        gz_header header{};
+        header.extra = const_cast<uint8_t*>(extra);
+        header.extra_len = static_cast<uInt>(extra_len);
+        header.os = 3; // Unix, matching zlib's default header
+        // deflateReset keeps the previous call's header pointer, so always set it
+        z_stream& stream = deflater->stream;
+        if (deflateSetHeader(&stream, extra ? &header : Z_NULL) != Z_OK) return false;
+
+        // deflateBound covers the header and trailer, so one call writes the whole file
+        out.resize(deflateBound(&stream, data_size));
+        stream.next_in = const_cast<uint8_t*>(data);
+        stream.avail_in = data_size;
+        stream.next_out = out.data();
+        stream.avail_out = out.size();
+        if (deflate(&stream, Z_FINISH) != Z_STREAM_END) return false;
+        out.resize(stream.total_out);
+        return true;
+    }
+
+    bool inflate_gzip(const uint8_t* data, size_t data_size, std::vector<uint8_t>& out, size_t* consumed) {
+        auto inflater = inflaters().acquire();
+        if (!inflater->begin()) return false;
+
+        z_stream& stream = inflater->stream;
+        stream.next_in = const_cast<uint8_t*>(data);
+        stream.avail_in = data_size;
+        out.resize(std::max<size_t>(consumed ? data_size * 4 : inflated_size_hint(data, data_size), 1));
+        size_t produced = 0;
+        while (true) {
+            stream.next_out = out.data() + produced;
+            stream.avail_out = out.size() - produced;
+            int ret = inflate(&stream, Z_NO_FLUSH);
+            produced = out.size() - stream.avail_out;
+            if (ret == Z_STREAM_END) {
+                if (consumed) {
+                    *consumed = data_size - stream.avail_in;
+                    break;
+                }
+                if (!gzip_magic(stream.next_in, stream.avail_in) || inflateReset(&stream) != Z_OK) break;
+                continue;
+            }
+            if (ret != Z_OK && ret != Z_BUF_ERROR) return false;
+            if (stream.avail_out > 0) return false;  // Input ran out mid-stream
+
+            // Only reached without an exact trailer hint
+            size_t limit = produced + stream.avail_in * MAX_DEFLATE_RATIO + 1024;
+            if (out.size() >= limit) return false;
+            out.resize(std::min(limit, out.size() + std::max<size_t>(out.size() / 2, 4096)));
+        }
+        out.resize(produced);
+        return true;
+    }
+
+    bool inflate_gzip_into(const uint8_t* data, size_t data_size, uint8_t* out, size_t capacity, size_t& produced) {
+        auto inflater = inflaters().acquire();
+        if (!inflater->begin()) return false;
+
+        z_stream& stream = inflater->stream;
+        stream.next_in = const_cast<uint8_t*>(data);
+        stream.avail_in = data_size;
+        stream.next_out = out;
+        stream.avail_out = capacity;
+        while (true) {
+            int ret = inflate(&stream, Z_FINISH);
+            if (ret == Z_STREAM_END) {
+                if (!gzip_magic(stream.next_in, stream.avail_in) || inflateReset(&stream) != Z_OK) break;
+                continue;
+            }
+            // Z_BUF_ERROR here is either truncated input or output that does not fit
+            return false;
+        }
+        produced = capacity - stream.avail_out;
+        return true;
+    }
+#endif
+
+    std::vector<uint8_t> compress_or_empty(const uint8_t* data, size_t data_size, int level, const uint8_t* extra, size_t extra_len) {
+        std::vector<uint8_t> compressed;
+        if (data_size == 0 || !valid_level(level)) return compressed;
+        if (!deflate_gzip(data, data_size, level, extra, extra_len, compressed)) compressed.clear();
         return compressed;
     }
-    
-    stream.avail_in = data_size;
-    stream.next_in = const_cast<uint8_t*>(data);
-    
-    const size_t chunk_size = 65536;
-    std::vector<uint8_t> out_buffer(chunk_size);
-    
-    int ret;
-    do {
-        stream.avail_out = chunk_size;
-        stream.next_out = out_buffer.data();
-        ret = deflate(&stream, Z_FINISH);
-        size_t have = chunk_size - stream.avail_out;
-        compressed.insert(compressed.end(), out_buffer.begin(), out_buffer.begin() + have);
-    } while (ret == Z_OK);
-    
-    deflateEnd(&stream);
-    return (ret == Z_STREAM_END) ? compressed : std::vector<uint8_t>();
+}
+
+namespace ZlibUtils {
+
+std::vector<uint8_t> gzip_compress(const uint8_t* data, size_t data_size, int level) {
+    return compress_or_empty(data, data_size, level, nullptr, 0);
+}
+
+std::vector<uint8_t> gzip_compress_with_crc(const uint8_t* data, size_t data_size, int level) {
+    const uint8_t extra[CRC_EXTRA_LEN] = {CRC_SUBFIELD_ID1, CRC_SUBFIELD_ID2, 4, 0, 0, 0, 0, 0};
+    std::vector<uint8_t> compressed = compress_or_empty(data, data_size, level, extra, CRC_EXTRA_LEN);
+    if (compressed.size() < CRC_HEADER_SIZE || !(compressed[3] & 0x04)) return std::vector<uint8_t>();
+    patch_crc(compressed, CRC_HEADER_SIZE);
+    return compressed;
+}
+
+std::vector<uint8_t> gzip_compress_members_with_crc(const uint8_t* data, size_t data_size,
+                                                    const std::vector<std::vector<uint8_t>>& members, int level) {
+    size_t total = data_size;
+    size_t members_size = 0;
+    for (const auto& member : members) {
+        if (member.empty()) continue;
+        if (!gzip_magic(member.data(), member.size())) return std::vector<uint8_t>();
+        total += trailer_size(member.data(), member.size());
+        members_size += member.size();
+    }
+    uint8_t extra[MEMBERS_EXTRA_LEN] = {CRC_SUBFIELD_ID1, CRC_SUBFIELD_ID2, 4, 0, 0, 0, 0, 0,
+                                        CRC_SUBFIELD_ID1, SIZE_SUBFIELD_ID2, 4, 0};
+    for (int i = 0; i < 4; ++i) extra[12 + i] = static_cast<uint8_t>(total >> (8 * i));
+
+    std::vector<uint8_t> file = compress_or_empty(data, data_size, level, extra, MEMBERS_EXTRA_LEN);
+    if (file.size() < 12 + MEMBERS_EXTRA_LEN) return std::vector<uint8_t>();
+    file.reserve(file.size() + members_size);
+    for (const auto& member : members) file.insert(file.end(), member.begin(), member.end());
+    patch_crc(file, 12 + MEMBERS_EXTRA_LEN);
+    return file;
+}
+
+GzipCrcStatus verify_gzip_crc(const uint8_t* data, size_t data_size, uint32_t* stored_crc, bool verify) {
+    if (data_size < 10 || data[0] != 0x1f || data[1] != 0x8b || !(data[3] & 0x04)) return GzipCrcStatus::Missing;
+    if (data_size < 12) return GzipCrcStatus::Mismatch;
+
+    const uint8_t flags = data[3];
+    size_t xlen = data[10] | (static_cast<size_t>(data[11]) << 8);
+    size_t pos = 12;
+    size_t extra_end = pos + xlen;
+    if (extra_end > data_size) return GzipCrcStatus::Mismatch;
+
+    bool found = false;
+    uint32_t crc = 0;
+    while (pos + 4 <= extra_end) {
+        size_t len = data[pos + 2] | (static_cast<size_t>(data[pos + 3]) << 8);
+        if (data[pos] == CRC_SUBFIELD_ID1 && data[pos + 1] == CRC_SUBFIELD_ID2 && len == 4 && pos + 8 <= extra_end) {
+            crc = data[pos + 4] | (data[pos + 5] << 8) | (data[pos + 6] << 16) | (static_cast<uint32_t>(data[pos + 7]) << 24);
+            found = true;
+            break;
+        }
+        pos += 4 + len;
+    }
+    if (!found) return GzipCrcStatus::Missing;
+    if (stored_crc) *stored_crc = crc;
+    if (!verify) return GzipCrcStatus::Valid;
+
+    // Skip any optional fields that follow FEXTRA
+    size_t payload = extra_end;
+    if (flags & 0x08) { while (payload < data_size && data[payload] != 0) payload++; payload++; }
+    if (flags & 0x10) { while (payload < data_size && data[payload] != 0) payload++; payload++; }
+    if (flags & 0x02) payload += 2;
+    if (payload > data_size) return GzipCrcStatus::Mismatch;
+
+    return Checksum::crc32c(data + payload, data_size - payload) == crc ? GzipCrcStatus::Valid : GzipCrcStatus::Mismatch;
+}
+
+bool gzip_decompress(const uint8_t* data, size_t data_size, std::vector<uint8_t>& out) {
+    if (data_size == 0 || !inflate_gzip(data, data_size, out, nullptr)) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+bool gzip_decompress_member(const uint8_t* data, size_t data_size, std::vector<uint8_t>& out, size_t& consumed) {
+    consumed = 0;
+    if (data_size == 0 || !inflate_gzip(data, data_size, out, &consumed)) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+bool gzip_decompress_into(const uint8_t* data, size_t data_size, uint8_t* out, size_t capacity, size_t& produced) {
+    produced = 0;
+    return data_size > 0 && inflate_gzip_into(data, data_size, out, capacity, produced);
+}
+
+size_t gzip_inflated_size(const uint8_t* data, size_t data_size) {
+    return recorded_size(data, data_size);
 }
 
 std::vector<uint8_t> gzip_decompress(const uint8_t* data, size_t data_size) {
     std::vector<uint8_t> decompressed;
-    if (data_size == 0) return decompressed;
-
-    z_stream stream{};
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
-    
-    if (inflateInit2(&stream, 15 + 16) != Z_OK) {
-        return decompressed;
-    }
-    
-    stream.avail_in = data_size;
-    stream.next_in = const_cast<uint8_t*>(data);
-    
-    const size_t chunk_size = 65536;
-    std::vector<uint8_t> out_buffer(chunk_size);
-    
-    int ret;
-    do {
-        stream.avail_out = chunk_size;
-        stream.next_out = out_buffer.data();
-        ret = inflate(&stream, Z_NO_FLUSH);
-        if (ret == Z_STREAM_ERROR || ret == Z_DATA_ERROR || ret == Z_MEM_ERROR) {
-            inflateEnd(&stream);
-            return std::vector<uint8_t>();
-        }
-        size_t have = chunk_size - stream.avail_out;
-        decompressed.insert(decompressed.end(), out_buffer.begin(), out_buffer.begin() + have);
-    } while (ret == Z_OK);
-    
-    inflateEnd(&stream);
-    return (ret == Z_STREAM_END) ? decompressed : std::vector<uint8_t>();
+    gzip_decompress(data, data_size, decompressed);
+    return decompressed;
+}
+
+int max_level() {
+    return MAX_LEVEL;
+}
+
+uint64_t stream_inits() {
+    return stream_init_count.load();
 }
 
 } // namespace ZlibUtils
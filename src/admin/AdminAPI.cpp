@@ -2,12 +2,33 @@
 #include "levelii/admin/WebServer.h"
 #include "levelii/BackgroundFrameFetcher.h"
 #include "levelii/FrameStorageManager.h"
+#include "levelii/RadarFrame.h"
 #include "levelii/Version.h"
 #include <chrono>
 #include <ctime>
+#include <cmath>
 
 static auto g_start_time = std::chrono::system_clock::now();
 
+namespace {
+    const char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string base64_encode(const uint8_t* data, size_t size) {
+        std::string encoded;
+        encoded.reserve((size + 2) / 3 * 4);
+        for (size_t i = 0; i < size; i += 3) {
+            uint32_t triple = data[i] << 16;
+            if (i + 1 < size) triple |= data[i + 1] << 8;
+            if (i + 2 < size) triple |= data[i + 2];
+            encoded.push_back(BASE64_CHARS[(triple >> 18) & 0x3F]);
+            encoded.push_back(BASE64_CHARS[(triple >> 12) & 0x3F]);
+            encoded.push_back(i + 1 < size ? BASE64_CHARS[(triple >> 6) & 0x3F] : '=');
+            encoded.push_back(i + 2 < size ? BASE64_CHARS[triple & 0x3F] : '=');
+        }
+        return encoded;
+    }
+}
+
 AdminAPI::AdminAPI(
     std::shared_ptr<BackgroundFrameFetcher> fetcher,
     std::shared_ptr<FrameStorageManager> storage
@@ -49,6 +70,14 @@ void AdminAPI::register_routes(WebServer& server) {
     server.add_route("POST", "/api/resume", [this](const std::string&, const std::string&) {
         return handle_post_resume().dump();
     });
+
+    server.add_route("POST", "/api/timeseries", [this](const std::string& body, const std::string&) {
+        return handle_post_timeseries(body).dump();
+    });
+
+    server.add_route("POST", "/api/frame", [this](const std::string& body, const std::string&) {
+        return handle_post_frame(body).dump();
+    });
 }
 
 json AdminAPI::handle_get_stations() {
@@ -148,6 +177,24 @@ json AdminAPI::handle_get_metrics() {
         metrics["disk_usage_gb"] = (double)disk_usage / (1024 * 1024 * 1024);
         metrics["frame_count"] = storage_->get_frame_count();
         metrics["storage_pending_tasks"] = storage_->num_pending_tasks();
+        if (storage_->object_sink_enabled()) {
+            auto sink = storage_->get_object_sink_stats();
+            metrics["upload_volumes_uploaded"] = sink.volumes_uploaded;
+            metrics["upload_volumes_failed"] = sink.volumes_failed;
+            metrics["upload_bytes"] = sink.bytes_uploaded;
+            metrics["upload_retries"] = sink.retries;
+            metrics["upload_queued"] = sink.queued;
+            metrics["upload_in_flight"] = sink.in_flight;
+        }
+        auto reads = storage_->get_read_stats();
+        metrics["frame_loads"] = reads.loads;
+        metrics["frame_loads_coalesced"] = reads.coalesced;
+        auto scrub = storage_->get_scrub_stats();
+        metrics["scrub_files_checked"] = scrub.files_checked;
+        metrics["scrub_bytes_checked"] = scrub.bytes_checked;
+        metrics["scrub_corrupt_found"] = scrub.corrupt_found;
+        metrics["scrub_unchecked"] = scrub.unchecked;
+        metrics["scrub_passes_completed"] = scrub.passes_completed;
     } else {
         metrics["disk_usage_mb"] = 0;
         metrics["disk_usage_gb"] = 0.0;
@@ -177,6 +224,18 @@ json AdminAPI::handle_get_config() {
         {"cleanup_interval_seconds", config.cleanup_interval_seconds},
         {"auto_cleanup_enabled", config.auto_cleanup_enabled},
         {"fetcher_thread_pool_size", config.fetcher_thread_pool_size},
+        {"download_workers", config.download_workers},
+        {"decode_workers", config.decode_workers},
+        {"store_workers", config.store_workers},
+        {"pipeline_queue_size", config.pipeline_queue_size},
+        {"shed_enabled", config.shed_enabled},
+        {"shed_degrade_wait_seconds", config.shed_degrade_wait_seconds},
+        {"shed_restore_wait_seconds", config.shed_restore_wait_seconds},
+        {"shed_degrade_backlog", config.shed_degrade_backlog},
+        {"shed_restore_backlog", config.shed_restore_backlog},
+        {"shed_hold_seconds", config.shed_hold_seconds},
+        {"shed_max_tilts", config.shed_max_tilts},
+        {"shed_priority_products", config.shed_priority_products},
         {"buffer_pool_size", config.buffer_pool_size},
         {"buffer_size_mb", config.buffer_size / (1024 * 1024)}
     };
@@ -194,6 +253,18 @@ json AdminAPI::handle_post_config(const std::string& body) {
         if (data.contains("cleanup_interval_seconds")) config.cleanup_interval_seconds = data["cleanup_interval_seconds"];
         if (data.contains("auto_cleanup_enabled")) config.auto_cleanup_enabled = data["auto_cleanup_enabled"];
         if (data.contains("fetcher_thread_pool_size")) config.fetcher_thread_pool_size = data["fetcher_thread_pool_size"];
+        if (data.contains("download_workers")) config.download_workers = data["download_workers"];
+        if (data.contains("decode_workers")) config.decode_workers = data["decode_workers"];
+        if (data.contains("store_workers")) config.store_workers = data["store_workers"];
+        if (data.contains("pipeline_queue_size")) config.pipeline_queue_size = data["pipeline_queue_size"];
+        if (data.contains("shed_enabled")) config.shed_enabled = data["shed_enabled"];
+        if (data.contains("shed_degrade_wait_seconds")) config.shed_degrade_wait_seconds = data["shed_degrade_wait_seconds"];
+        if (data.contains("shed_restore_wait_seconds")) config.shed_restore_wait_seconds = data["shed_restore_wait_seconds"];
+        if (data.contains("shed_degrade_backlog")) config.shed_degrade_backlog = data["shed_degrade_backlog"];
+        if (data.contains("shed_restore_backlog")) config.shed_restore_backlog = data["shed_restore_backlog"];
+        if (data.contains("shed_hold_seconds")) config.shed_hold_seconds = data["shed_hold_seconds"];
+        if (data.contains("shed_max_tilts")) config.shed_max_tilts = data["shed_max_tilts"];
+        if (data.contains("shed_priority_products")) config.shed_priority_products = data["shed_priority_products"].get<std::vector<std::string>>();
         if (data.contains("buffer_pool_size")) config.buffer_pool_size = data["buffer_pool_size"];
         if (data.contains("buffer_size_mb")) config.buffer_size = static_cast<size_t>(data["buffer_size_mb"]) * 1024 * 1024;
         
@@ -225,3 +296,88 @@ json AdminAPI::handle_post_resume() {
     fetcher_->start();
     return json{{"success", true}, {"status", "resumed"}};
 }
+
+json AdminAPI::handle_post_timeseries(const std::string& body) {
+    if (!storage_) return json{{"error", "Storage not initialized"}};
+    if (!storage_->timeseries_enabled()) return json{{"error", "Time-series archive disabled"}};
+
+    try {
+        auto data = json::parse(body);
+        TimeSeriesArchive::Query q;
+        q.station = data.value("station", "");
+        q.product = data.value("product", "reflectivity");
+        q.tilt = data.value("tilt", 0.5f);
+        q.start = data.value("start", "");
+        q.end = data.value("end", "99999999_999999");
+
+        if (q.station.empty()) return json{{"error", "Station name required"}};
+
+        // A point query is an area of zero extent
+        q.azimuth_min = data.value("azimuth_min", data.value("azimuth", 0.0f));
+        q.azimuth_max = data.value("azimuth_max", data.value("azimuth", 0.0f));
+        q.range_min_m = data.value("range_min_m", data.value("range_m", 0.0f));
+        q.range_max_m = data.value("range_max_m", data.value("range_m", 0.0f));
+        if (!std::isfinite(q.azimuth_min) || !std::isfinite(q.azimuth_max) ||
+            !std::isfinite(q.range_min_m) || !std::isfinite(q.range_max_m)) {
+            return json{{"error", "Azimuth and range must be finite numbers"}};
+        }
+
+        auto params = get_quant_params(q.product);
+        auto dequantize = [&params](float v) {
+            return params.value_min + (v / 255.0f) * (params.value_max - params.value_min);
+        };
+
+        json samples = json::array();
+        for (const auto& s : storage_->query_timeseries(q)) {
+            json entry = {{"timestamp", s.timestamp}, {"count", s.count}};
+            if (s.count > 0) {
+                entry["min"] = dequantize(s.min);
+                entry["max"] = dequantize(s.max);
+                entry["mean"] = dequantize(s.mean);
+            } else {
+                entry["min"] = nullptr;
+                entry["max"] = nullptr;
+                entry["mean"] = nullptr;
+            }
+            samples.push_back(entry);
+        }
+
+        return json{
+            {"station", q.station},
+            {"product", q.product},
+            {"tilt", q.tilt},
+            {"samples", samples}
+        };
+    } catch (const std::exception& e) {
+        return json{{"error", e.what()}};
+    }
+}
+
+json AdminAPI::handle_post_frame(const std::string& body) {
+    if (!storage_) return json{{"error", "Storage not initialized"}};
+
+    try {
+        auto data = json::parse(body);
+        std::string station = data.value("station", "");
+        std::string product = data.value("product", "reflectivity");
+        std::string timestamp = data.value("timestamp", "");
+        float tilt = data.value("tilt", 0.5f);
+
+        if (station.empty() || timestamp.empty()) return json{{"error", "Station and timestamp required"}};
+
+        // Requests for the same tilt that arrive together share one read
+        auto frame = storage_->load_frame_shared(station, product, timestamp, tilt);
+        if (!frame) return json{{"error", "Frame not found"}};
+
+        return json{
+            {"station", station},
+            {"product", product},
+            {"timestamp", timestamp},
+            {"tilt", tilt},
+            {"metadata", frame->metadata},
+            {"payload", base64_encode(frame->binary_data.data(), frame->binary_data.size())}
+        };
+    } catch (const std::exception& e) {
+        return json{{"error", e.what()}};
+    }
+}
@@ -13,11 +13,16 @@
 #include <csignal>
 #include <unistd.h>
 #include <atomic>
+#include <cctype>
+#include <map>
+#include <set>
+#include <sstream>
 
 #include "levelii/BackgroundFrameFetcher.h"
 #include "levelii/FrameStorageManager.h"
 #include "levelii/admin/AdminServer.h"
 #include "levelii/AWSInitializer.h"
+#include "levelii/S3ObjectStoreClient.h"
 #include "levelii/DecompressionUtils.h"
 #include "levelii/TerminalUI.h"
 #include <thread>
@@ -56,7 +61,19 @@ int main(int argc, char* argv[]) {
     bool terminal_ui_enabled = isatty(STDOUT_FILENO);
     bool save_individual_tilts = true;
     bool save_volumetric = true;
+    int timeseries_hours = 0;
+    int cmd_scrub_rate_mb = -1;
+    FrameStorageManager::TieringConfig tiering;
+    std::map<std::string, double> station_weights;
+    int cmd_base_scan_kb = -1;
+    std::set<std::string> base_only_stations;
+    int cmd_parse_threads = 0;
+    int cmd_max_range_km = -1;
+    int cmd_gate_stride = 0;
     std::string cmd_data_dir;
+    std::string cmd_sink_bucket;
+    std::string cmd_sink_endpoint;
+    std::string cmd_sink_prefix;
 
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
@@ -68,10 +85,68 @@ int main(int argc, char* argv[]) {
             save_individual_tilts = false;
         } else if (arg == "--no-volumetric") {
             save_volumetric = false;
+        } else if (arg == "--timeseries") {
+            timeseries_hours = 24;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                timeseries_hours = std::stoi(argv[++i]);
+            }
+        } else if (arg == "--scrub-rate" && i + 1 < argc) {
+            cmd_scrub_rate_mb = std::stoi(argv[++i]);
+        } else if (arg == "--tier" && i + 1 < argc) {
+            // PATH:MINUTES[:LEVEL]
+            std::string spec = argv[++i];
+            FrameStorageManager::TieringConfig::Tier tier;
+            size_t first = spec.rfind(':');
+            size_t second = first == std::string::npos || first == 0 ? std::string::npos : spec.rfind(':', first - 1);
+            if (first == std::string::npos) {
+                std::cerr << "--tier expects PATH:MINUTES[:LEVEL], got " << spec << std::endl;
+                return 1;
+            }
+            if (second != std::string::npos && spec.find_first_not_of("0123456789", second + 1) == first) {
+                tier.root = spec.substr(0, second);
+                tier.min_age_minutes = std::stoi(spec.substr(second + 1, first - second - 1));
+                tier.gzip_level = std::stoi(spec.substr(first + 1));
+            } else {
+                tier.root = spec.substr(0, first);
+                tier.min_age_minutes = std::stoi(spec.substr(first + 1));
+            }
+            tiering.tiers.push_back(tier);
+        } else if (arg == "--hot-level" && i + 1 < argc) {
+            tiering.hot_gzip_level = std::stoi(argv[++i]);
+        } else if (arg == "--station-weight" && i + 1 < argc) {
+            // STATION=WEIGHT
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            if (eq == std::string::npos || eq == 0) {
+                std::cerr << "--station-weight expects STATION=WEIGHT, got " << spec << std::endl;
+                return 1;
+            }
+            station_weights[spec.substr(0, eq)] = std::stod(spec.substr(eq + 1));
+        } else if (arg == "--base-scan-kb" && i + 1 < argc) {
+            cmd_base_scan_kb = std::stoi(argv[++i]);
+        } else if (arg == "--base-only" && i + 1 < argc) {
+            // STATION[,STATION...]
+            std::stringstream list(argv[++i]);
+            std::string station;
+            while (std::getline(list, station, ',')) {
+                if (!station.empty()) base_only_stations.insert(station);
+            }
         } else if (arg == "--threads" && i + 1 < argc) {
             cmd_threads = std::stoi(argv[++i]);
+        } else if (arg == "--parse-threads" && i + 1 < argc) {
+            cmd_parse_threads = std::stoi(argv[++i]);
+        } else if (arg == "--max-range" && i + 1 < argc) {
+            cmd_max_range_km = std::stoi(argv[++i]);
+        } else if (arg == "--gate-stride" && i + 1 < argc) {
+            cmd_gate_stride = std::stoi(argv[++i]);
         } else if (arg == "--data-dir" && i + 1 < argc) {
             cmd_data_dir = argv[++i];
+        } else if (arg == "--sink-bucket" && i + 1 < argc) {
+            cmd_sink_bucket = argv[++i];
+        } else if (arg == "--sink-endpoint" && i + 1 < argc) {
+            cmd_sink_endpoint = argv[++i];
+        } else if (arg == "--sink-prefix" && i + 1 < argc) {
+            cmd_sink_prefix = argv[++i];
         } else if (arg == "--buffer-count" && i + 1 < argc) {
             cmd_buffer_count = std::stoi(argv[++i]);
         } else if (arg == "--buffer-size" && i + 1 < argc) {
@@ -83,8 +158,21 @@ int main(int argc, char* argv[]) {
                       << "  --catchup        Enables catch-up of historical frames on startup\n"
                       << "  --no-individual-tilts Disable saving individual tilt files\n"
                       << "  --no-volumetric     Disable saving volumetric files\n"
+                      << "  --timeseries [H]    Keep a time-series archive of the last H hours (default 24)\n"
+                      << "  --scrub-rate MB     Checksum scrubber read budget in MB/s, 0 disables (default 8)\n"
+                      << "  --tier PATH:MIN[:L] Move volumes older than MIN minutes to PATH, recompressed at gzip level L (repeatable)\n"
+                      << "  --hot-level N       Gzip level for new frames when tiers are configured (default 9)\n"
+                      << "  --station-weight S=W Fetch share of station S while backlogged, relative to 1.0 (repeatable)\n"
+                      << "  --base-scan-kb N    Store the lowest tilts from the first N KB of each volume first\n"
+                      << "  --base-only LIST    Comma-separated stations that only store those lowest tilts\n"
                       << "  --threads N         Number of worker threads\n"
+                      << "  --parse-threads N   Threads one volume's sweeps are decoded on when few volumes are in flight (default 1)\n"
+                      << "  --max-range KM      Decode gates out to this range only, 0 decodes the full radial (default 230)\n"
+                      << "  --gate-stride N     Fold every N gates into one bin, keeping the maximum (default 1)\n"
                       << "  --data-dir PATH     Directory where Level II data will be stored\n"
+                      << "  --sink-bucket NAME  Also upload every volume to this object-store bucket\n"
+                      << "  --sink-endpoint URL S3-compatible endpoint for the sink (default: AWS)\n"
+                      << "  --sink-prefix P     Key prefix for uploaded objects\n"
                       << "  --buffer-count N    Number of pre-allocated buffers\n"
                       << "  --buffer-size N     Size of each buffer in MB\n"
                       << "  --help              Show this help message\n";
@@ -117,6 +205,37 @@ int main(int argc, char* argv[]) {
         std::cout << "   Level II: " << level2_data_path << std::endl;
 
         auto storage_manager = std::make_shared<FrameStorageManager>(level2_data_path);
+        if (timeseries_hours > 0) {
+            storage_manager->enable_timeseries_archive(timeseries_hours);
+            std::cout << "📈 Time-series archive enabled (" << timeseries_hours << "h retention)" << std::endl;
+        }
+        if (!tiering.tiers.empty()) {
+            storage_manager->enable_tiering(tiering);
+            std::cout << "🗄️  Storage tiers: " << level2_data_path;
+            for (const auto& tier : tiering.tiers) std::cout << " -> " << tier.root << " (" << tier.min_age_minutes << " min)";
+            std::cout << std::endl;
+        }
+
+        // Object-store sink (Priority: CLI > Environment)
+        const char* env_sink_bucket = std::getenv("NEXRAD_SINK_BUCKET");
+        const char* env_sink_endpoint = std::getenv("NEXRAD_SINK_ENDPOINT");
+        const char* env_sink_prefix = std::getenv("NEXRAD_SINK_PREFIX");
+        if (cmd_sink_bucket.empty() && env_sink_bucket) cmd_sink_bucket = env_sink_bucket;
+        if (cmd_sink_endpoint.empty() && env_sink_endpoint) cmd_sink_endpoint = env_sink_endpoint;
+        if (cmd_sink_prefix.empty() && env_sink_prefix) cmd_sink_prefix = env_sink_prefix;
+
+        if (!cmd_sink_bucket.empty()) {
+            // The sink's client needs the SDK before the first volume is published
+            AWSInitializer::instance().initialize();
+
+            ObjectSinkConfig sink_config;
+            sink_config.key_prefix = cmd_sink_prefix;
+            storage_manager->enable_object_sink(
+                std::make_unique<S3ObjectStoreClient>(cmd_sink_bucket, cmd_sink_endpoint), sink_config);
+            std::cout << "☁️  Object sink enabled: s3://" << cmd_sink_bucket
+                      << (cmd_sink_prefix.empty() ? "" : "/" + cmd_sink_prefix)
+                      << (cmd_sink_endpoint.empty() ? "" : " via " + cmd_sink_endpoint) << std::endl;
+        }
 
         FrameFetcherConfig fetcher_config;
 
@@ -149,6 +268,15 @@ int main(int argc, char* argv[]) {
         if (cmd_threads > 0) fetcher_config.fetcher_thread_pool_size = cmd_threads;
         else if (env_threads) fetcher_config.fetcher_thread_pool_size = std::stoi(env_threads);
 
+        const char* env_parse_threads = std::getenv("NEXRAD_PARSE_THREADS");
+        if (cmd_parse_threads > 0) fetcher_config.parse_threads = cmd_parse_threads;
+        else if (env_parse_threads) fetcher_config.parse_threads = std::stoi(env_parse_threads);
+
+        const char* env_max_range = std::getenv("NEXRAD_MAX_RANGE_KM");
+        if (cmd_max_range_km >= 0) fetcher_config.decode_max_range_meters = cmd_max_range_km * 1000.0f;
+        else if (env_max_range) fetcher_config.decode_max_range_meters = std::stoi(env_max_range) * 1000.0f;
+        if (cmd_gate_stride > 0) fetcher_config.decode_gate_stride = cmd_gate_stride;
+
         const char* env_buffer_count = std::getenv("NEXRAD_BUFFER_COUNT");
         if (cmd_buffer_count > 0) fetcher_config.buffer_pool_size = cmd_buffer_count;
         else if (env_buffer_count) fetcher_config.buffer_pool_size = std::stoi(env_buffer_count);
@@ -164,9 +292,20 @@ int main(int argc, char* argv[]) {
         fetcher_config.generate_3d = true; // Always on
         fetcher_config.save_individual_tilts = save_individual_tilts;
         fetcher_config.save_volumetric = save_volumetric;
+        fetcher_config.station_weights = station_weights;
+        if (cmd_base_scan_kb >= 0) fetcher_config.base_scan_bytes = static_cast<size_t>(cmd_base_scan_kb) * 1024;
+        if (!base_only_stations.empty()) fetcher_config.base_only_stations = base_only_stations;
+        if (cmd_scrub_rate_mb == 0) {
+            fetcher_config.scrub_enabled = false;
+        } else if (cmd_scrub_rate_mb > 0) {
+            fetcher_config.scrub_bytes_per_second = static_cast<size_t>(cmd_scrub_rate_mb) * 1024 * 1024;
+        }
 
         std::cout << "⚙️  Performance Config: "
                   << fetcher_config.fetcher_thread_pool_size << " threads, "
+                  << fetcher_config.parse_threads << " parse threads, "
+                  << "max range " << fetcher_config.decode_max_range_meters / 1000.0f << "km, "
+                  << "gate stride " << fetcher_config.decode_gate_stride << ", "
                   << fetcher_config.buffer_pool_size << " buffers ("
                   << fetcher_config.buffer_size / (1024 * 1024) << "MB each), "
                   << "catchup=" << (fetcher_config.catchup_enabled ? "on" : "off") << ", "
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <algorithm>
+#include "levelii/BackgroundFrameFetcher.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const std::string STATION = "KTLX";
+    const std::string TIMESTAMP = "20260209_162244";
+
+    size_t indexed_tilts(const FrameStorageManager& storage, const std::string& product) {
+        size_t count = 0;
+        json index = storage.get_index(STATION, product);
+        for (const auto& frame : index["f"]) {
+            if (frame["t"] == TIMESTAMP) count++;
+        }
+        return count;
+    }
+
+    /**
+     * Serves one Level II file from memory in place of S3 and notes what the
+     * index held when the fetcher asked for the rest of the object.
+     */
+    class FileFetcher : public BackgroundFrameFetcher {
+    public:
+        FileFetcher(std::shared_ptr<FrameStorageManager> storage, const FrameFetcherConfig& config, const std::string& data_path,
+                    std::vector<uint8_t> object)
+            : BackgroundFrameFetcher(storage, config, data_path), storage_(std::move(storage)), object_(std::move(object)) {}
+
+        std::atomic<int> tail_reads{0};
+        std::atomic<size_t> indexed_at_tail{0};
+
+    protected:
+        FetchResult fetch_object(const DiscoveryItem&, size_t begin, size_t length, std::vector<uint8_t>& out, size_t& object_size,
+                                 const CancellationToken&) override {
+            if (begin > 0 && length == 0) {
+                tail_reads.fetch_add(1);
+                indexed_at_tail = indexed_tilts(*storage_, "reflectivity");
+            }
+            size_t end = length > 0 ? std::min(object_.size(), begin + length) : object_.size();
+            if (begin > end) return FetchResult::Failed;
+            out.insert(out.end(), object_.begin() + begin, object_.begin() + end);
+            object_size = object_.size();
+            return FetchResult::Ok;
+        }
+
+    private:
+        std::shared_ptr<FrameStorageManager> storage_;
+        std::vector<uint8_t> object_;
+    };
+}
+
+bool test_base_tilts_indexed_before_tail(const std::string& level2_path, const std::string& root) {
+    std::cout << "\n=== BASE SCAN PUBLISH TEST ===\n";
+    std::ifstream file(level2_path, std::ios::binary);
+    std::vector<uint8_t> object((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (object.empty()) {
+        std::cout << "❌ FAILED: cannot read " << level2_path << "\n";
+        return false;
+    }
+
+    auto storage = std::make_shared<FrameStorageManager>(root + "/frames");
+    DurableWorkQueue::Item work{STATION, "2026/02/09/KTLX/KTLX20260209_162244_V06", "unidata-nexrad-level2", TIMESTAMP};
+    storage->work_queue().add({work});
+
+    FrameFetcherConfig config;
+    config.products = {"reflectivity", "velocity"};
+    config.base_scan_bytes = 256 * 1024;
+    config.generate_3d = false;
+    config.save_volumetric = false;
+    config.scrub_enabled = false;
+    config.fetcher_thread_pool_size = 2;
+
+    FileFetcher fetcher(storage, config, root, std::move(object));
+    fetcher.start();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(120);
+    while (storage->work_queue().size() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    fetcher.stop();
+
+    size_t base = fetcher.indexed_at_tail.load();
+    size_t full = indexed_tilts(*storage, "reflectivity");
+    std::cout << "   " << base << " reflectivity tilts indexed before the rest was fetched, " << full << " after\n";
+    if (fetcher.tail_reads.load() != 1 || storage->work_queue().size() != 0) {
+        std::cout << "❌ FAILED: volume was not fetched as base scan then tail\n";
+        return false;
+    }
+    if (base == 0 || base >= full) {
+        std::cout << "❌ FAILED: base tilts were not indexed before the tail was fetched\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <level2_file>\n";
+        return 1;
+    }
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "BASE SCAN TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_base_scan_data";
+    fs::remove_all(root);
+
+    bool ok = test_base_tilts_indexed_before_tail(argv[1], root);
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Base scan tests passed.\n" : "Base scan tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <limits>
+#include "levelii/BitmaskCodec.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct Packed {
+        std::vector<uint8_t> grid;
+        std::vector<uint8_t> bitmask;
+        std::vector<uint8_t> values;
+    };
+
+    // `density` in 1/16ths; values are never 0, as in files written by the fetcher
+    Packed make_packed(size_t cells, uint32_t density, uint32_t seed) {
+        Packed p;
+        p.grid.assign(cells, 0);
+        p.bitmask.assign((cells + 7) / 8, 0);
+        uint32_t state = seed;
+        for (size_t i = 0; i < cells; ++i) {
+            state = state * 1664525u + 1013904223u;
+            if ((state >> 28) < density) {
+                p.grid[i] = static_cast<uint8_t>(1 + ((state >> 8) % 255));
+                p.bitmask[i / 8] |= (1 << (7 - (i % 8)));
+                p.values.push_back(p.grid[i]);
+            }
+        }
+        return p;
+    }
+
+    // Bit-by-bit reference, as the .RDA format describes it
+    size_t reference(const Packed& p, size_t first_bit, size_t cells, size_t value_count, std::vector<uint8_t>& out) {
+        out.assign(cells, 0);
+        size_t v = 0;
+        for (size_t i = 0; i < cells; ++i) {
+            size_t bit = first_bit + i;
+            if ((p.bitmask[bit / 8] >> (7 - bit % 8)) & 1) {
+                if (v < value_count) out[i] = p.values[v++];
+            }
+        }
+        return v;
+    }
+}
+
+bool test_expand_matches_reference() {
+    std::cout << "\n=== BITMASK EXPAND TEST ===\n";
+    std::cout << "   SIMD: " << (BitmaskCodec::simd_accelerated() ? "yes" : "no") << "\n";
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const auto table = BitmaskCodec::dequant_table(-32.0f, 94.5f, nan);
+
+    for (uint32_t density : {0u, 1u, 5u, 14u, 16u}) {
+        Packed p = make_packed(20011, density, density + 3);
+        for (size_t first_bit : {0, 1, 7, 8, 13, 200}) {
+            for (size_t cells : {0, 1, 9, 64, 1000, 20011 - 200}) {
+                size_t skipped = 0;
+                for (size_t b = 0; b < first_bit; ++b) skipped += (p.bitmask[b / 8] >> (7 - b % 8)) & 1;
+                const uint8_t* values = p.values.data() + skipped;
+                size_t available = p.values.size() - skipped;
+                // Full value array, and one that runs out early
+                for (size_t value_count : {available, available / 2}) {
+                    std::vector<uint8_t> expected, levels(cells);
+                    std::vector<float> physical(cells);
+                    Packed shifted = p;
+                    shifted.values.assign(values, values + available);
+                    size_t expected_used = reference(shifted, first_bit, cells, value_count, expected);
+                    size_t used = BitmaskCodec::expand(p.bitmask.data(), first_bit, cells, values, value_count, levels.data());
+                    size_t used_f = BitmaskCodec::expand(p.bitmask.data(), first_bit, cells, values, value_count, table, physical.data());
+                    bool ok = used == expected_used && used_f == expected_used && levels == expected;
+                    for (size_t i = 0; ok && i < cells; ++i) {
+                        ok = expected[i] == 0 ? std::isnan(physical[i]) : physical[i] == table.value[expected[i]];
+                    }
+                    if (!ok) {
+                        std::cout << "❌ FAILED: density " << density << "/16, first bit " << first_bit << ", " << cells
+                                  << " cells, " << value_count << " values\n";
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_rank_index() {
+    std::cout << "\n=== RANK INDEX TEST ===\n";
+    for (uint32_t density : {0u, 3u, 16u}) {
+        for (size_t cells : {1, 7, 512, 513, 4099}) {
+            Packed p = make_packed(cells, density, density + cells);
+            // Padding bits after the last cell must not be counted
+            if (cells % 8) p.bitmask.back() |= (1 << (8 - cells % 8)) - 1;
+            BitmaskCodec::RankIndex index(p.bitmask.data(), cells);
+            size_t ones = 0;
+            for (size_t bit = 0; bit <= cells; ++bit) {
+                if (index.rank(bit) != ones) {
+                    std::cout << "❌ FAILED: rank(" << bit << ") of " << cells << " cells is " << index.rank(bit) << ", expected " << ones << "\n";
+                    return false;
+                }
+                if (bit < cells && index.test(bit) != (p.grid[bit] != 0)) {
+                    std::cout << "❌ FAILED: test(" << bit << ")\n";
+                    return false;
+                }
+                if (bit < cells) ones += p.grid[bit] != 0;
+            }
+            if (index.count() != p.values.size()) {
+                std::cout << "❌ FAILED: count " << index.count() << " of " << cells << " cells\n";
+                return false;
+            }
+        }
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_dense_tilt_speed() {
+    std::cout << "\n=== DENSE TILT DECODE TEST ===\n";
+    const size_t cells = 720 * 1832;
+    Packed p = make_packed(cells, 5, 9);
+    const auto table = BitmaskCodec::dequant_table(-32.0f, 94.5f, std::numeric_limits<float>::quiet_NaN());
+    std::vector<uint8_t> levels(cells);
+    std::vector<float> physical(cells);
+
+    const int rounds = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) BitmaskCodec::expand(p.bitmask.data(), 0, cells, p.values.data(), p.values.size(), levels.data());
+    double level_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / rounds;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        BitmaskCodec::expand(p.bitmask.data(), 0, cells, p.values.data(), p.values.size(), table, physical.data());
+    }
+    double float_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / rounds;
+    std::cout << "   720x1832 tilt, 31% filled: uint8 grid " << level_us << " us, float grid " << float_us << " us\n";
+    if (levels != p.grid) {
+        std::cout << "❌ FAILED: dense grid differs\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_load_frame_grid(const std::string& root) {
+    std::cout << "\n=== LOAD FRAME GRID TEST ===\n";
+    FrameStorageManager manager(root);
+    const uint16_t rays = 360, gates = 203;
+    Packed p = make_packed(rays * gates, 6, 21);
+    manager.save_frame_bitmask("KTLX", "velocity", "20260215_150000", 0.5f, rays, gates, 250.0f, 2125.0f, p.bitmask, p.values);
+
+    std::vector<uint8_t> levels;
+    std::vector<float> physical;
+    json metadata;
+    QuantizationParams params{-100.0f, 100.0f, 0.0f, 230000.0f};
+    if (!manager.load_frame_grid("KTLX", "velocity", "20260215_150000", 0.5f, levels, &metadata) ||
+        !manager.load_frame_grid("KTLX", "velocity", "20260215_150000", 0.5f, params, physical) ||
+        levels != p.grid || metadata.value("r", 0) != rays) {
+        std::cout << "❌ FAILED: stored grid does not round-trip\n";
+        return false;
+    }
+    for (size_t i = 0; i < levels.size(); ++i) {
+        float expected = -100.0f + (levels[i] / 255.0f) * 200.0f;
+        if (levels[i] == 0 ? !std::isnan(physical[i]) : std::fabs(physical[i] - expected) > 1e-4f) {
+            std::cout << "❌ FAILED: cell " << i << " dequantized to " << physical[i] << "\n";
+            return false;
+        }
+    }
+    std::vector<uint8_t> missing;
+    if (manager.load_frame_grid("KTLX", "velocity", "20260215_150000", 1.5f, missing)) {
+        std::cout << "❌ FAILED: missing tilt loaded\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "BITMASK CODEC TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_bitmask_codec_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    ok = test_expand_matches_reference() && ok;
+    ok = test_rank_index() && ok;
+    ok = test_dense_tilt_speed() && ok;
+    ok = test_load_frame_grid(root) && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Bitmask codec tests passed.\n" : "Bitmask codec tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
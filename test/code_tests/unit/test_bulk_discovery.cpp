@@ -0,0 +1,199 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <set>
+#include <map>
+#include <cstdio>
+#include "levelii/BulkDiscovery.h"
+
+namespace {
+    const std::string TODAY = "2026/02/15/";
+    const std::string YESTERDAY = "2026/02/14/";
+
+    // In-memory bucket with ListObjectsV2 paging: 1000 keys per response, in key order
+    struct FakeBucket {
+        std::set<std::string> keys;
+        size_t fail_after = SIZE_MAX;
+        size_t calls = 0;
+
+        bool list(const std::string& prefix, const std::string& start_after, BulkDiscovery::Page& page) {
+            if (calls++ >= fail_after) return false;
+            auto it = start_after < prefix ? keys.lower_bound(prefix) : keys.upper_bound(start_after);
+            for (; it != keys.end() && it->compare(0, prefix.size(), prefix) == 0; ++it) {
+                if (page.keys.size() == 1000) {
+                    page.truncated = true;
+                    break;
+                }
+                page.keys.push_back(*it);
+            }
+            return true;
+        }
+
+        BulkDiscovery::ListPage lister() {
+            return [this](const std::string& prefix, const std::string& start_after, BulkDiscovery::Page& page) {
+                return list(prefix, start_after, page);
+            };
+        }
+    };
+
+    std::string key(const std::string& day, const std::string& station, int minute) {
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s_%02d%02d00_V06", (station + day.substr(0, 4) + day.substr(5, 2) + day.substr(8, 2)).c_str(),
+                      minute / 60, minute % 60);
+        return day + station + "/" + name;
+    }
+
+    std::string station_name(int i) {
+        char name[8];
+        std::snprintf(name, sizeof(name), "K%c%c%c", 'A' + i / 26 % 26, 'A' + i % 26, 'A' + i % 7);
+        return name;
+    }
+
+    BulkDiscovery::Result scan_all(FakeBucket& bucket, const std::string& prefix, const std::map<std::string, std::string>& marks,
+                                   size_t parallelism) {
+        BulkDiscovery::Result found;
+        for (const auto& range : BulkDiscovery::partition(prefix, marks, parallelism)) {
+            BulkDiscovery::Result part;
+            BulkDiscovery::scan(prefix, range, marks, bucket.lister(), part);
+            BulkDiscovery::merge(found, std::move(part));
+        }
+        return found;
+    }
+
+    // Every key of the prefix above its station's mark
+    std::map<std::string, std::vector<std::string>> expected_new(const FakeBucket& bucket, const std::string& prefix,
+                                                                 const std::map<std::string, std::string>& marks) {
+        std::map<std::string, std::vector<std::string>> expected;
+        for (const auto& k : bucket.keys) {
+            if (k.compare(0, prefix.size(), prefix) != 0) continue;
+            std::string station = BulkDiscovery::station_of(k);
+            auto it = marks.find(station);
+            if (it == marks.end() || k > it->second) expected[station].push_back(k);
+        }
+        return expected;
+    }
+}
+
+bool test_finds_new_objects() {
+    std::cout << "\n=== BULK DISCOVERY CORRECTNESS TEST ===\n";
+    FakeBucket bucket;
+    std::map<std::string, std::string> marks;
+    for (int s = 0; s < 40; ++s) {
+        std::string station = station_name(s * 3 + 1);
+        int volumes = 20 + s * 7;
+        for (int v = 0; v < volumes; ++v) bucket.keys.insert(key(TODAY, station, v * 5));
+        if (s % 5 == 0) {
+            marks[station] = key(YESTERDAY, station, 1435);  // Nothing seen today yet
+        } else if (s % 5 != 1) {
+            marks[station] = key(TODAY, station, (volumes - 1 - s % 4) * 5);
+        }                                                     // s % 5 == 1: station never seen
+    }
+    // A station that sorts before every known one, and one that went quiet
+    bucket.keys.insert(key(TODAY, "KAAA", 0));
+    marks["KZZZ"] = key(YESTERDAY, "KZZZ", 100);
+
+    for (size_t parallelism : {1, 3, 10, 64}) {
+        auto found = scan_all(bucket, TODAY, marks, parallelism);
+        if (found.keys != expected_new(bucket, TODAY, marks) || !found.complete) {
+            std::cout << "❌ FAILED: wrong objects found with " << parallelism << " ranges\n";
+            return false;
+        }
+        std::cout << "   " << parallelism << " ranges: " << found.requests << " listings, " << found.keys_listed << " of "
+                  << bucket.keys.size() << " keys returned\n";
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_request_count() {
+    std::cout << "\n=== BULK DISCOVERY REQUEST COUNT TEST ===\n";
+    // 160 stations, one volume every 5 minutes; each has 1-2 volumes since its mark
+    for (int hour : {1, 12, 23}) {
+        FakeBucket bucket;
+        std::map<std::string, std::string> marks;
+        int volumes = hour * 12;
+        for (int s = 0; s < 160; ++s) {
+            std::string station = station_name(s);
+            for (int v = 0; v < volumes; ++v) bucket.keys.insert(key(TODAY, station, v * 5));
+            marks[station] = key(TODAY, station, (volumes - 2 - s % 2) * 5);
+        }
+        auto found = scan_all(bucket, TODAY, marks, 10);
+        size_t new_objects = 0;
+        for (const auto& [station, keys] : found.keys) new_objects += keys.size();
+        std::cout << "   " << hour << ":00 UTC, " << bucket.keys.size() << " keys: " << found.requests << " listings in 10 ranges for "
+                  << new_objects << " new objects (per-station scans: " << 2 * 160 + 2 << ")\n";
+        if (found.keys != expected_new(bucket, TODAY, marks) || found.requests > 60) {
+            std::cout << "❌ FAILED\n";
+            return false;
+        }
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_partial_listing() {
+    std::cout << "\n=== BULK DISCOVERY FAILED LISTING TEST ===\n";
+    FakeBucket bucket;
+    std::map<std::string, std::string> marks;
+    for (int s = 0; s < 30; ++s) {
+        std::string station = station_name(s);
+        for (int v = 0; v < 200; ++v) bucket.keys.insert(key(TODAY, station, v * 5));
+        marks[station] = key(TODAY, station, (s * 6) * 5);
+    }
+    auto expected = expected_new(bucket, TODAY, marks);
+    for (size_t fail_after = 0; fail_after < 6; ++fail_after) {
+        bucket.fail_after = fail_after;
+        bucket.calls = 0;
+        BulkDiscovery::Result found;
+        BulkDiscovery::scan(TODAY, BulkDiscovery::partition(TODAY, marks, 1)[0], marks, bucket.lister(), found);
+        // Whatever was found continues each station's mark without gaps
+        for (const auto& [station, keys] : found.keys) {
+            const auto& all = expected[station];
+            if (found.complete || keys.size() > all.size() || !std::equal(keys.begin(), keys.end(), all.begin())) {
+                std::cout << "❌ FAILED: gap in " << station << " after " << fail_after << " listings\n";
+                return false;
+            }
+        }
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_finished_day() {
+    std::cout << "\n=== BULK DISCOVERY FINISHED DAY TEST ===\n";
+    // Yesterday, with every mark already in today: a station's keys are skipped as soon as the listing reaches it
+    FakeBucket bucket;
+    std::map<std::string, std::string> marks;
+    for (int s = 0; s < 20; ++s) {
+        std::string station = station_name(s);
+        for (int v = 0; v < 288; ++v) bucket.keys.insert(key(YESTERDAY, station, v * 5));
+        marks[station] = key(TODAY, station, 10);
+    }
+    marks[station_name(7)] = key(YESTERDAY, station_name(7), 280 * 5);
+    auto found = scan_all(bucket, YESTERDAY, marks, 1);
+    if (found.keys != expected_new(bucket, YESTERDAY, marks) || found.keys.size() != 1 || found.keys[station_name(7)].size() != 7) {
+        std::cout << "❌ FAILED: finished stations reported new objects\n";
+        return false;
+    }
+    std::cout << "   " << found.requests << " listings over " << bucket.keys.size() << " keys\n";
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "BULK DISCOVERY TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    bool ok = true;
+    ok = test_finds_new_objects() && ok;
+    ok = test_request_count() && ok;
+    ok = test_partial_listing() && ok;
+    ok = test_finished_day() && ok;
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Bulk discovery tests passed.\n" : "Bulk discovery tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
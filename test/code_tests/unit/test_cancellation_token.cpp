@@ -0,0 +1,132 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include "levelii/CancellationToken.h"
+
+using Reason = CancellationToken::Reason;
+using namespace std::chrono_literals;
+
+bool test_hierarchy() {
+    std::cout << "\n=== CANCELLATION HIERARCHY TEST ===\n";
+    CancellationToken process;
+    CancellationToken pools = process.child();
+    CancellationToken item_a = pools.child();
+    CancellationToken item_b = pools.child();
+
+    // Cancelling a child leaves its parent and siblings running
+    item_a.cancel();
+    if (!item_a.cancelled() || item_b.cancelled() || pools.cancelled() || process.cancelled()) {
+        std::cout << "❌ FAILED: cancelling an item reached beyond it\n";
+        return false;
+    }
+
+    // Cancelling the root reaches every descendant, including ones derived afterwards
+    process.cancel();
+    CancellationToken late = pools.child();
+    if (!item_b.cancelled() || !pools.cancelled() || !late.cancelled() || late.reason() != Reason::Cancelled) {
+        std::cout << "❌ FAILED: cancelling the process did not reach its descendants\n";
+        return false;
+    }
+
+    // Copies share state
+    CancellationToken root;
+    CancellationToken copy = root;
+    copy.cancel();
+    if (!root.cancelled()) {
+        std::cout << "❌ FAILED: copy does not share state\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_deadlines() {
+    std::cout << "\n=== DEADLINE TEST ===\n";
+    CancellationToken process;
+    CancellationToken batch = process.child(50ms);
+    CancellationToken item = batch.child(10s);
+    CancellationToken quick = batch.child(5ms);
+
+    if (item.deadline() != batch.deadline() || quick.deadline() >= batch.deadline() || process.cancelled()) {
+        std::cout << "❌ FAILED: child deadlines not capped by the parent's\n";
+        return false;
+    }
+    std::this_thread::sleep_for(20ms);
+    if (quick.reason() != Reason::DeadlineExceeded || item.cancelled() || batch.cancelled()) {
+        std::cout << "❌ FAILED: a child deadline affected its parent\n";
+        return false;
+    }
+    std::this_thread::sleep_for(50ms);
+    if (item.reason() != Reason::DeadlineExceeded || process.cancelled()) {
+        std::cout << "❌ FAILED: an inherited deadline was not enforced\n";
+        return false;
+    }
+
+    // An explicit cancel takes precedence over an expired deadline
+    quick.cancel();
+    if (quick.reason() != Reason::Cancelled) {
+        std::cout << "❌ FAILED: wrong reason for a cancelled token past its deadline\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_shutdown_latency() {
+    std::cout << "\n=== SHUTDOWN LATENCY TEST ===\n";
+    // Workers stand in for the tilt loop: a chunk of branch-free work, then one check
+    CancellationToken process;
+    CancellationToken pools = process.child();
+    std::atomic<size_t> chunks{0};
+    std::vector<std::chrono::steady_clock::time_point> stopped_at(4);
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < stopped_at.size(); ++w) {
+        workers.emplace_back([&, w] {
+            CancellationToken item = pools.child(60s);
+            std::vector<uint8_t> grid(1 << 16);
+            while (!item.cancelled()) {
+                for (size_t i = 0; i < grid.size(); ++i) grid[i] = static_cast<uint8_t>(grid[i] * 31 + i);
+                chunks.fetch_add(1);
+            }
+            stopped_at[w] = std::chrono::steady_clock::now();
+        });
+    }
+    std::this_thread::sleep_for(50ms);
+    auto cancelled_at = std::chrono::steady_clock::now();
+    process.cancel();
+    for (auto& worker : workers) worker.join();
+
+    double worst_ms = 0;
+    for (const auto& t : stopped_at) {
+        worst_ms = std::max(worst_ms, std::chrono::duration<double, std::milli>(t - cancelled_at).count());
+    }
+    std::cout << "   " << chunks.load() << " chunks before cancel, all workers stopped within " << worst_ms << " ms\n";
+    if (worst_ms > 500) {
+        std::cout << "❌ FAILED: workers took too long to stop\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "CANCELLATION TOKEN TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    bool ok = true;
+    ok = test_hierarchy() && ok;
+    ok = test_deadlines() && ok;
+    ok = test_shutdown_latency() && ok;
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Cancellation token tests passed.\n" : "Cancellation token tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include "levelii/Checksum.h"
+#include "levelii/ZlibUtils.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    std::vector<uint8_t> make_payload(size_t size) {
+        std::vector<uint8_t> data(size);
+        uint32_t state = 7;
+        for (auto& b : data) {
+            state = state * 1664525u + 1013904223u;
+            b = static_cast<uint8_t>((state >> 24) & 0x3F);
+        }
+        return data;
+    }
+
+    void save_frame(FrameStorageManager& manager, const std::string& timestamp, float tilt) {
+        const uint16_t num_rays = 360, num_gates = 200;
+        std::vector<uint8_t> bitmask((num_rays * num_gates + 7) / 8, 0xAA);
+        std::vector<uint8_t> values = make_payload(num_rays * num_gates / 2);
+        manager.save_frame_bitmask("KTLX", "reflectivity", timestamp, tilt, num_rays, num_gates, 250.0f, 2125.0f, bitmask, values);
+    }
+}
+
+bool test_crc32c_vectors() {
+    std::cout << "\n=== CRC32C KNOWN VALUES TEST ===\n";
+    const std::string check = "123456789";
+    uint32_t crc = Checksum::crc32c(reinterpret_cast<const uint8_t*>(check.data()), check.size());
+    if (crc != 0xE3069283u) {
+        std::cout << "❌ FAILED: crc32c(\"123456789\") = " << std::hex << crc << std::dec << "\n";
+        return false;
+    }
+
+    // Chained calls must match a single pass over unaligned, odd-length input
+    auto data = make_payload(100003);
+    uint32_t whole = Checksum::crc32c(data.data() + 1, data.size() - 1);
+    uint32_t chained = Checksum::crc32c(data.data() + 1, 12345);
+    chained = Checksum::crc32c(data.data() + 1 + 12345, data.size() - 1 - 12345, chained);
+    if (whole != chained) {
+        std::cout << "❌ FAILED: chained CRC differs\n";
+        return false;
+    }
+    std::cout << "   hardware accelerated: " << (Checksum::crc32c_hardware_accelerated() ? "yes" : "no") << "\n";
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_gzip_embedded_crc() {
+    std::cout << "\n=== GZIP EMBEDDED CRC TEST ===\n";
+    auto data = make_payload(50000);
+    auto compressed = ZlibUtils::gzip_compress_with_crc(data.data(), data.size());
+
+    if (ZlibUtils::gzip_decompress(compressed.data(), compressed.size()) != data) {
+        std::cout << "❌ FAILED: payload does not round-trip through a standard gzip reader\n";
+        return false;
+    }
+    uint32_t stored = 0;
+    if (ZlibUtils::verify_gzip_crc(compressed.data(), compressed.size(), &stored) != ZlibUtils::GzipCrcStatus::Valid) {
+        std::cout << "❌ FAILED: fresh stream did not verify\n";
+        return false;
+    }
+    uint32_t header_only = 0;
+    if (ZlibUtils::verify_gzip_crc(compressed.data(), 32, &header_only, false) != ZlibUtils::GzipCrcStatus::Valid || header_only != stored) {
+        std::cout << "❌ FAILED: CRC not readable from the header alone\n";
+        return false;
+    }
+
+    auto flipped = compressed;
+    flipped[flipped.size() / 2] ^= 0x01;
+    auto truncated = std::vector<uint8_t>(compressed.begin(), compressed.end() - 9);
+    if (ZlibUtils::verify_gzip_crc(flipped.data(), flipped.size()) != ZlibUtils::GzipCrcStatus::Mismatch ||
+        ZlibUtils::verify_gzip_crc(truncated.data(), truncated.size()) != ZlibUtils::GzipCrcStatus::Mismatch) {
+        std::cout << "❌ FAILED: corruption not detected\n";
+        return false;
+    }
+
+    auto legacy = ZlibUtils::gzip_compress(data.data(), data.size());
+    if (ZlibUtils::verify_gzip_crc(legacy.data(), legacy.size()) != ZlibUtils::GzipCrcStatus::Missing) {
+        std::cout << "❌ FAILED: plain gzip should report Missing\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_load_rejects_corruption(const std::string& root) {
+    std::cout << "\n=== LOAD VERIFICATION TEST ===\n";
+    FrameStorageManager manager(root);
+    save_frame(manager, "20260215_150000", 0.5f);
+
+    FrameStorageManager::CompressedFrameData out;
+    if (!manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_150000", 0.5f, out)) {
+        std::cout << "❌ FAILED: clean frame did not load\n";
+        return false;
+    }
+    // The payload is a view into the inflated file; a copy must view its own buffer
+    FrameStorageManager::CompressedFrameData copy = out;
+    if (copy.binary_data.size() != out.binary_data.size() || copy.binary_data.empty() ||
+        copy.binary_data.data() < copy.inflated.data() ||
+        copy.binary_data.end() != copy.inflated.data() + copy.inflated.size() ||
+        !std::equal(copy.binary_data.begin(), copy.binary_data.end(), out.binary_data.begin())) {
+        std::cout << "❌ FAILED: copied frame does not view its own buffer\n";
+        return false;
+    }
+
+    levelii::SQLiteDatabase db(root + "/index.db");
+    auto rows = db.query("SELECT crc32c FROM levelii_frames WHERE timestamp = '20260215_150000';");
+    if (rows.size() != 1 || rows[0]["crc32c"].is_null()) {
+        std::cout << "❌ FAILED: checksum not recorded in the index\n";
+        return false;
+    }
+
+    std::string path = manager.get_frame_path("KTLX", "reflectivity", "20260215_150000", 0.5f);
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-20, std::ios::end);
+        file.put('\x5A');
+    }
+    if (manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_150000", 0.5f, out)) {
+        std::cout << "❌ FAILED: corrupt frame loaded\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_scrubber(const std::string& root) {
+    std::cout << "\n=== SCRUBBER TEST ===\n";
+    FrameStorageManager manager(root);
+    for (int i = 0; i < 4; ++i) save_frame(manager, "20260215_16000" + std::to_string(i), 0.5f);
+
+    // Bad frame: bytes flipped on disk after it was written
+    std::string bad = manager.get_frame_path("KTLX", "reflectivity", "20260215_160002", 0.5f);
+    {
+        std::fstream file(bad, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(40);
+        file.put('\x00');
+        file.put('\xFF');
+    }
+    // Legacy frame: plain gzip with no checksum anywhere is counted, not flagged
+    std::string legacy_dir = root + "/KTLX/reflectivity/20260215_150000";
+    fs::create_directories(legacy_dir);
+    auto payload = make_payload(1000);
+    auto legacy = ZlibUtils::gzip_compress(payload.data(), payload.size());
+    std::ofstream(legacy_dir + "/0.5.RDA", std::ios::binary).write(reinterpret_cast<const char*>(legacy.data()), legacy.size());
+    manager.update_index("KTLX", "reflectivity");
+
+    std::mutex mutex;
+    std::vector<std::string> reported;
+    FrameStorageManager::ScrubberConfig config;
+    config.bytes_per_second = 64 * 1024 * 1024;
+    config.pass_interval_seconds = 3600;
+    manager.start_scrubber(config, [&](const std::string&, const std::string&, const std::string& timestamp, const std::string&) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reported.push_back(timestamp);
+    });
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (manager.get_scrub_stats().passes_completed == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    auto start = std::chrono::steady_clock::now();
+    manager.stop_scrubber();
+    if (std::chrono::steady_clock::now() - start > std::chrono::seconds(2)) {
+        std::cout << "❌ FAILED: scrubber did not stop promptly\n";
+        return false;
+    }
+
+    auto stats = manager.get_scrub_stats();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stats.files_checked != 5 || stats.corrupt_found != 1 || stats.unchecked != 1 ||
+        reported.size() != 1 || reported[0] != "20260215_160002") {
+        std::cout << "❌ FAILED: checked=" << stats.files_checked << " corrupt=" << stats.corrupt_found
+                  << " unchecked=" << stats.unchecked << " reported=" << reported.size() << "\n";
+        return false;
+    }
+    if (fs::exists(bad) || !manager.list_frames("KTLX", "reflectivity").size()) {
+        std::cout << "❌ FAILED: corrupt file should be removed, others kept\n";
+        return false;
+    }
+    levelii::SQLiteDatabase db(root + "/index.db");
+    if (!db.query("SELECT 1 FROM levelii_frames WHERE timestamp = '20260215_160002';").empty()) {
+        std::cout << "❌ FAILED: corrupt frame still indexed\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "CHECKSUM TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_checksum_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    ok = test_crc32c_vectors() && ok;
+    ok = test_gzip_embedded_crc() && ok;
+    ok = test_load_rejects_corruption(root + "/load") && ok;
+    ok = test_scrubber(root + "/scrub") && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Checksum tests passed.\n" : "Checksum tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
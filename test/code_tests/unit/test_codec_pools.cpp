@@ -0,0 +1,193 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <iterator>
+#include "levelii/DecompressionUtils.h"
+#include "levelii/ZlibUtils.h"
+
+namespace {
+    std::vector<uint8_t> make_payload(size_t size, uint32_t seed) {
+        std::vector<uint8_t> data(size);
+        uint32_t state = seed;
+        for (auto& b : data) {
+            state = state * 1664525u + 1013904223u;
+            b = static_cast<uint8_t>((state >> 24) & 0x1F);
+        }
+        return data;
+    }
+}
+
+bool test_bz2_arena_reuse(const std::vector<uint8_t>& compressed) {
+    std::cout << "\n=== BZIP2 ARENA REUSE TEST ===\n";
+    std::vector<uint8_t> first, second;
+    uint64_t before = RadarDecompression::bz2_arena_allocations();
+    if (!RadarDecompression::auto_decompress(compressed, first)) {
+        std::cout << "❌ FAILED: could not decompress\n";
+        return false;
+    }
+    uint64_t warm = RadarDecompression::bz2_arena_allocations();
+    for (int i = 0; i < 3; ++i) {
+        if (!RadarDecompression::auto_decompress(compressed, second) || second != first) {
+            std::cout << "❌ FAILED: repeated decode differs\n";
+            return false;
+        }
+    }
+    uint64_t after = RadarDecompression::bz2_arena_allocations();
+    std::cout << "   allocations: first file " << warm - before << ", next three " << after - warm << "\n";
+    // Decoder state plus block tables, not two per LDM record
+    if (warm - before > 4 || after != warm) {
+        std::cout << "❌ FAILED: decoder memory is not being reused\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_zlib_stream_reuse() {
+    std::cout << "\n=== ZLIB STREAM REUSE TEST ===\n";
+    auto a = make_payload(300000, 1);
+    auto b = make_payload(1000, 2);
+    // Warm one deflater per level used below and one inflater
+    ZlibUtils::gzip_compress(a.data(), a.size());
+    auto warm_a = ZlibUtils::gzip_compress(a.data(), a.size(), 1);
+    ZlibUtils::gzip_decompress(warm_a.data(), warm_a.size());
+    uint64_t warm = ZlibUtils::stream_inits();
+
+    for (int i = 0; i < 50; ++i) {
+        const auto& data = (i % 2) ? a : b;
+        auto with_crc = ZlibUtils::gzip_compress_with_crc(data.data(), data.size());
+        auto plain = ZlibUtils::gzip_compress(data.data(), data.size(), (i % 3) ? 9 : 1);
+        if (ZlibUtils::gzip_decompress(with_crc.data(), with_crc.size()) != data ||
+            ZlibUtils::gzip_decompress(plain.data(), plain.size()) != data) {
+            std::cout << "❌ FAILED: round trip " << i << "\n";
+            return false;
+        }
+        // A reset stream must not carry the previous call's gzip header
+        if (ZlibUtils::verify_gzip_crc(with_crc.data(), with_crc.size()) != ZlibUtils::GzipCrcStatus::Valid ||
+            ZlibUtils::verify_gzip_crc(plain.data(), plain.size()) != ZlibUtils::GzipCrcStatus::Missing) {
+            std::cout << "❌ FAILED: header leaked between calls " << i << "\n";
+            return false;
+        }
+    }
+    auto truncated = ZlibUtils::gzip_compress(a.data(), a.size());
+    truncated.resize(truncated.size() / 2);
+    if (!ZlibUtils::gzip_decompress(truncated.data(), truncated.size()).empty() ||
+        ZlibUtils::gzip_decompress(ZlibUtils::gzip_compress(b.data(), b.size()).data(), 20).size() != 0) {
+        std::cout << "❌ FAILED: truncated stream accepted\n";
+        return false;
+    }
+    auto again = ZlibUtils::gzip_compress(b.data(), b.size());
+    if (ZlibUtils::gzip_decompress(again.data(), again.size()) != b) {
+        std::cout << "❌ FAILED: stream unusable after an error\n";
+        return false;
+    }
+    if (ZlibUtils::stream_inits() != warm) {
+        std::cout << "❌ FAILED: " << ZlibUtils::stream_inits() - warm << " streams initialized after warm-up\n";
+        return false;
+    }
+
+    // Concurrent callers each get their own stream
+    std::vector<std::thread> threads;
+    std::vector<int> ok(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            auto data = make_payload(100000, 10 + t);
+            bool good = true;
+            for (int i = 0; i < 20 && good; ++i) {
+                auto c = ZlibUtils::gzip_compress(data.data(), data.size());
+                good = ZlibUtils::gzip_decompress(c.data(), c.size()) == data;
+            }
+            ok[t] = good;
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    for (int good : ok) {
+        if (!good) {
+            std::cout << "❌ FAILED: concurrent round trip\n";
+            return false;
+        }
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_whole_buffer_gzip() {
+    std::cout << "\n=== WHOLE-BUFFER GZIP TEST ===\n";
+    auto a = make_payload(500000, 3);
+    auto b = make_payload(70000, 4);
+    auto gz_a = ZlibUtils::gzip_compress(a.data(), a.size());
+    auto gz_b = ZlibUtils::gzip_compress(b.data(), b.size(), 1);
+
+    // Presized from the ISIZE trailer: one exact allocation, no regrowth
+    std::vector<uint8_t> out;
+    if (!ZlibUtils::gzip_decompress(gz_a.data(), gz_a.size(), out) || out != a || out.capacity() != a.size()) {
+        std::cout << "❌ FAILED: inflate into caller buffer (capacity " << out.capacity() << ")\n";
+        return false;
+    }
+    const uint8_t* buffer = out.data();
+    if (!ZlibUtils::gzip_decompress(gz_b.data(), gz_b.size(), out) || out != b || out.data() != buffer) {
+        std::cout << "❌ FAILED: caller buffer not reused\n";
+        return false;
+    }
+
+    // Concatenated members, as written by `cat a.gz b.gz`
+    std::vector<uint8_t> joined = gz_a;
+    joined.insert(joined.end(), gz_b.begin(), gz_b.end());
+    std::vector<uint8_t> expected = a;
+    expected.insert(expected.end(), b.begin(), b.end());
+    if (ZlibUtils::gzip_decompress(joined.data(), joined.size()) != expected) {
+        std::cout << "❌ FAILED: multi-member stream\n";
+        return false;
+    }
+
+    // A wrong ISIZE is only a hint: too small grows, absurdly large is ignored
+    for (uint32_t isize : {10u, 0xFFFFFFF0u}) {
+        std::vector<uint8_t> lying = gz_a;
+        for (int i = 0; i < 4; ++i) lying[lying.size() - 4 + i] = static_cast<uint8_t>(isize >> (8 * i));
+        std::vector<uint8_t> result;
+        bool ok = ZlibUtils::gzip_decompress(lying.data(), lying.size(), result);
+        // The trailer length check may reject the member, but it must never return wrong data
+        if (ok && result != a) {
+            std::cout << "❌ FAILED: ISIZE " << isize << " produced wrong data\n";
+            return false;
+        }
+    }
+
+    // Damage and truncation leave the output empty
+    std::vector<uint8_t> damaged = gz_a;
+    damaged[damaged.size() / 2] ^= 0xFF;
+    damaged[damaged.size() / 2 + 1] ^= 0xFF;
+    std::vector<uint8_t> result = a;
+    if (ZlibUtils::gzip_decompress(damaged.data(), damaged.size(), result) || !result.empty() ||
+        ZlibUtils::gzip_decompress(gz_a.data(), gz_a.size() - 1, result)) {
+        std::cout << "❌ FAILED: damaged stream accepted\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <radar_file>" << std::endl;
+        return 1;
+    }
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "CODEC POOL TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    std::ifstream file(argv[1], std::ios::binary);
+    std::vector<uint8_t> compressed((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    bool ok = true;
+    ok = test_bz2_arena_reuse(compressed) && ok;
+    ok = test_zlib_stream_reuse() && ok;
+    ok = test_whole_buffer_gzip() && ok;
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Codec pool tests passed.\n" : "Codec pool tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+    return ok ? 0 : 1;
+}
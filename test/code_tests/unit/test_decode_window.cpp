@@ -0,0 +1,162 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+#include "levelii/RadarParser.h"
+#include "levelii/DecompressionUtils.h"
+
+namespace {
+    // Reflectivity and velocity are 8-bit moments, differential phase is 16-bit
+    const std::vector<std::string> PRODUCTS = {"reflectivity", "velocity", "differential_phase"};
+
+    using Frames = std::unordered_map<std::string, std::unique_ptr<RadarFrame>>;
+
+    Frames parse(const std::vector<uint8_t>& raw, const ParseOptions& options, double* ms = nullptr) {
+        auto start = std::chrono::steady_clock::now();
+        auto frames = parse_nexrad_level2_multi(raw, "KABR", "20250621_041210", PRODUCTS, nullptr, false, options);
+        if (ms) *ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return frames;
+    }
+
+    size_t total_bins(const RadarFrame& frame) {
+        size_t bins = 0;
+        for (const auto& sweep : frame.sweeps) bins += sweep.bins.size() / 3;
+        return bins;
+    }
+
+    uint64_t cell_key(float azimuth, long gate) {
+        uint32_t bits;
+        std::memcpy(&bits, &azimuth, sizeof(bits));
+        return (static_cast<uint64_t>(bits) << 32) | static_cast<uint32_t>(gate);
+    }
+
+    long gate_index(const RadarFrame& full, float range) {
+        return std::lround((range - full.first_gate_meters) / full.gate_spacing_meters);
+    }
+
+    // Windowed output must be exactly the full-range bins inside the window, in order
+    bool check_window(const RadarFrame& full, const RadarFrame& windowed, float min_range, float max_range, std::string& why) {
+        if (windowed.first_gate_meters < min_range ||
+            windowed.first_gate_meters + (windowed.ngates - 1) * windowed.gate_spacing_meters > max_range) {
+            why = "frame geometry extends past the window";
+            return false;
+        }
+        for (size_t i = 0; i < full.sweeps.size(); ++i) {
+            std::vector<float> expected;
+            const auto& bins = full.sweeps[i].bins;
+            for (size_t b = 0; b < bins.size(); b += 3) {
+                if (bins[b + 1] < min_range || bins[b + 1] > max_range) continue;
+                expected.insert(expected.end(), bins.begin() + b, bins.begin() + b + 3);
+            }
+            if (windowed.sweeps[i].bins != expected) {
+                why = "sweep " + std::to_string(i) + " is not the windowed full-range sweep";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every strided bin must be the reduction of the full-resolution gates it covers
+    bool check_stride(const RadarFrame& full, const RadarFrame& strided, int stride, GateReduction reduction, std::string& why) {
+        if (strided.gate_spacing_meters != full.gate_spacing_meters * stride ||
+            strided.ngates != (full.ngates + stride - 1) / stride) {
+            why = "strided geometry is wrong";
+            return false;
+        }
+        for (size_t i = 0; i < full.sweeps.size(); ++i) {
+            std::unordered_map<uint64_t, float> cells;
+            const auto& bins = full.sweeps[i].bins;
+            for (size_t b = 0; b < bins.size(); b += 3) cells[cell_key(bins[b], gate_index(full, bins[b + 1]))] = bins[b + 2];
+
+            const auto& out = strided.sweeps[i].bins;
+            for (size_t b = 0; b < out.size(); b += 3) {
+                long gate = gate_index(full, out[b + 1]);
+                float max = -1e30f, sum = 0.0f;
+                int count = 0;
+                for (long g = gate; g < gate + (reduction == GateReduction::Sample ? 1 : stride); ++g) {
+                    auto it = cells.find(cell_key(out[b], g));
+                    if (it == cells.end()) continue;
+                    max = std::max(max, it->second);
+                    sum += it->second;
+                    ++count;
+                }
+                float expected = reduction == GateReduction::Mean ? std::round(sum / count * 10.0f) * 0.1f : max;
+                if (gate % stride != 0 || count == 0 || std::fabs(out[b + 2] - expected) > 1e-4f) {
+                    why = "sweep " + std::to_string(i) + " bin at " + std::to_string(out[b + 1]) + " m is " +
+                          std::to_string(out[b + 2]) + ", expected " + std::to_string(expected);
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <radar_file>" << std::endl;
+        return 1;
+    }
+    std::ifstream file(argv[1], std::ios::binary);
+    std::vector<uint8_t> compressed((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<uint8_t> raw;
+    if (compressed.empty() || !RadarDecompression::auto_decompress(compressed, raw)) {
+        std::cerr << "Could not read " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== RANGE WINDOW TEST ===" << std::endl;
+    double full_ms, windowed_ms;
+    Frames full = parse(raw, {}, &full_ms);
+    ParseOptions window;
+    window.max_range_meters = 230000.0f;
+    Frames windowed = parse(raw, window, &windowed_ms);
+    ParseOptions ring;
+    ring.min_range_meters = 20000.0f;
+    ring.max_range_meters = 100000.0f;
+    Frames ringed = parse(raw, ring);
+
+    for (const auto& product : PRODUCTS) {
+        std::string why;
+        if (!full[product] || !windowed[product] || !ringed[product]) {
+            std::cout << "❌ FAILED: " << product << " missing" << std::endl;
+            return 1;
+        }
+        if (!check_window(*full[product], *windowed[product], 0.0f, 230000.0f, why) ||
+            !check_window(*full[product], *ringed[product], 20000.0f, 100000.0f, why)) {
+            std::cout << "❌ FAILED: " << product << ": " << why << std::endl;
+            return 1;
+        }
+    }
+    const RadarFrame& ref = *full["reflectivity"];
+    const RadarFrame& ref_230 = *windowed["reflectivity"];
+    std::cout << "gates " << ref.ngates << " -> " << ref_230.ngates << ", bins " << total_bins(ref) << " -> "
+              << total_bins(ref_230) << ", parse " << full_ms << " ms -> " << windowed_ms << " ms" << std::endl;
+    if (ref_230.ngates >= ref.ngates * 6 / 10) {
+        std::cout << "❌ FAILED: 230 km window should roughly halve the gates of a long-range scan" << std::endl;
+        return 1;
+    }
+    std::cout << "✅ PASSED" << std::endl;
+
+    std::cout << "\n=== GATE STRIDE TEST ===" << std::endl;
+    for (GateReduction reduction : {GateReduction::Sample, GateReduction::Max, GateReduction::Mean}) {
+        ParseOptions options;
+        options.gate_stride = 2;
+        options.reduction = reduction;
+        Frames strided = parse(raw, options);
+        for (const auto& product : PRODUCTS) {
+            std::string why;
+            if (!strided[product] || !check_stride(*full[product], *strided[product], 2, reduction, why)) {
+                std::cout << "❌ FAILED: " << product << " reduction " << static_cast<int>(reduction) << ": " << why << std::endl;
+                return 1;
+            }
+        }
+    }
+    std::cout << "✅ PASSED" << std::endl;
+    return 0;
+}
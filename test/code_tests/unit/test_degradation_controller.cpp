@@ -0,0 +1,195 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <deque>
+#include <chrono>
+#include <algorithm>
+#include "levelii/DegradationController.h"
+
+using Level = DegradationController::Level;
+using Clock = DegradationController::Clock;
+using namespace std::chrono_literals;
+
+namespace {
+    DegradationController::Config test_config() {
+        DegradationController::Config config;
+        config.degrade_wait_seconds = 120;
+        config.restore_wait_seconds = 30;
+        config.degrade_backlog = 200;
+        config.restore_backlog = 20;
+        config.step_seconds = 30;
+        config.hold_seconds = 60;
+        return config;
+    }
+}
+
+bool test_steps_down_under_load() {
+    std::cout << "\n=== DEGRADE UNDER LOAD TEST ===\n";
+    DegradationController controller(test_config());
+    auto start = Clock::now();
+
+    // Too soon after start for a first step
+    if (controller.update(300, 10, start + 10s) != Level::Full) {
+        std::cout << "❌ FAILED: stepped down before step_seconds\n";
+        return false;
+    }
+    // One level per step_seconds, by queue wait or by backlog alone, up to the last level
+    std::vector<Level> seen;
+    for (int t = 30; t <= 300; t += 10) {
+        double wait = t < 100 ? 300 : 5;
+        size_t backlog = t < 100 ? 10 : 500;
+        Level level = controller.update(wait, backlog, start + std::chrono::seconds(t));
+        if (seen.empty() || seen.back() != level) seen.push_back(level);
+    }
+    std::vector<Level> expected = {Level::NoVolumetric, Level::BaseTilts, Level::PriorityProducts, Level::LatestOnly};
+    auto stats = controller.stats(start + 300s);
+    if (seen != expected || stats.degrades != 4 || stats.level != Level::LatestOnly) {
+        std::cout << "❌ FAILED: " << seen.size() << " levels visited, " << stats.degrades << " steps down\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_hysteresis() {
+    std::cout << "\n=== RESTORE HYSTERESIS TEST ===\n";
+    DegradationController controller(test_config());
+    auto start = Clock::now();
+    controller.update(300, 500, start + 30s);
+    controller.update(300, 500, start + 60s);
+    if (controller.level() != Level::BaseTilts) {
+        std::cout << "❌ FAILED: setup did not reach base_tilts\n";
+        return false;
+    }
+
+    // Between the restore and degrade marks: hold, however long it lasts
+    for (int t = 70; t <= 400; t += 10) controller.update(60, 100, start + std::chrono::seconds(t));
+    if (controller.level() != Level::BaseTilts) {
+        std::cout << "❌ FAILED: level moved between the marks\n";
+        return false;
+    }
+
+    // Caught up, but a blip over the restore mark restarts the hold
+    controller.update(5, 5, start + 410s);
+    controller.update(5, 5, start + 450s);
+    controller.update(45, 5, start + 460s);
+    controller.update(5, 5, start + 470s);
+    if (controller.update(5, 5, start + 500s) != Level::BaseTilts) {
+        std::cout << "❌ FAILED: stepped up without a full quiet period\n";
+        return false;
+    }
+
+    // One level per hold_seconds of quiet
+    if (controller.update(5, 5, start + 530s) != Level::NoVolumetric ||
+        controller.update(5, 5, start + 560s) != Level::NoVolumetric ||
+        controller.update(5, 5, start + 590s) != Level::Full) {
+        std::cout << "❌ FAILED: did not step back up one level per quiet period\n";
+        return false;
+    }
+
+    auto stats = controller.stats(start + 600s);
+    double total = 0;
+    for (double seconds : stats.seconds_at_level) total += seconds;
+    if (stats.restores != 2 || stats.degrades != 2 || stats.seconds_at_level[2] < 469 || total < 599) {
+        std::cout << "❌ FAILED: wrong transition counts or time at level\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_disable_restores_full() {
+    std::cout << "\n=== DISABLED CONTROLLER TEST ===\n";
+    auto config = test_config();
+    DegradationController controller(config);
+    auto start = Clock::now();
+    controller.update(300, 500, start + 30s);
+    config.enabled = false;
+    controller.set_config(config);
+    if (controller.update(300, 500, start + 90s) != Level::Full) {
+        std::cout << "❌ FAILED: disabled controller still sheds\n";
+        return false;
+    }
+    controller.count_volumetric_skipped(3);
+    controller.count_tilts_skipped(10);
+    controller.count_products_dropped(2);
+    controller.count_stale_skipped();
+    controller.count_backfilled(4);
+    auto stats = controller.stats();
+    if (stats.volumetric_skipped != 3 || stats.tilts_skipped != 10 || stats.products_dropped != 2 || stats.stale_skipped != 1 ||
+        stats.backfilled != 4 ||
+        std::string(DegradationController::level_name(Level::LatestOnly)) != "latest_only") {
+        std::cout << "❌ FAILED: counters not kept\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_outbreak_freshness() {
+    std::cout << "\n=== OUTBREAK FRESHNESS TEST ===\n";
+    // 40 stations, a volume every 4 minutes each, on a node that keeps up with 30.
+    // Each level cuts the CPU per volume; latest_only drops everything but the newest.
+    const double cost[] = {1.0, 0.8, 0.55, 0.4, 0.4};
+    const double capacity = 30.0 / 240.0;  // Full-cost volumes per second
+    auto run = [&](bool shedding, double& worst_wait, size_t& final_backlog) {
+        auto config = test_config();
+        config.enabled = shedding;
+        DegradationController controller(config);
+        auto start = Clock::now();
+        std::deque<int> queue;  // Arrival second of each queued volume
+        double credit = 0.0;
+        worst_wait = 0.0;
+        Level level = Level::Full;
+        for (int t = 0; t < 3 * 3600; ++t) {
+            if (t % 6 == 0) queue.push_back(t);  // 40 stations / 240 s
+            credit += capacity / cost[static_cast<int>(level)];
+            double waited = 0.0;
+            while (credit >= 1.0 && !queue.empty()) {
+                waited = std::max(waited, static_cast<double>(t - queue.front()));
+                if (level == Level::LatestOnly && queue.size() > 40) {
+                    // Older volumes of the same stations are skipped, not fetched
+                    queue.erase(queue.begin(), queue.end() - 40);
+                    continue;
+                }
+                queue.pop_front();
+                credit -= 1.0;
+            }
+            credit = std::min(credit, 1.0);
+            level = controller.update(waited, queue.size(), start + std::chrono::seconds(t));
+            if (t > 3600 && !queue.empty()) worst_wait = std::max(worst_wait, static_cast<double>(t - queue.front()));
+        }
+        final_backlog = queue.size();
+    };
+
+    double shed_wait = 0, full_wait = 0;
+    size_t shed_backlog = 0, full_backlog = 0;
+    run(true, shed_wait, shed_backlog);
+    run(false, full_wait, full_backlog);
+    std::cout << "   after 3 hours: oldest queued volume " << full_wait / 60 << " min old without shedding ("
+              << full_backlog << " queued), " << shed_wait / 60 << " min with it (" << shed_backlog << " queued)\n";
+    if (shed_wait > 15 * 60 || shed_wait * 4 > full_wait) {
+        std::cout << "❌ FAILED: shedding did not keep ingest current\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "DEGRADATION CONTROLLER TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    bool ok = true;
+    ok = test_steps_down_under_load() && ok;
+    ok = test_hysteresis() && ok;
+    ok = test_disable_restores_full() && ok;
+    ok = test_outbreak_freshness() && ok;
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Degradation controller tests passed.\n" : "Degradation controller tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
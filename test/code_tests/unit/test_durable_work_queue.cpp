@@ -0,0 +1,155 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include "levelii/DurableWorkQueue.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    DurableWorkQueue::Item make_item(const std::string& station, const std::string& timestamp) {
+        return {station, "2026/02/15/" + station + "/" + station + timestamp + "_V06", "unidata-nexrad-level2", timestamp};
+    }
+}
+
+bool test_add_ack_recover(const std::string& root) {
+    std::cout << "\n=== ADD / ACK / RECOVER TEST ===\n";
+    fs::create_directories(root);
+    const std::string db_path = root + "/index.db";
+    auto a = make_item("KTLX", "20260215_150000");
+    auto b = make_item("KTLX", "20260215_150500");
+    auto c = make_item("KCRP", "20260215_150200");
+
+    {
+        levelii::SQLiteDatabase db(db_path);
+        DurableWorkQueue queue(db);
+        if (queue.add({a, b}).size() != 2 || queue.add({b, c}).size() != 1 || queue.size() != 3) {
+            std::cout << "❌ FAILED: duplicates should be filtered\n";
+            return false;
+        }
+        queue.ack({b.key});
+        // Process "crashes" here with a and c outstanding
+    }
+
+    levelii::SQLiteDatabase db(db_path);
+    DurableWorkQueue queue(db);
+    if (!queue.add({a}).empty()) {
+        std::cout << "❌ FAILED: outstanding item re-added after restart\n";
+        return false;
+    }
+    DurableWorkQueue::Item source;
+    if (!queue.source("KTLX", b.timestamp, source) || source.key != b.key || source.bucket != b.bucket ||
+        queue.source("KTLX", a.timestamp, source)) {
+        std::cout << "❌ FAILED: only acknowledged items should keep their source key\n";
+        return false;
+    }
+    auto recovered = queue.recover();
+    if (recovered.size() != 2 || recovered[0].key != a.key || recovered[1].key != c.key ||
+        recovered[1].station != "KCRP" || recovered[1].timestamp != c.timestamp) {
+        std::cout << "❌ FAILED: expected a and c in insertion order\n";
+        return false;
+    }
+    queue.ack({a.key, c.key});
+    if (queue.size() != 0 || !queue.recover().empty()) {
+        std::cout << "❌ FAILED: acknowledged items recovered\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_poison_item_dropped(const std::string& root) {
+    std::cout << "\n=== MAX ATTEMPTS TEST ===\n";
+    fs::create_directories(root);
+    levelii::SQLiteDatabase db(root + "/index.db");
+    DurableWorkQueue queue(db, 2);
+    queue.add({make_item("KTLX", "20260215_160000")});
+
+    if (queue.recover().size() != 1 || queue.recover().size() != 1) {
+        std::cout << "❌ FAILED: item dropped too early\n";
+        return false;
+    }
+    if (!queue.recover().empty() || queue.size() != 0) {
+        std::cout << "❌ FAILED: item should be dropped after 2 attempts\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_retry_budget(const std::string& root) {
+    std::cout << "\n=== RETRY TEST ===\n";
+    fs::create_directories(root);
+    levelii::SQLiteDatabase db(root + "/index.db");
+    DurableWorkQueue queue(db, 2);
+    auto item = make_item("KTLX", "20260215_163000");
+    queue.add({item});
+
+    if (!queue.retry(item.key) || !queue.retry(item.key)) {
+        std::cout << "❌ FAILED: item should be retried twice\n";
+        return false;
+    }
+    if (queue.retry(item.key) || queue.size() != 0 || !queue.recover().empty()) {
+        std::cout << "❌ FAILED: item should be dropped after 2 retries\n";
+        return false;
+    }
+    if (queue.retry(item.key) || queue.add({item}).size() != 1) {
+        std::cout << "❌ FAILED: dropped item should be gone and addable again\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_storage_shutdown_drains(const std::string& root) {
+    std::cout << "\n=== ASYNC STORAGE DRAIN TEST ===\n";
+    FrameStorageManager manager(root);
+    const uint16_t num_rays = 360, num_gates = 100;
+    for (int i = 0; i < 10; ++i) {
+        AsyncWriteTask task;
+        task.type = AsyncWriteTask::BITMASK;
+        task.station = "KTLX";
+        task.product = "reflectivity";
+        task.timestamp = "20260215_17000" + std::to_string(i);
+        task.tilt = 0.5f;
+        task.num_rays = num_rays;
+        task.num_gates = num_gates;
+        task.gate_spacing = 250.0f;
+        task.first_gate = 2125.0f;
+        task.bitmask.assign((num_rays * num_gates + 7) / 8, 0x0F);
+        task.values.assign(num_rays * num_gates / 2, 42);
+        manager.enqueue_async_write(std::move(task));
+    }
+    manager.shutdown_async_storage();
+
+    if (manager.list_frames("KTLX", "reflectivity").size() != 10) {
+        std::cout << "❌ FAILED: queued writes were discarded on shutdown\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "DURABLE WORK QUEUE TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_work_queue_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    ok = test_add_ack_recover(root + "/recover") && ok;
+    ok = test_poison_item_dropped(root + "/poison") && ok;
+    ok = test_retry_budget(root + "/retry") && ok;
+    ok = test_storage_shutdown_drains(root + "/drain") && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Durable work queue tests passed.\n" : "Durable work queue tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <queue>
+#include <cstdio>
+#include <algorithm>
+#include <chrono>
+#include "levelii/FairBatchQueue.h"
+
+namespace {
+    // Volume timestamps a few minutes apart, in discovery (chronological) order
+    std::vector<DiscoveryItem> volumes(const std::string& station, int count, int first_minute = 0) {
+        std::vector<DiscoveryItem> items;
+        for (int i = 0; i < count; ++i) {
+            char ts[16];
+            std::snprintf(ts, sizeof(ts), "20260215_%02d%02d00", (first_minute + i * 5) / 60, (first_minute + i * 5) % 60);
+            items.push_back({station, station + ts, "unidata-nexrad-level2", ts});
+        }
+        return items;
+    }
+
+    std::vector<DiscoveryBatch> drain(FairBatchQueue& queue) {
+        std::vector<DiscoveryBatch> batches;
+        DiscoveryBatch batch;
+        while (queue.pop(batch)) batches.push_back(batch);
+        return batches;
+    }
+}
+
+bool test_newest_first() {
+    std::cout << "\n=== NEWEST FRAME FAST TRACK TEST ===\n";
+    FairBatchQueue queue;
+    // One station catching up on 30 volumes, three with a single new volume
+    queue.push(volumes("KTLX", 30));
+    queue.push(volumes("KFWS", 1, 140));
+    queue.push(volumes("KINX", 1, 140));
+    queue.push(volumes("KVNX", 1, 140));
+    if (queue.size() != 33 || queue.stations() != 4 || queue.batches() != 9) {
+        std::cout << "❌ FAILED: " << queue.size() << " items, " << queue.stations() << " stations, " << queue.batches() << " batches\n";
+        return false;
+    }
+
+    auto batches = drain(queue);
+    // The first four batches are each station's newest volume
+    std::vector<std::string> first;
+    for (size_t i = 0; i < 4 && i < batches.size(); ++i) {
+        if (batches[i].items.size() != 1) break;
+        first.push_back(batches[i].station);
+    }
+    if (first != std::vector<std::string>{"KTLX", "KFWS", "KINX", "KVNX"} || batches[0].items[0].timestamp != "20260215_022500") {
+        std::cout << "❌ FAILED: newest volumes not handed out first\n";
+        return false;
+    }
+
+    // The backlog follows oldest first, every item exactly once, at most 5 per batch
+    std::vector<std::string> backlog;
+    size_t total = 0;
+    for (const auto& batch : batches) {
+        total += batch.items.size();
+        if (batch.items.size() > 5) {
+            std::cout << "❌ FAILED: batch of " << batch.items.size() << "\n";
+            return false;
+        }
+        for (const auto& item : batch.items) {
+            if (item.station != batch.station) {
+                std::cout << "❌ FAILED: batch mixes stations\n";
+                return false;
+            }
+            if (&batch - batches.data() >= 4) backlog.push_back(item.timestamp);
+        }
+    }
+    if (total != 33 || !std::is_sorted(backlog.begin(), backlog.end()) || !queue.empty()) {
+        std::cout << "❌ FAILED: " << total << " items handed out\n";
+        return false;
+    }
+
+    // A newer volume of the backlogged station is fast-tracked again; an older one is not
+    queue.push(volumes("KTLX", 4));
+    queue.push(volumes("KTLX", 1, 150));
+    DiscoveryBatch batch;
+    if (!queue.pop(batch) || batch.items.size() != 1 || batch.items[0].timestamp != "20260215_023000" ||
+        !queue.pop(batch) || batch.items.size() != 4) {
+        std::cout << "❌ FAILED: second scan not fast-tracked\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_weighted_share() {
+    std::cout << "\n=== WEIGHTED SHARE TEST ===\n";
+    FairBatchQueue queue;
+    queue.set_weights({{"KTLX", 2.0}, {"KINX", 0.5}});
+    for (const char* station : {"KTLX", "KFWS", "KINX"}) queue.push(volumes(station, 300));
+
+    // Count items per station over the first 350 handed out, while all are backlogged
+    std::map<std::string, size_t> served;
+    size_t total = 0;
+    DiscoveryBatch batch;
+    while (total < 350 && queue.pop(batch)) {
+        served[batch.station] += batch.items.size();
+        total += batch.items.size();
+    }
+    std::cout << "   KTLX (2.0): " << served["KTLX"] << ", KFWS (1.0): " << served["KFWS"] << ", KINX (0.5): " << served["KINX"] << "\n";
+    double unit = total / 3.5;
+    for (auto [station, weight] : std::vector<std::pair<std::string, double>>{{"KTLX", 2.0}, {"KFWS", 1.0}, {"KINX", 0.5}}) {
+        if (served[station] < weight * unit - 10 || served[station] > weight * unit + 10) {
+            std::cout << "❌ FAILED: " << station << " got " << served[station] << " of " << total << "\n";
+            return false;
+        }
+    }
+    drain(queue);
+    if (!queue.empty() || queue.batches() != 0) {
+        std::cout << "❌ FAILED: items left after draining\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_worst_case_freshness() {
+    std::cout << "\n=== WORST CASE FRESHNESS TEST ===\n";
+    // Two stations catching up on five hours of volumes, 24 others with one new
+    // volume each. Measure how many batches each station's newest volume waits.
+    std::vector<std::vector<DiscoveryItem>> scans;
+    scans.push_back(volumes("KTLX", 60));
+    scans.push_back(volumes("KFWS", 60));
+    for (int s = 0; s < 24; ++s) {
+        char name[8];
+        std::snprintf(name, sizeof(name), "K%03d", s);
+        scans.push_back(volumes(name, 1, 300));
+    }
+
+    // The FIFO it replaces: batches of up to five, in push order
+    std::queue<DiscoveryBatch> fifo;
+    for (const auto& scan : scans) {
+        for (size_t i = 0; i < scan.size(); i += 5) {
+            fifo.push({scan[i].station, std::vector<DiscoveryItem>(scan.begin() + i, scan.begin() + std::min(scan.size(), i + 5))});
+        }
+    }
+    size_t fifo_worst = 0, fifo_batches = 0;
+    for (; !fifo.empty(); fifo.pop(), ++fifo_batches) {
+        if (fifo.front().items.back().timestamp >= "20260215_050000") fifo_worst = fifo_batches;
+    }
+
+    FairBatchQueue queue;
+    for (const auto& scan : scans) queue.push(scan);
+    auto batches = drain(queue);
+    size_t fair_worst = 0;
+    std::map<std::string, bool> newest_seen;
+    for (size_t i = 0; i < batches.size(); ++i) {
+        const auto& last = batches[i].items.back();
+        if (!newest_seen[last.station] && (last.timestamp == "20260215_045500" || last.timestamp == "20260215_050000")) {
+            newest_seen[last.station] = true;
+            fair_worst = i;
+        }
+    }
+    std::cout << "   newest volume waits up to " << fifo_worst << " batches with a FIFO, " << fair_worst << " with the fair queue\n";
+    std::cout << "   " << fifo_batches << " FIFO batches, " << batches.size() << " fair batches for the same 144 volumes\n";
+    if (newest_seen.size() != scans.size() || fair_worst >= scans.size() || fair_worst >= fifo_worst) {
+        std::cout << "❌ FAILED: newest volumes not served first\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_newest_known() {
+    std::cout << "\n=== NEWEST KNOWN VOLUME TEST ===\n";
+    FairBatchQueue queue;
+    auto before = std::chrono::steady_clock::now();
+    queue.push(volumes("KTLX", 10));
+    if (queue.newest("KTLX") != "20260215_004500" || !queue.newest("KFWS").empty()) {
+        std::cout << "❌ FAILED: wrong newest timestamp while queued\n";
+        return false;
+    }
+
+    // Stays the same once the newest is handed out, so older ones can be told apart from it
+    auto batches = drain(queue);
+    for (const auto& batch : batches) {
+        for (const auto& item : batch.items) {
+            if (item.queued_at < before) {
+                std::cout << "❌ FAILED: item not stamped when queued\n";
+                return false;
+            }
+        }
+    }
+    if (queue.newest("KTLX") != "20260215_004500") {
+        std::cout << "❌ FAILED: newest forgotten after it was handed out\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "FAIR BATCH QUEUE TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    bool ok = true;
+    ok = test_newest_first() && ok;
+    ok = test_weighted_share() && ok;
+    ok = test_worst_case_freshness() && ok;
+    ok = test_newest_known() && ok;
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Fair batch queue tests passed.\n" : "Fair batch queue tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
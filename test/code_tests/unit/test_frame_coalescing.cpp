@@ -0,0 +1,176 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const uint16_t NUM_RAYS = 720;
+    const uint16_t NUM_GATES = 1832;
+
+    std::vector<uint8_t> make_values(size_t size, uint32_t seed) {
+        std::vector<uint8_t> data(size);
+        uint32_t state = seed;
+        for (auto& b : data) {
+            state = state * 1664525u + 1013904223u;
+            b = static_cast<uint8_t>(state >> 24);
+        }
+        return data;
+    }
+
+    std::vector<uint8_t> save_tilt(FrameStorageManager& manager, const std::string& timestamp, uint32_t seed) {
+        std::vector<uint8_t> bitmask((NUM_RAYS * NUM_GATES + 7) / 8, 0xFF);
+        std::vector<uint8_t> values = make_values(NUM_RAYS * NUM_GATES, seed);
+        manager.save_frame_bitmask("KTLX", "reflectivity", timestamp, 0.5f, NUM_RAYS, NUM_GATES, 250.0f, 2125.0f,
+                                   bitmask, values);
+        return values;
+    }
+
+    bool payload_matches(const FrameStorageManager::ByteView& payload, const std::vector<uint8_t>& values) {
+        const size_t mask_bytes = (NUM_RAYS * NUM_GATES + 7) / 8;
+        return payload.size() == mask_bytes + values.size() &&
+               std::equal(values.begin(), values.end(), payload.begin() + mask_bytes);
+    }
+}
+
+bool test_concurrent_loads_coalesce(const std::string& root) {
+    std::cout << "\n=== SINGLE-FLIGHT LOAD TEST ===\n";
+    FrameStorageManager manager(root);
+    auto values = save_tilt(manager, "20260215_150000", 7);
+
+    // Rounds of clients released together, as when a new frame is announced
+    const int rounds = 8, clients = 16;
+    std::atomic<int> mismatches{0};
+    for (int round = 0; round < rounds; ++round) {
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (int c = 0; c < clients; ++c) {
+            threads.emplace_back([&, c] {
+                while (!go.load()) std::this_thread::yield();
+                bool ok;
+                if (c % 2 == 0) {
+                    auto frame = manager.load_frame_shared("KTLX", "reflectivity", "20260215_150000", 0.5f);
+                    ok = frame && payload_matches(frame->binary_data, values);
+                } else {
+                    FrameStorageManager::CompressedFrameData frame;
+                    ok = manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_150000", 0.5f, frame) &&
+                         payload_matches(frame.binary_data, values) && frame.metadata.value("r", 0) == NUM_RAYS;
+                }
+                if (!ok) mismatches.fetch_add(1);
+            });
+        }
+        go = true;
+        for (auto& thread : threads) thread.join();
+    }
+
+    auto stats = manager.get_read_stats();
+    std::cout << "   " << rounds * clients << " requests: " << stats.loads << " loads, " << stats.coalesced << " coalesced\n";
+    if (mismatches.load() != 0) {
+        std::cout << "❌ FAILED: " << mismatches.load() << " clients got the wrong frame\n";
+        return false;
+    }
+    if (stats.loads + stats.coalesced != static_cast<size_t>(rounds * clients) || stats.coalesced == 0) {
+        std::cout << "❌ FAILED: concurrent requests were not coalesced\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_timestamps_not_shared(const std::string& root) {
+    std::cout << "\n=== SINGLE-FLIGHT PER VOLUME TEST ===\n";
+    FrameStorageManager manager(root);
+    // Same tilt, so the same file name, in two volumes
+    const std::vector<std::string> timestamps = {"20260215_150000", "20260215_150400"};
+    std::vector<std::vector<uint8_t>> values = {save_tilt(manager, timestamps[0], 7), save_tilt(manager, timestamps[1], 8)};
+
+    std::atomic<int> mismatches{0};
+    for (int round = 0; round < 8; ++round) {
+        std::atomic<bool> go{false};
+        std::vector<std::thread> threads;
+        for (int c = 0; c < 16; ++c) {
+            threads.emplace_back([&, c] {
+                while (!go.load()) std::this_thread::yield();
+                auto frame = manager.load_frame_shared("KTLX", "reflectivity", timestamps[c % 2], 0.5f);
+                if (!frame || !payload_matches(frame->binary_data, values[c % 2])) mismatches.fetch_add(1);
+            });
+        }
+        go = true;
+        for (auto& thread : threads) thread.join();
+    }
+
+    if (mismatches.load() != 0) {
+        std::cout << "❌ FAILED: " << mismatches.load() << " clients got another volume's frame\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_no_caching_after_load(const std::string& root) {
+    std::cout << "\n=== SINGLE-FLIGHT NO CACHING TEST ===\n";
+    FrameStorageManager manager(root);
+    save_tilt(manager, "20260215_150000", 7);
+    auto first = manager.load_frame_shared("KTLX", "reflectivity", "20260215_150000", 0.5f);
+
+    // A load that starts after the last one finished reads the file again
+    auto rewritten = save_tilt(manager, "20260215_150000", 8);
+    FrameStorageManager::CompressedFrameData second;
+    if (!first || !manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_150000", 0.5f, second) ||
+        !payload_matches(second.binary_data, rewritten) || manager.get_read_stats().loads != 2) {
+        std::cout << "❌ FAILED: a completed load was served again\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_missing_frame(const std::string& root) {
+    std::cout << "\n=== SINGLE-FLIGHT MISSING FRAME TEST ===\n";
+    FrameStorageManager manager(root);
+    std::atomic<int> found{0};
+    std::vector<std::thread> threads;
+    for (int c = 0; c < 8; ++c) {
+        threads.emplace_back([&] {
+            if (manager.load_frame_shared("KTLX", "reflectivity", "20260215_160000", 0.5f)) found.fetch_add(1);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    FrameStorageManager::CompressedFrameData frame;
+    if (found.load() != 0 || manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_160000", 0.5f, frame)) {
+        std::cout << "❌ FAILED: a missing frame was reported as loaded\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "FRAME LOAD COALESCING TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_frame_coalescing_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    ok = test_concurrent_loads_coalesce(root + "/herd") && ok;
+    ok = test_timestamps_not_shared(root + "/volumes") && ok;
+    ok = test_no_caching_after_load(root + "/fresh") && ok;
+    ok = test_missing_frame(root + "/missing") && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Frame load coalescing tests passed.\n" : "Frame load coalescing tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,217 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <iterator>
+#include <chrono>
+#include "levelii/ZlibUtils.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const uint16_t NUM_RAYS = 720, NUM_GATES = 1000;
+    const float GATE_SPACING = 250.0f, FIRST_GATE = 2125.0f;
+
+    // Storm-like grid: most cells empty, values 1..255 where present
+    std::vector<uint8_t> make_grid() {
+        std::vector<uint8_t> grid(static_cast<size_t>(NUM_RAYS) * NUM_GATES, 0);
+        uint32_t state = 5;
+        for (size_t i = 0; i < grid.size(); ++i) {
+            state = state * 1664525u + 1013904223u;
+            if ((state >> 28) < 5) grid[i] = static_cast<uint8_t>(1 + ((state >> 8) % 255));
+        }
+        return grid;
+    }
+
+    void pack(const std::vector<uint8_t>& grid, std::vector<uint8_t>& bitmask, std::vector<uint8_t>& values) {
+        bitmask.assign((grid.size() + 7) / 8, 0);
+        values.clear();
+        for (size_t b = 0; b < grid.size(); ++b) {
+            if (grid[b] > 0) {
+                bitmask[b / 8] |= (1 << (7 - (b % 8)));
+                values.push_back(grid[b]);
+            }
+        }
+    }
+
+    bool matches(const FrameStorageManager::FrameSector& sector, const std::vector<uint8_t>& grid, size_t first_ray,
+                 size_t rays, size_t first_gate, size_t gates) {
+        if (sector.first_ray != first_ray || sector.num_rays != rays || sector.first_gate != first_gate ||
+            sector.num_gates != gates || sector.values.size() != rays * gates) {
+            return false;
+        }
+        for (size_t row = 0; row < rays; ++row) {
+            size_t ray = (first_ray + row) % NUM_RAYS;
+            for (size_t g = 0; g < gates; ++g) {
+                if (sector.values[row * gates + g] != grid[ray * NUM_GATES + first_gate + g]) return false;
+            }
+        }
+        return true;
+    }
+
+    struct Query {
+        const char* name;
+        float azimuth_start, azimuth_end, min_range, max_range;
+        size_t first_ray, rays, first_gate, gates;
+    };
+
+    const std::vector<Query> QUERIES = {
+        {"sector", 30.0f, 40.0f, 0.0f, 0.0f, 60, 21, 0, NUM_GATES},
+        {"wrapping sector", 355.0f, 5.0f, 20000.0f, 60000.0f, 710, 21, 71, 161},
+        {"point", 123.4f, 123.4f, 50000.0f, 50000.0f, 246, 1, 191, 1},
+        {"full circle", 0.0f, 360.0f, 0.0f, 10000.0f, 0, NUM_RAYS, 0, 32},
+    };
+
+    bool run_queries(const FrameStorageManager& manager, const std::string& timestamp, const std::vector<uint8_t>& grid,
+                     size_t file_size, bool expect_partial) {
+        for (const auto& q : QUERIES) {
+            FrameStorageManager::FrameSector sector;
+            if (!manager.load_frame_sector("KTLX", "reflectivity", timestamp, 0.5f, q.azimuth_start, q.azimuth_end,
+                                           q.min_range, q.max_range, sector) ||
+                !matches(sector, grid, q.first_ray, q.rays, q.first_gate, q.gates)) {
+                std::cout << "❌ FAILED: " << q.name << " query\n";
+                return false;
+            }
+            std::cout << "   " << q.name << ": read " << sector.bytes_read << " of " << file_size << " bytes\n";
+            if (expect_partial && q.rays <= 32 && sector.bytes_read * 5 > file_size) {
+                std::cout << "❌ FAILED: " << q.name << " read too much of the file\n";
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool test_blocked_file(const std::string& root, const std::vector<uint8_t>& grid) {
+    std::cout << "\n=== RAY BLOCK SECTOR TEST ===\n";
+    FrameStorageManager manager(root);
+    std::vector<uint8_t> bitmask, values;
+    pack(grid, bitmask, values);
+    manager.save_frame_bitmask("KTLX", "reflectivity", "20260215_150000", 0.5f, NUM_RAYS, NUM_GATES, GATE_SPACING, FIRST_GATE,
+                               bitmask, values);
+    std::string path = manager.get_frame_path("KTLX", "reflectivity", "20260215_150000", 0.5f);
+
+    // Whole-file readers still see [bitmask][values]
+    FrameStorageManager::CompressedFrameData whole;
+    if (!manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_150000", 0.5f, whole) || !whole.metadata.contains("ix") ||
+        whole.binary_data.size() != bitmask.size() + values.size() ||
+        !std::equal(bitmask.begin(), bitmask.end(), whole.binary_data.begin()) ||
+        !std::equal(values.begin(), values.end(), whole.binary_data.begin() + bitmask.size())) {
+        std::cout << "❌ FAILED: blocked file does not inflate to the usual layout\n";
+        return false;
+    }
+    if (!run_queries(manager, "20260215_150000", grid, fs::file_size(path), true)) return false;
+
+    // A damaged block fails the sector read that needs it
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-40, std::ios::end);
+        file.put('\x5A');
+    }
+    FrameStorageManager::FrameSector sector;
+    if (manager.load_frame_sector("KTLX", "reflectivity", "20260215_150000", 0.5f, 355.0f, 359.0f, 0.0f, 0.0f, sector)) {
+        std::cout << "❌ FAILED: damaged block decoded\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_unindexed_file(const std::string& root, const std::vector<uint8_t>& grid) {
+    std::cout << "\n=== UNINDEXED FILE SECTOR TEST ===\n";
+    FrameStorageManager manager(root);
+    std::vector<uint8_t> bitmask, values;
+    pack(grid, bitmask, values);
+    manager.save_frame_bitmask("KTLX", "reflectivity", "20260215_160000", 0.5f, NUM_RAYS, NUM_GATES, GATE_SPACING, FIRST_GATE,
+                               bitmask, values);
+
+    // Rewrite it the way files were stored before the ray index: one member, no "ix"
+    std::string path = manager.get_frame_path("KTLX", "reflectivity", "20260215_160000", 0.5f);
+    FrameStorageManager::CompressedFrameData whole;
+    manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_160000", 0.5f, whole);
+    whole.metadata.erase("ix");
+    std::string metadata = whole.metadata.dump();
+    uint32_t metadata_size = metadata.size();
+    std::vector<uint8_t> raw(reinterpret_cast<uint8_t*>(&metadata_size), reinterpret_cast<uint8_t*>(&metadata_size) + 4);
+    raw.insert(raw.end(), metadata.begin(), metadata.end());
+    raw.insert(raw.end(), whole.binary_data.begin(), whole.binary_data.end());
+    auto legacy = ZlibUtils::gzip_compress_with_crc(raw.data(), raw.size());
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(legacy.data()), legacy.size());
+    }
+    if (!run_queries(manager, "20260215_160000", grid, legacy.size(), false)) return false;
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_point_samples(const std::string& root, const std::vector<uint8_t>& grid) {
+    std::cout << "\n=== POINT SAMPLE TEST ===\n";
+    FrameStorageManager manager(root);
+    std::vector<uint8_t> bitmask, values;
+    pack(grid, bitmask, values);
+    manager.save_frame_bitmask("KTLX", "reflectivity", "20260215_170000", 0.5f, NUM_RAYS, NUM_GATES, GATE_SPACING, FIRST_GATE,
+                               bitmask, values);
+
+    // A flight path of points across the tilt, some past either end of the ray
+    std::vector<FrameStorageManager::FramePoints::Point> points;
+    for (int i = 0; i < 5000; ++i) {
+        points.push_back({-30.0f + i * 0.083f, FIRST_GATE - 2000.0f + i * 53.7f});
+    }
+    FrameStorageManager::FramePoints frame;
+    if (!manager.open_frame_points("KTLX", "reflectivity", "20260215_170000", 0.5f, frame)) {
+        std::cout << "❌ FAILED: could not open tilt\n";
+        return false;
+    }
+    std::vector<uint8_t> levels;
+    auto start = std::chrono::steady_clock::now();
+    frame.sample(points, levels);
+    double sample_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    // Every sample agrees with a one-cell sector read, or is empty off the end of the ray
+    size_t inside = 0;
+    for (size_t i = 0; i < points.size(); i += 97) {
+        FrameStorageManager::FrameSector sector;
+        bool found = manager.load_frame_sector("KTLX", "reflectivity", "20260215_170000", 0.5f, points[i].azimuth, points[i].azimuth,
+                                               points[i].range, points[i].range, sector);
+        uint8_t expected = found ? sector.values[0] : 0;
+        if (levels[i] != expected) {
+            std::cout << "❌ FAILED: point " << i << " sampled " << int(levels[i]) << ", sector read " << int(expected) << "\n";
+            return false;
+        }
+        inside += found;
+    }
+    std::vector<uint8_t> again;
+    if (inside == 0 || !manager.sample_frame_points("KTLX", "reflectivity", "20260215_170000", 0.5f, points, again) || again != levels) {
+        std::cout << "❌ FAILED: sample_frame_points differs\n";
+        return false;
+    }
+    std::cout << "   " << points.size() << " points sampled in " << sample_us << " us\n";
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "FRAME SECTOR TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_frame_sector_data";
+    fs::remove_all(root);
+    std::vector<uint8_t> grid = make_grid();
+
+    bool ok = true;
+    ok = test_blocked_file(root + "/blocked", grid) && ok;
+    ok = test_unindexed_file(root + "/unindexed", grid) && ok;
+    ok = test_point_samples(root + "/points", grid) && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Frame sector tests passed.\n" : "Frame sector tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+#include "levelii/ZlibUtils.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const std::vector<float> TILTS = {0.5f, 0.9f, 1.3f, 1.8f, 2.4f, 3.1f, 4.0f, 5.1f, 6.4f, 8.0f, 10.0f, 12.5f, 15.6f, 19.5f};
+
+    std::vector<uint8_t> make_payload(size_t size, uint32_t seed) {
+        std::vector<uint8_t> data(size);
+        uint32_t state = seed;
+        for (auto& b : data) {
+            state = state * 1664525u + 1013904223u;
+            b = static_cast<uint8_t>((state >> 24) & 0x3F);
+        }
+        return data;
+    }
+
+    void save_volume(FrameStorageManager& manager, const std::string& timestamp) {
+        const uint16_t num_rays = 720, num_gates = 1000;
+        std::vector<uint8_t> bitmask((num_rays * num_gates + 7) / 8, 0xAA);
+        for (size_t i = 0; i < TILTS.size(); ++i) {
+            std::vector<uint8_t> values = make_payload(num_rays * num_gates / 2, 11 + i);
+            manager.save_frame_bitmask("KTLX", "reflectivity", timestamp, TILTS[i], num_rays, num_gates, 250.0f, 2125.0f,
+                                       bitmask, values);
+        }
+    }
+
+    bool same_as_single_loads(const FrameStorageManager& manager, const std::string& timestamp,
+                              const FrameStorageManager::VolumeData& volume, const std::vector<float>& tilts) {
+        if (volume.tilts.size() != tilts.size()) return false;
+        for (size_t i = 0; i < tilts.size(); ++i) {
+            const auto& tilt = volume.tilts[i];
+            FrameStorageManager::CompressedFrameData single;
+            bool expected = manager.load_frame_bitmask("KTLX", "reflectivity", timestamp, tilts[i], single);
+            if (tilt.tilt != tilts[i] || tilt.loaded != expected) return false;
+            if (!expected) continue;
+            // Every payload must sit inside the one shared buffer
+            if (tilt.metadata != single.metadata || tilt.binary_data.size() != single.binary_data.size() ||
+                tilt.binary_data.begin() < volume.inflated.data() ||
+                tilt.binary_data.end() > volume.inflated.data() + volume.inflated.size() ||
+                !std::equal(tilt.binary_data.begin(), tilt.binary_data.end(), single.binary_data.begin())) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool test_load_volume_matches(const std::string& root) {
+    std::cout << "\n=== BATCH VOLUME LOAD TEST ===\n";
+    FrameStorageManager manager(root);
+    save_volume(manager, "20260215_150000");
+
+    // Out of order and repeated tilts come back as asked
+    std::vector<float> tilts = TILTS;
+    std::reverse(tilts.begin(), tilts.end());
+    tilts.push_back(0.5f);
+    for (int threads : {1, 4}) {
+        FrameStorageManager::VolumeData volume;
+        if (!manager.load_volume("KTLX", "reflectivity", "20260215_150000", tilts, volume, threads) ||
+            !same_as_single_loads(manager, "20260215_150000", volume, tilts)) {
+            std::cout << "❌ FAILED: " << threads << " threads differ from load_frame_bitmask\n";
+            return false;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (float tilt : TILTS) {
+        FrameStorageManager::CompressedFrameData single;
+        manager.load_frame_bitmask("KTLX", "reflectivity", "20260215_150000", tilt, single);
+    }
+    double serial_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    FrameStorageManager::VolumeData volume;
+    manager.load_volume("KTLX", "reflectivity", "20260215_150000", TILTS, volume);
+    double batch_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "   " << TILTS.size() << " tilts: one by one " << serial_ms << " ms, load_volume " << batch_ms << " ms\n";
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_load_volume_partial(const std::string& root) {
+    std::cout << "\n=== PARTIAL VOLUME LOAD TEST ===\n";
+    FrameStorageManager manager(root);
+    save_volume(manager, "20260215_160000");
+
+    // One corrupt tilt, one written as two gzip members, one that was never stored
+    std::string corrupt = manager.get_frame_path("KTLX", "reflectivity", "20260215_160000", 1.3f);
+    {
+        std::fstream file(corrupt, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-20, std::ios::end);
+        file.put('\x5A');
+    }
+    std::string split = manager.get_frame_path("KTLX", "reflectivity", "20260215_160000", 4.0f);
+    {
+        std::ifstream in(split, std::ios::binary);
+        std::vector<uint8_t> compressed((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::vector<uint8_t> raw = ZlibUtils::gzip_decompress(compressed.data(), compressed.size());
+        size_t half = raw.size() / 2;
+        auto first = ZlibUtils::gzip_compress(raw.data(), half);
+        auto second = ZlibUtils::gzip_compress(raw.data() + half, raw.size() - half);
+        std::ofstream out(split, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(first.data()), first.size());
+        out.write(reinterpret_cast<const char*>(second.data()), second.size());
+    }
+
+    std::vector<float> tilts = TILTS;
+    tilts.push_back(45.0f);
+    FrameStorageManager::VolumeData volume;
+    if (manager.load_volume("KTLX", "reflectivity", "20260215_160000", tilts, volume, 4)) {
+        std::cout << "❌ FAILED: volume with missing tilts reported complete\n";
+        return false;
+    }
+    if (!same_as_single_loads(manager, "20260215_160000", volume, tilts)) {
+        std::cout << "❌ FAILED: partial volume differs from load_frame_bitmask\n";
+        return false;
+    }
+    size_t loaded = std::count_if(volume.tilts.begin(), volume.tilts.end(), [](const auto& t) { return t.loaded; });
+    if (loaded != TILTS.size() - 1 || volume.tilts[2].loaded || !volume.tilts[6].loaded || volume.tilts.back().loaded) {
+        std::cout << "❌ FAILED: " << loaded << " tilts loaded\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "VOLUME LOAD TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_load_volume_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    ok = test_load_volume_matches(root + "/match") && ok;
+    ok = test_load_volume_partial(root + "/partial") && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Volume load tests passed.\n" : "Volume load tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
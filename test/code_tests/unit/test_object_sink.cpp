@@ -0,0 +1,323 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <filesystem>
+#include <thread>
+#include <chrono>
+#include "levelii/FrameStorageManager.h"
+#include "levelii/DatabaseUtils.h"
+
+namespace fs = std::filesystem;
+
+/**
+ * In-memory stand-in for an S3-compatible endpoint. Fails the first
+ * `fail_first` requests of every kind to exercise the retry path.
+ */
+class MemoryObjectStore : public ObjectStoreClient {
+public:
+    struct Shared {
+        std::mutex mutex;
+        std::map<std::string, std::vector<uint8_t>> objects;
+        std::map<std::string, std::map<int, std::vector<uint8_t>>> uploads;
+        std::atomic<int> fail_first{0};
+        std::atomic<int> requests{0};
+        std::atomic<int> multipart_completed{0};
+    };
+
+    explicit MemoryObjectStore(std::shared_ptr<Shared> shared) : shared_(shared) {}
+
+    bool put_object(const std::string& key, const uint8_t* data, size_t size, std::string& error) override {
+        if (should_fail(error)) return false;
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        shared_->objects[key].assign(data, data + size);
+        return true;
+    }
+
+    bool create_multipart_upload(const std::string& key, std::string& upload_id, std::string& error) override {
+        if (should_fail(error)) return false;
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        upload_id = key + "#upload";
+        shared_->uploads[upload_id].clear();
+        return true;
+    }
+
+    bool upload_part(const std::string&, const std::string& upload_id, int part_number, const uint8_t* data, size_t size, std::string& etag, std::string& error) override {
+        if (should_fail(error)) return false;
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        shared_->uploads[upload_id][part_number].assign(data, data + size);
+        etag = "etag-" + std::to_string(part_number);
+        return true;
+    }
+
+    bool complete_multipart_upload(const std::string& key, const std::string& upload_id, const std::vector<std::string>& etags, std::string& error) override {
+        if (should_fail(error)) return false;
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        auto& parts = shared_->uploads[upload_id];
+        if (parts.size() != etags.size()) {
+            error = "part count mismatch";
+            return false;
+        }
+        std::vector<uint8_t> object;
+        for (const auto& [number, bytes] : parts) object.insert(object.end(), bytes.begin(), bytes.end());
+        shared_->objects[key] = std::move(object);
+        shared_->uploads.erase(upload_id);
+        shared_->multipart_completed++;
+        return true;
+    }
+
+    void abort_multipart_upload(const std::string&, const std::string& upload_id) override {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        shared_->uploads.erase(upload_id);
+    }
+
+private:
+    std::shared_ptr<Shared> shared_;
+
+    bool should_fail(std::string& error) {
+        shared_->requests++;
+        if (shared_->fail_first.fetch_sub(1) > 0) {
+            error = "injected failure";
+            return true;
+        }
+        return false;
+    }
+};
+
+namespace {
+    ObjectSinkConfig fast_config() {
+        ObjectSinkConfig config;
+        config.key_prefix = "levelii";
+        config.retry_base_delay_ms = 1;
+        config.max_concurrent_uploads = 2;
+        return config;
+    }
+
+    void save_volume(FrameStorageManager& manager, const std::string& timestamp, size_t tilt_count, uint16_t num_gates) {
+        const uint16_t num_rays = 720;
+        size_t total = static_cast<size_t>(num_rays) * num_gates;
+        std::vector<uint8_t> bitmask((total + 7) / 8, 0);
+        std::vector<uint8_t> values;
+        // Pseudo-random echo so the .RDA files do not compress to nothing
+        uint32_t state = 12345;
+        for (size_t b = 0; b < total; ++b) {
+            state = state * 1664525u + 1013904223u;
+            if ((state >> 28) < 6) {
+                bitmask[b / 8] |= (1 << (7 - (b % 8)));
+                values.push_back(static_cast<uint8_t>(state >> 8));
+            }
+        }
+        for (size_t t = 0; t < tilt_count; ++t) {
+            manager.save_frame_bitmask("KTLX", "reflectivity", timestamp, 0.5f + t, num_rays, num_gates, 250.0f, 2125.0f, bitmask, values, {}, false);
+        }
+    }
+}
+
+bool test_pack_roundtrip(const std::string& root) {
+    std::cout << "\n=== PACK ROUNDTRIP TEST ===\n";
+    fs::create_directories(root);
+    std::vector<std::vector<uint8_t>> contents = {{1, 2, 3}, {}, {9, 8, 7, 6, 5}};
+    ObjectSink::Volume volume{"KTLX", "velocity", "20260215_150000", {}};
+    for (size_t i = 0; i < contents.size(); ++i) {
+        std::string path = root + "/f" + std::to_string(i);
+        std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(contents[i].data()), contents[i].size());
+        volume.files.emplace_back(std::to_string(i) + ".RDA", path);
+    }
+
+    auto packed = ObjectSink::pack_volume(volume);
+    // Header size is little-endian on every host, and the header is JSON
+    size_t header_size = packed[4] | (packed[5] << 8) | (packed[6] << 16) | (static_cast<size_t>(packed[7]) << 24);
+    if (packed.size() < 8 + header_size || packed[8] != '{' || packed[8 + header_size - 1] != '}') {
+        std::cout << "❌ FAILED: header size is not little-endian\n";
+        return false;
+    }
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> files;
+    if (!ObjectSink::unpack_volume(packed.data(), packed.size(), files) || files.size() != contents.size()) {
+        std::cout << "❌ FAILED: unpack\n";
+        return false;
+    }
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (files[i].first != volume.files[i].first || files[i].second != contents[i]) {
+            std::cout << "❌ FAILED: entry " << i << " differs\n";
+            return false;
+        }
+    }
+    if (ObjectSink::unpack_volume(packed.data(), packed.size() - 1, files)) {
+        std::cout << "❌ FAILED: truncated pack accepted\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_upload_with_retries(const std::string& root) {
+    std::cout << "\n=== UPLOAD / RETRY / MULTIPART TEST ===\n";
+    auto shared = std::make_shared<MemoryObjectStore::Shared>();
+    shared->fail_first = 3;
+
+    FrameStorageManager manager(root);
+    ObjectSinkConfig config = fast_config();
+    config.multipart_threshold = 256 * 1024;
+    config.part_size = 128 * 1024;
+    manager.enable_object_sink(std::make_unique<MemoryObjectStore>(shared), config);
+
+    save_volume(manager, "20260215_150000", 1, 100);   // Small: single PutObject
+    save_volume(manager, "20260215_150500", 6, 1000);  // Large: multipart
+    manager.publish_volume("KTLX", "reflectivity", "20260215_150000");
+    manager.publish_volume("KTLX", "reflectivity", "20260215_150500");
+    manager.flush_object_sink();
+
+    auto stats = manager.get_object_sink_stats();
+    if (stats.volumes_uploaded != 2 || stats.volumes_failed != 0 || stats.retries != 3) {
+        std::cout << "❌ FAILED: uploaded=" << stats.volumes_uploaded << " failed=" << stats.volumes_failed
+                  << " retries=" << stats.retries << "\n";
+        return false;
+    }
+    if (shared->multipart_completed != 1) {
+        std::cout << "❌ FAILED: expected one multipart upload\n";
+        return false;
+    }
+
+    const std::string key = "levelii/KTLX/reflectivity/20260215_150500.rdapack";
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> files;
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        auto it = shared->objects.find(key);
+        if (it == shared->objects.end() || !ObjectSink::unpack_volume(it->second.data(), it->second.size(), files)) {
+            std::cout << "❌ FAILED: multipart object missing or corrupt\n";
+            return false;
+        }
+    }
+    if (files.size() != 6 || fs::file_size(root + "/KTLX/reflectivity/20260215_150500/" + files[0].first) != files[0].second.size()) {
+        std::cout << "❌ FAILED: multipart object contents\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_index_tracks_uploads(const std::string& root) {
+    std::cout << "\n=== UPLOAD INDEX / RESUME TEST ===\n";
+    auto shared = std::make_shared<MemoryObjectStore::Shared>();
+
+    {
+        // Every request fails: the volume stays on disk and is recorded as not uploaded
+        shared->fail_first = 1000;
+        FrameStorageManager manager(root);
+        ObjectSinkConfig config = fast_config();
+        config.max_retries = 1;
+        manager.enable_object_sink(std::make_unique<MemoryObjectStore>(shared), config);
+        save_volume(manager, "20260215_160000", 2, 100);
+        manager.publish_volume("KTLX", "reflectivity", "20260215_160000");
+        manager.flush_object_sink();
+    }
+    {
+        levelii::SQLiteDatabase db(root + "/index.db");
+        auto rows = db.query("SELECT status FROM levelii_uploads WHERE timestamp = '20260215_160000';");
+        if (rows.size() != 1 || rows[0]["status"] != "failed") {
+            std::cout << "❌ FAILED: expected a failed upload row\n";
+            return false;
+        }
+    }
+    {
+        // The endpoint recovers: re-enabling the sink resumes the volume without a rescan
+        shared->fail_first = 0;
+        FrameStorageManager manager(root);
+        manager.enable_object_sink(std::make_unique<MemoryObjectStore>(shared), fast_config());
+        manager.flush_object_sink();
+    }
+    levelii::SQLiteDatabase db(root + "/index.db");
+    auto rows = db.query("SELECT status, object_key FROM levelii_uploads WHERE timestamp = '20260215_160000';");
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    if (rows.size() != 1 || rows[0]["status"] != "uploaded" || shared->objects.count(rows[0]["object_key"].get<std::string>()) != 1) {
+        std::cout << "❌ FAILED: volume was not resumed\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_failed_uploads_kept_and_retried(const std::string& root) {
+    std::cout << "\n=== FAILED UPLOAD RETENTION / RETRY TEST ===\n";
+    auto shared = std::make_shared<MemoryObjectStore::Shared>();
+    shared->fail_first = 1000000;
+
+    FrameStorageManager manager(root);
+    ObjectSinkConfig config = fast_config();
+    config.max_retries = 0;
+    config.volume_retry_base_ms = 20;
+    config.volume_retry_max_ms = 50;
+    manager.enable_object_sink(std::make_unique<MemoryObjectStore>(shared), config);
+
+    // Four volumes, the oldest of which has never reached the store
+    const std::vector<std::string> timestamps = {"20260215_170000", "20260215_170500", "20260215_171000", "20260215_171500"};
+    save_volume(manager, timestamps[0], 1, 100);
+    manager.publish_volume("KTLX", "reflectivity", timestamps[0]);
+    manager.flush_object_sink();
+    for (size_t i = 1; i < timestamps.size(); ++i) save_volume(manager, timestamps[i], 1, 100);
+
+    manager.cleanup_old_frames(1);
+    if (!fs::exists(root + "/KTLX/reflectivity/" + timestamps[0])) {
+        std::cout << "❌ FAILED: cleanup deleted a volume whose upload failed\n";
+        return false;
+    }
+    {
+        levelii::SQLiteDatabase db(root + "/index.db");
+        auto rows = db.query("SELECT status FROM levelii_uploads WHERE timestamp = '" + timestamps[0] + "';");
+        if (rows.size() != 1 || rows[0]["status"] != "failed") {
+            std::cout << "❌ FAILED: upload row dropped by cleanup\n";
+            return false;
+        }
+    }
+
+    // The endpoint recovers: the same process uploads the volume without a restart
+    shared->fail_first = 0;
+    std::string status;
+    for (int i = 0; i < 200 && status != "uploaded"; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        levelii::SQLiteDatabase db(root + "/index.db");
+        auto rows = db.query("SELECT status FROM levelii_uploads WHERE timestamp = '" + timestamps[0] + "';");
+        status = rows.empty() ? "" : rows[0]["status"].get<std::string>();
+    }
+    auto stats = manager.get_object_sink_stats();
+    if (status != "uploaded" || stats.volumes_uploaded != 1 || stats.volumes_failed < 2 || stats.waiting_retry != 0) {
+        std::cout << "❌ FAILED: status=" << status << " uploaded=" << stats.volumes_uploaded
+                  << " failed=" << stats.volumes_failed << " waiting=" << stats.waiting_retry << "\n";
+        return false;
+    }
+
+    // Once uploaded it is no longer protected from cleanup
+    manager.cleanup_old_frames(1);
+    if (fs::exists(root + "/KTLX/reflectivity/" + timestamps[0])) {
+        std::cout << "❌ FAILED: uploaded volume survived cleanup\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "OBJECT SINK TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_object_sink_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    ok = test_pack_roundtrip(root + "/pack") && ok;
+    ok = test_upload_with_retries(root + "/upload") && ok;
+    ok = test_index_tracks_uploads(root + "/resume") && ok;
+    ok = test_failed_uploads_kept_and_retried(root + "/failed") && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Object sink tests passed.\n" : "Object sink tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <thread>
+#include <iterator>
+#include "levelii/RadarParser.h"
+#include "levelii/DecompressionUtils.h"
+
+namespace {
+    const std::vector<std::string> PRODUCTS = {
+        "reflectivity", "velocity", "spectrum_width",
+        "differential_reflectivity", "differential_phase", "correlation_coefficient"
+    };
+
+    bool same_frame(const RadarFrame& a, const RadarFrame& b, std::string& why) {
+        if (a.nsweeps != b.nsweeps || a.nrays != b.nrays || a.ngates != b.ngates ||
+            a.gate_spacing_meters != b.gate_spacing_meters || a.first_gate_meters != b.first_gate_meters ||
+            a.available_tilts != b.available_tilts || a.nyquist_velocity != b.nyquist_velocity) {
+            why = "frame metadata differs";
+            return false;
+        }
+        for (size_t i = 0; i < a.sweeps.size(); ++i) {
+            const auto& sa = a.sweeps[i];
+            const auto& sb = b.sweeps[i];
+            if (sa.ray_count != sb.ray_count || sa.elevation_num != sb.elevation_num || sa.bins != sb.bins) {
+                why = "sweep " + std::to_string(i) + " differs";
+                return false;
+            }
+        }
+        const VolumePlan* pa = a.volume_plan.get();
+        const VolumePlan* pb = b.volume_plan.get();
+        if ((pa == nullptr) != (pb == nullptr)) {
+            why = "volume plan presence differs";
+            return false;
+        }
+        for (size_t i = 0; pa && i < pa->cuts.size(); ++i) {
+            if (pa->cuts[i].gates != pb->cuts[i].gates) {
+                why = "planned gate counts differ for cut " + std::to_string(i + 1);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    double parse_ms(const std::vector<uint8_t>& raw, int threads,
+                    std::unordered_map<std::string, std::unique_ptr<RadarFrame>>& out) {
+        ParseOptions options;
+        options.decode_threads = threads;
+        auto start = std::chrono::steady_clock::now();
+        out = parse_nexrad_level2_multi(raw, "KABR", "20250621_041210", PRODUCTS, nullptr, false, options);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <radar_file>" << std::endl;
+        return 1;
+    }
+    std::ifstream file(argv[1], std::ios::binary);
+    std::vector<uint8_t> compressed((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::vector<uint8_t> raw;
+    if (compressed.empty() || !RadarDecompression::auto_decompress(compressed, raw)) {
+        std::cerr << "Could not read " << argv[1] << std::endl;
+        return 1;
+    }
+
+    std::cout << "=== PARALLEL SWEEP DECODE TEST ===" << std::endl;
+    std::unordered_map<std::string, std::unique_ptr<RadarFrame>> serial;
+    double serial_ms = parse_ms(raw, 1, serial);
+    std::cout << "1 thread: " << serial_ms << " ms" << std::endl;
+
+    unsigned cores = std::max(2u, std::thread::hardware_concurrency());
+    for (int threads : {2, static_cast<int>(cores), 256}) {
+        std::unordered_map<std::string, std::unique_ptr<RadarFrame>> parallel;
+        double ms = parse_ms(raw, threads, parallel);
+        std::cout << threads << " threads: " << ms << " ms (" << serial_ms / ms << "x)" << std::endl;
+
+        for (const auto& product : PRODUCTS) {
+            std::string why;
+            if (!serial[product] || !parallel[product] || !same_frame(*serial[product], *parallel[product], why)) {
+                std::cout << "❌ FAILED: " << product << " with " << threads << " threads: " << why << std::endl;
+                return 1;
+            }
+        }
+    }
+    std::cout << "✅ PASSED: parallel output identical to serial" << std::endl;
+    return 0;
+}
@@ -5,6 +5,7 @@
 #include <iomanip>
 #include <set>
 #include <algorithm>
+#include <cmath>
 #include "levelii/RadarParser.h"
 #include "levelii/RadarFrame.h"
 
@@ -99,6 +100,35 @@ int main(int argc, char** argv) {
         }
     }
 
+    std::cout << "\n--- Volume Plan (Message 5) ---" << std::endl;
+    if (!frame->volume_plan || frame->volume_plan->cuts.empty()) {
+        std::cerr << "❌ FAILED: no volume plan decoded from Message 5" << std::endl;
+        return 1;
+    }
+    std::cout << "VCP " << frame->volume_plan->vcp_number << ", " << frame->volume_plan->cuts.size() << " cuts" << std::endl;
+    if (frame->volume_plan->vcp_number != frame->vcp_number) {
+        std::cerr << "❌ FAILED: Message 5 VCP differs from the radial VCP" << std::endl;
+        return 1;
+    }
+    for (const auto& sweep : frame->sweeps) {
+        const VolumePlan::Cut* cut = frame->volume_plan->cut(sweep.elevation_num);
+        if (!cut) {
+            std::cerr << "❌ FAILED: sweep " << sweep.index << " has no planned cut" << std::endl;
+            return 1;
+        }
+        std::cout << "Cut " << (int)sweep.elevation_num << ": " << cut->elevation_deg << " deg, waveform " << (int)cut->waveform
+                  << ", " << cut->expected_radials << " radials planned, " << sweep.ray_count << " received, "
+                  << cut->gates[1] << " REF gates" << std::endl;
+        if (std::abs(cut->elevation_deg - sweep.elevation_deg) > 0.5f || sweep.ray_count > cut->expected_radials + 2) {
+            std::cerr << "❌ FAILED: sweep does not match its planned cut" << std::endl;
+            return 1;
+        }
+        if (sweep.bins.capacity() != sweep.bins.size()) {
+            std::cerr << "❌ FAILED: sweep bins were not sized exactly (" << sweep.bins.capacity() << " vs " << sweep.bins.size() << ")" << std::endl;
+            return 1;
+        }
+    }
+
     std::cout << "\n--- Data Summary ---" << std::endl;
     size_t total_bins = 0;
     for (const auto& sweep : frame->sweeps) {
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <iterator>
+#include <unordered_map>
+#include "levelii/RadarParser.h"
+#include "levelii/DecompressionUtils.h"
+
+namespace {
+    const std::vector<std::string> PRODUCTS = {"reflectivity", "velocity"};
+
+    using Frames = std::unordered_map<std::string, std::unique_ptr<RadarFrame>>;
+
+    Frames parse(const std::vector<uint8_t>& raw) {
+        return parse_nexrad_level2_multi(raw, "KABR", "20250621_041210", PRODUCTS, nullptr, false);
+    }
+
+    std::vector<uint8_t> prefix_of(const std::vector<uint8_t>& raw, size_t bytes) {
+        size_t end = RadarDecompression::complete_ldm_prefix(raw.data(), std::min(bytes, raw.size()));
+        return std::vector<uint8_t>(raw.begin(), raw.begin() + end);
+    }
+}
+
+bool test_record_boundaries(const std::vector<uint8_t>& raw) {
+    std::cout << "\n=== COMPLETE LDM PREFIX TEST ===\n";
+    if (RadarDecompression::complete_ldm_prefix(raw.data(), raw.size()) != raw.size()) {
+        std::cout << "❌ FAILED: whole volume is not a complete prefix\n";
+        return false;
+    }
+    if (RadarDecompression::complete_ldm_prefix(raw.data(), 24) != 0 ||
+        RadarDecompression::complete_ldm_prefix(raw.data() + 1, raw.size() - 1) != 0) {
+        std::cout << "❌ FAILED: prefix found in a header or misaligned data\n";
+        return false;
+    }
+
+    // Cutting anywhere gives a record boundary at or before the cut, that is its own complete prefix
+    size_t last = 0;
+    for (size_t cut = 1000; cut < raw.size(); cut += 97 * 1024 + 13) {
+        size_t end = RadarDecompression::complete_ldm_prefix(raw.data(), cut);
+        if (end > cut || end < last || (end > 0 && RadarDecompression::complete_ldm_prefix(raw.data(), end) != end)) {
+            std::cout << "❌ FAILED: bad prefix " << end << " for a cut at " << cut << "\n";
+            return false;
+        }
+        last = end;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_finished_tilts(const std::vector<uint8_t>& raw) {
+    std::cout << "\n=== FINISHED TILTS FROM A PREFIX TEST ===\n";
+    auto full = parse(raw);
+    for (size_t kb : {512, 1024, 2048, 4096}) {
+        auto partial = parse(prefix_of(raw, kb * 1024));
+        size_t finished = 0;
+        for (const auto& product : PRODUCTS) {
+            const RadarFrame* whole = full[product].get();
+            const RadarFrame* part = partial.count(product) ? partial[product].get() : nullptr;
+            if (!whole || !part || part->sweeps.empty()) continue;
+
+            // Every sweep but those at the elevation being read when the range ended matches the full volume
+            float cut_elevation = part->sweeps.back().elevation_deg;
+            for (const auto& sweep : part->sweeps) {
+                if (std::abs(sweep.elevation_deg - cut_elevation) < 0.01f) continue;
+                const auto& expected = whole->sweeps.at(sweep.index);
+                if (sweep.elevation_deg != expected.elevation_deg || sweep.ray_count != expected.ray_count || sweep.bins != expected.bins) {
+                    std::cout << "❌ FAILED: " << product << " sweep " << sweep.index << " differs in a " << kb << " KB prefix\n";
+                    return false;
+                }
+                ++finished;
+            }
+        }
+        std::cout << "   " << kb << " KB of " << raw.size() / 1024 << " KB: " << finished << " finished sweeps\n";
+        if (kb == 4096 && finished == 0) {
+            std::cout << "❌ FAILED: no base tilt in the first 4 MB\n";
+            return false;
+        }
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <nexrad_file>\n";
+        return 1;
+    }
+    std::ifstream f(argv[1], std::ios::binary);
+    std::vector<uint8_t> raw((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    if (raw.empty()) {
+        std::cerr << "Could not read " << argv[1] << "\n";
+        return 1;
+    }
+
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "PARTIAL VOLUME TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    bool ok = true;
+    ok = test_record_boundaries(raw) && ok;
+    ok = test_finished_tilts(raw) && ok;
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Partial volume tests passed.\n" : "Partial volume tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
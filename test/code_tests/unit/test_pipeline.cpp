@@ -0,0 +1,232 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include "levelii/Pipeline.h"
+
+using namespace std::chrono_literals;
+
+namespace {
+    struct Job {
+        int id = 0;
+        std::vector<int> trail;                  // Stages the job went through
+        std::unique_ptr<int> payload;            // Move-only, like a pooled buffer
+    };
+
+    using JobPipeline = levelii::Pipeline<Job>;
+
+    const JobPipeline::StageStats* find(const std::vector<JobPipeline::StageStats>& stats, const std::string& name) {
+        for (const auto& s : stats) {
+            if (s.name == name) return &s;
+        }
+        return nullptr;
+    }
+}
+
+bool test_every_item_through_every_stage() {
+    std::cout << "\n=== PIPELINE DELIVERY TEST ===\n";
+    std::mutex done_mutex;
+    std::vector<Job> done;
+    {
+        JobPipeline pipeline;
+        for (int stage = 0; stage < 3; ++stage) {
+            pipeline.add_stage("stage" + std::to_string(stage), 1 + stage, 2, [stage](Job& job) {
+                job.trail.push_back(stage);
+                return true;
+            });
+        }
+        // Odd jobs are dropped by the last step and never reach the sink
+        pipeline.add_batch_stage("sink", 1, 8, 8, [&](std::vector<Job>& jobs) {
+            std::lock_guard<std::mutex> lock(done_mutex);
+            for (auto& job : jobs) {
+                if (job.id % 2 == 0) done.push_back(std::move(job));
+            }
+            jobs.clear();
+        });
+        pipeline.start();
+        for (int i = 0; i < 200; ++i) {
+            Job job;
+            job.id = i;
+            job.payload = std::make_unique<int>(i);
+            if (!pipeline.push(job)) {
+                std::cout << "❌ FAILED: push refused before close\n";
+                return false;
+            }
+        }
+        pipeline.close();
+        pipeline.join();
+
+        Job late;
+        if (pipeline.push(late) || pipeline.in_flight() != 0) {
+            std::cout << "❌ FAILED: closed pipeline accepted work or lost count of items\n";
+            return false;
+        }
+        auto stats = pipeline.stats();
+        if (find(stats, "stage0")->processed != 200 || find(stats, "sink")->processed != 200 || find(stats, "stage2")->dropped != 0) {
+            std::cout << "❌ FAILED: wrong per-stage counts\n";
+            return false;
+        }
+    }
+
+    std::set<int> ids;
+    for (const auto& job : done) {
+        if (job.trail != std::vector<int>{0, 1, 2} || !job.payload || *job.payload != job.id) {
+            std::cout << "❌ FAILED: job " << job.id << " skipped a stage or lost its payload\n";
+            return false;
+        }
+        ids.insert(job.id);
+    }
+    if (ids.size() != 100) {
+        std::cout << "❌ FAILED: " << ids.size() << " of 100 jobs delivered\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_dropped_items() {
+    std::cout << "\n=== PIPELINE DROP TEST ===\n";
+    std::atomic<int> reached{0};
+    JobPipeline pipeline;
+    pipeline.add_stage("filter", 2, 4, [](Job& job) {
+        if (job.id == 7) throw std::runtime_error("bad job");
+        return job.id % 3 != 0;
+    });
+    pipeline.add_stage("count", 1, 4, [&](Job&) {
+        reached.fetch_add(1);
+        return true;
+    });
+    pipeline.start();
+    for (int i = 0; i < 30; ++i) {
+        Job job;
+        job.id = i;
+        pipeline.push(job);
+    }
+    pipeline.close();
+    pipeline.join();
+
+    auto stats = pipeline.stats();
+    // 10 multiples of 3 dropped, plus job 7 whose step threw
+    if (reached.load() != 19 || find(stats, "filter")->dropped != 11 || pipeline.in_flight() != 0) {
+        std::cout << "❌ FAILED: " << reached.load() << " jobs reached the second stage\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_backpressure_and_bottleneck() {
+    std::cout << "\n=== PIPELINE BACKPRESSURE TEST ===\n";
+    // A fast "download" feeding a slow single-worker "decode": queues stay
+    // bounded, the producer is held back, and the metrics name the bottleneck
+    std::atomic<size_t> max_in_flight{0};
+    JobPipeline pipeline;
+    pipeline.add_stage("download", 4, 2, [](Job&) {
+        std::this_thread::sleep_for(1ms);
+        return true;
+    });
+    pipeline.add_stage("decode", 1, 2, [](Job&) {
+        std::this_thread::sleep_for(5ms);
+        return true;
+    });
+    pipeline.add_stage("store", 2, 2, [](Job&) { return true; });
+    pipeline.start();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 60; ++i) {
+        Job job;
+        job.id = i;
+        pipeline.push(job);
+        max_in_flight = std::max(max_in_flight.load(), pipeline.in_flight());
+    }
+    double push_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    pipeline.close();
+    pipeline.join();
+
+    auto stats = pipeline.stats();
+    const auto* download = find(stats, "download");
+    const auto* decode = find(stats, "decode");
+    const auto* store = find(stats, "store");
+    std::cout << "   producer held back for " << push_ms << " ms, at most " << max_in_flight.load() << " jobs in flight\n";
+    for (const auto* s : {download, decode, store}) {
+        std::cout << "   " << s->name << ": " << s->workers << " workers, busy " << s->busy_seconds * 1000 << " ms, blocked "
+                  << s->blocked_seconds * 1000 << " ms, utilization " << s->utilization * 100 << "%\n";
+    }
+
+    // Capacity bound: 2 per channel plus one item per worker of each stage, plus the producer's
+    size_t bound = 3 * 2 + 4 + 1 + 2 + 1;
+    if (max_in_flight.load() > bound || push_ms < 150) {
+        std::cout << "❌ FAILED: producer was not held back by the slow stage\n";
+        return false;
+    }
+    if (decode->utilization < download->utilization || decode->utilization < store->utilization ||
+        download->blocked_seconds <= store->blocked_seconds) {
+        std::cout << "❌ FAILED: metrics do not single out the saturated stage\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_batch_stage_coalesces() {
+    std::cout << "\n=== PIPELINE BATCH STAGE TEST ===\n";
+    std::atomic<int> calls{0};
+    std::atomic<int> items{0};
+    std::atomic<bool> release{false};
+    JobPipeline pipeline;
+    pipeline.add_stage("work", 4, 4, [&](Job&) {
+        while (!release.load()) std::this_thread::sleep_for(1ms);
+        return true;
+    });
+    pipeline.add_batch_stage("index", 1, 64, 64, [&](std::vector<Job>& jobs) {
+        calls.fetch_add(1);
+        items.fetch_add(static_cast<int>(jobs.size()));
+        std::this_thread::sleep_for(20ms);
+    });
+    pipeline.start();
+    std::thread producer([&] {
+        for (int i = 0; i < 40; ++i) {
+            Job job;
+            job.id = i;
+            pipeline.push(job);
+        }
+        pipeline.close();
+    });
+    std::this_thread::sleep_for(10ms);
+    release = true;
+    producer.join();
+    pipeline.join();
+
+    std::cout << "   " << items.load() << " jobs indexed in " << calls.load() << " calls\n";
+    if (items.load() != 40 || calls.load() >= 40) {
+        std::cout << "❌ FAILED: batch stage did not coalesce queued jobs\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "STAGED PIPELINE TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    bool ok = true;
+    ok = test_every_item_through_every_stage() && ok;
+    ok = test_dropped_items() && ok;
+    ok = test_backpressure_and_bottleneck() && ok;
+    ok = test_batch_stage_coalesces() && ok;
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Staged pipeline tests passed.\n" : "Staged pipeline tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include "levelii/BackgroundFrameFetcher.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const uint16_t NUM_RAYS = 720, NUM_GATES = 400;
+
+    // Pseudo-random echo over `total` cells, as a presence bitmask and packed values
+    void make_echo(size_t total, uint32_t seed, std::vector<uint8_t>& bitmask, std::vector<uint8_t>& values) {
+        bitmask.assign((total + 7) / 8, 0);
+        values.clear();
+        uint32_t state = seed;
+        for (size_t b = 0; b < total; ++b) {
+            state = state * 1664525u + 1013904223u;
+            if ((state >> 28) < 6) {
+                bitmask[b / 8] |= (1 << (7 - (b % 8)));
+                values.push_back(static_cast<uint8_t>(1 + ((state >> 8) % 255)));
+            }
+        }
+    }
+}
+
+bool test_cost_add() {
+    std::cout << "\n=== STATION COST ADD TEST ===\n";
+    StationCost total;
+    StationCost first;
+    first.download_cpu_ns = 10;
+    first.decode_cpu_ns = 20;
+    first.store_cpu_ns = 30;
+    first.index_cpu_ns = 40;
+    first.bytes_downloaded = 1000;
+    first.bytes_decompressed = 4000;
+    first.bytes_stored = 500;
+    first.peak_scratch_bytes = 8192;
+    first.volumes = 1;
+    StationCost second = first;
+    second.decode_cpu_ns = 5;
+    second.peak_scratch_bytes = 4096;
+
+    total.add(first);
+    total.add(second);
+    if (total.download_cpu_ns != 20 || total.decode_cpu_ns != 25 || total.store_cpu_ns != 60 || total.index_cpu_ns != 80 ||
+        total.cpu_ns() != 185) {
+        std::cout << "❌ FAILED: CPU time not summed\n";
+        return false;
+    }
+    if (total.bytes_downloaded != 2000 || total.bytes_decompressed != 8000 || total.bytes_stored != 1000 || total.volumes != 2) {
+        std::cout << "❌ FAILED: bytes or volumes not summed\n";
+        return false;
+    }
+    // Peak scratch is one volume's footprint, so it takes the max rather than a sum
+    if (total.peak_scratch_bytes != 8192) {
+        std::cout << "❌ FAILED: peak scratch " << total.peak_scratch_bytes << ", expected 8192\n";
+        return false;
+    }
+    second.peak_scratch_bytes = 16384;
+    total.add(second);
+    if (total.peak_scratch_bytes != 16384 || total.volumes != 3) {
+        std::cout << "❌ FAILED: a larger peak did not replace the old one\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_stored_bytes(const std::string& root) {
+    std::cout << "\n=== STORED BYTES REPORT TEST ===\n";
+    FrameStorageManager manager(root);
+    std::vector<uint8_t> bitmask, values;
+    make_echo(static_cast<size_t>(NUM_RAYS) * NUM_GATES, 99, bitmask, values);
+
+    size_t frame_bytes = 0;
+    bool saved = manager.save_frame_bitmask("KTLX", "reflectivity", "20260215_150000", 0.5f, NUM_RAYS, NUM_GATES, 250.0f,
+                                            2125.0f, bitmask, values, {}, true, &frame_bytes);
+    std::string frame_path = manager.get_frame_path("KTLX", "reflectivity", "20260215_150000", 0.5f);
+    if (!saved || frame_bytes == 0 || frame_bytes != fs::file_size(frame_path)) {
+        std::cout << "❌ FAILED: tilt reported " << frame_bytes << " bytes\n";
+        return false;
+    }
+
+    const std::vector<float> tilts = {0.5f, 1.5f};
+    std::vector<uint8_t> volume_mask, volume_values;
+    make_echo(tilts.size() * NUM_RAYS * NUM_GATES, 100, volume_mask, volume_values);
+    size_t volume_bytes = 0;
+    saved = manager.save_volumetric_bitmask("KTLX", "reflectivity", "20260215_150000", tilts, NUM_RAYS, NUM_GATES, 250.0f,
+                                            2125.0f, volume_mask, volume_values, {}, true, &volume_bytes);
+    fs::path volume_dir = fs::path(frame_path).parent_path();
+    if (!saved || volume_bytes == 0 || volume_bytes != fs::file_size(volume_dir / "volumetric.RDA")) {
+        std::cout << "❌ FAILED: volume reported " << volume_bytes << " bytes\n";
+        return false;
+    }
+    std::cout << "   tilt " << frame_bytes << " bytes, volume " << volume_bytes << " bytes\n";
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "STATION COST TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_station_cost_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    ok = test_cost_add() && ok;
+    ok = test_stored_bytes(root) && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Station cost tests passed.\n" : "Station cost tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include "levelii/ZlibUtils.h"
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const uint16_t NUM_RAYS = 360, NUM_GATES = 400;
+    const std::vector<float> TILTS = {0.5f, 1.5f, 2.4f};
+
+    std::string minutes_ago(int minutes) {
+        std::time_t t = std::time(nullptr) - static_cast<std::time_t>(minutes) * 60;
+        std::tm tm_utc{};
+        gmtime_r(&t, &tm_utc);
+        char buf[16];
+        std::strftime(buf, sizeof(buf), "%Y%m%d_%H%M%S", &tm_utc);
+        return buf;
+    }
+
+    struct Grid {
+        std::vector<uint8_t> bitmask;
+        std::vector<uint8_t> values;
+    };
+
+    Grid make_grid(uint32_t seed) {
+        Grid g;
+        g.bitmask.assign((NUM_RAYS * NUM_GATES + 7) / 8, 0);
+        uint32_t state = seed;
+        for (size_t i = 0; i < static_cast<size_t>(NUM_RAYS) * NUM_GATES; ++i) {
+            state = state * 1664525u + 1013904223u;
+            if ((state >> 28) < 6) {
+                g.bitmask[i / 8] |= (1 << (7 - (i % 8)));
+                g.values.push_back(static_cast<uint8_t>(1 + ((i / NUM_GATES) + (i % NUM_GATES) / 8) % 200));
+            }
+        }
+        return g;
+    }
+
+    void save_volume(FrameStorageManager& manager, const std::string& timestamp) {
+        for (size_t i = 0; i < TILTS.size(); ++i) {
+            Grid g = make_grid(7 + i);
+            manager.save_frame_bitmask("KTLX", "reflectivity", timestamp, TILTS[i], NUM_RAYS, NUM_GATES, 250.0f, 2125.0f,
+                                       g.bitmask, g.values);
+        }
+    }
+
+    bool volume_intact(const FrameStorageManager& manager, const std::string& timestamp) {
+        for (size_t i = 0; i < TILTS.size(); ++i) {
+            Grid g = make_grid(7 + i);
+            FrameStorageManager::CompressedFrameData frame;
+            if (!manager.load_frame_bitmask("KTLX", "reflectivity", timestamp, TILTS[i], frame) ||
+                frame.binary_data.size() != g.bitmask.size() + g.values.size() ||
+                !std::equal(g.bitmask.begin(), g.bitmask.end(), frame.binary_data.begin()) ||
+                !std::equal(g.values.begin(), g.values.end(), frame.binary_data.begin() + g.bitmask.size())) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    FrameStorageManager::TieringConfig make_config(const std::string& root) {
+        FrameStorageManager::TieringConfig config;
+        // Listed cold first: enable_tiering numbers tiers by age, so warm is still tier 1
+        config.tiers = {{root + "/cold", 24 * 60, ZlibUtils::max_level()}, {root + "/warm", 60, 6}};
+        config.hot_gzip_level = 1;
+        config.hot_reads = 6;
+        config.scan_interval_seconds = 0;
+        config.bytes_per_second = size_t(1) << 40;
+        return config;
+    }
+}
+
+bool test_migrate_by_age(const std::string& root, const std::string& recent, const std::string& warm, const std::string& cold) {
+    std::cout << "\n=== TIER MIGRATION TEST ===\n";
+    FrameStorageManager manager(root + "/hot");
+    manager.enable_tiering(make_config(root));
+    save_volume(manager, recent);
+    save_volume(manager, warm);
+    save_volume(manager, cold);
+    size_t hot_size = fs::file_size(manager.get_frame_path("KTLX", "reflectivity", cold, 0.5f));
+    int frames = manager.get_frame_count();
+
+    size_t moved = manager.migrate_tiers();
+    if (moved != 2 || manager.volume_tier("KTLX", "reflectivity", recent) != 0 ||
+        manager.volume_tier("KTLX", "reflectivity", warm) != 1 || manager.volume_tier("KTLX", "reflectivity", cold) != 2) {
+        std::cout << "❌ FAILED: " << moved << " volumes moved\n";
+        return false;
+    }
+    std::string cold_path = manager.get_frame_path("KTLX", "reflectivity", cold, 0.5f);
+    if (cold_path.rfind(root + "/cold/", 0) != 0 || !fs::exists(cold_path)) {
+        std::cout << "❌ FAILED: cold volume resolves to " << cold_path << "\n";
+        return false;
+    }
+    size_t cold_size = fs::file_size(cold_path);
+    std::cout << "   0.5 tilt: " << hot_size << " bytes hot (level 1), " << cold_size << " bytes cold (level "
+              << ZlibUtils::max_level() << ")\n";
+    if (cold_size >= hot_size) {
+        std::cout << "❌ FAILED: cold copy was not recompressed\n";
+        return false;
+    }
+
+    // Reads go to the new tier; ray blocks were rebuilt for the new level
+    FrameStorageManager::FrameSector sector;
+    if (!volume_intact(manager, recent) || !volume_intact(manager, warm) || !volume_intact(manager, cold) ||
+        !manager.load_frame_sector("KTLX", "reflectivity", cold, 0.5f, 10.0f, 20.0f, 0.0f, 0.0f, sector)) {
+        std::cout << "❌ FAILED: moved volumes do not read back\n";
+        return false;
+    }
+
+    // Old copies stay for one pass, then go
+    std::string old_copy = root + "/hot/KTLX/reflectivity/" + cold;
+    if (!fs::exists(old_copy)) {
+        std::cout << "❌ FAILED: old copy removed while readers may still use it\n";
+        return false;
+    }
+    manager.migrate_tiers();
+    if (fs::exists(old_copy) || manager.get_frame_count() != frames) {
+        std::cout << "❌ FAILED: old copy left behind, " << manager.get_frame_count() << " frames counted\n";
+        return false;
+    }
+
+    // The index checksums follow the recompressed files
+    FrameStorageManager::ScrubberConfig scrub;
+    scrub.bytes_per_second = size_t(1) << 40;
+    manager.start_scrubber(scrub);
+    for (int i = 0; i < 200 && manager.get_scrub_stats().passes_completed == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    manager.stop_scrubber();
+    auto scrubbed = manager.get_scrub_stats();
+    if (scrubbed.passes_completed == 0 || scrubbed.corrupt_found != 0 || scrubbed.files_checked != TILTS.size() * 3) {
+        std::cout << "❌ FAILED: scrubber checked " << scrubbed.files_checked << " files, " << scrubbed.corrupt_found << " corrupt\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_promote_on_reads(const std::string& root, const std::string& cold) {
+    std::cout << "\n=== TIER PROMOTION TEST ===\n";
+    FrameStorageManager manager(root + "/hot");
+    manager.enable_tiering(make_config(root));
+    if (manager.volume_tier("KTLX", "reflectivity", cold) != 2) {
+        std::cout << "❌ FAILED: tier not restored from the index\n";
+        return false;
+    }
+    for (int i = 0; i < 6; ++i) {
+        FrameStorageManager::CompressedFrameData frame;
+        manager.load_frame_bitmask("KTLX", "reflectivity", cold, 0.5f, frame);
+    }
+    manager.migrate_tiers();
+    if (manager.volume_tier("KTLX", "reflectivity", cold) != 0 || !volume_intact(manager, cold)) {
+        std::cout << "❌ FAILED: frequently read volume not promoted\n";
+        return false;
+    }
+    // Read since the last pass (by volume_intact): stays hot. Not read at all: goes back
+    manager.migrate_tiers();
+    manager.migrate_tiers();
+    auto stats = manager.get_tiering_stats();
+    if (manager.volume_tier("KTLX", "reflectivity", cold) != 2 || stats.volumes_promoted != 1 || stats.volumes_demoted != 1) {
+        std::cout << "❌ FAILED: promoted " << stats.volumes_promoted << ", demoted " << stats.volumes_demoted << "\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+bool test_restart_recovery(const std::string& root, const std::string& warm, const std::string& cold) {
+    std::cout << "\n=== TIER RECOVERY TEST ===\n";
+    // A move interrupted after writing part of the target, and a volume the index never heard of
+    std::string partial = root + "/warm/KTLX/reflectivity/" + cold;
+    fs::create_directories(partial);
+    fs::copy_file(root + "/cold/KTLX/reflectivity/" + cold + "/0.5.RDA", partial + "/0.5.RDA");
+    std::string stray = minutes_ago(5 * 24 * 60);
+    fs::create_directories(root + "/cold/KTLX/reflectivity/" + stray);
+    fs::copy_file(root + "/cold/KTLX/reflectivity/" + cold + "/0.5.RDA", root + "/cold/KTLX/reflectivity/" + stray + "/0.5.RDA");
+
+    FrameStorageManager manager(root + "/hot");
+    manager.enable_tiering(make_config(root));
+    FrameStorageManager::CompressedFrameData frame;
+    if (fs::exists(partial) || manager.volume_tier("KTLX", "reflectivity", stray) != 2 ||
+        !manager.load_frame_bitmask("KTLX", "reflectivity", stray, 0.5f, frame) || !volume_intact(manager, cold) ||
+        !volume_intact(manager, warm)) {
+        std::cout << "❌ FAILED: leftover copies not resolved\n";
+        return false;
+    }
+
+    // Retention covers every tier
+    manager.cleanup_old_frames(1);
+    if (fs::exists(root + "/warm/KTLX") || fs::exists(root + "/cold/KTLX") || manager.volume_tier("KTLX", "reflectivity", cold) != 0 ||
+        manager.get_frame_count() != static_cast<int>(TILTS.size())) {
+        std::cout << "❌ FAILED: cleanup left " << manager.get_frame_count() << " frames\n";
+        return false;
+    }
+    std::cout << "✅ PASSED\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "STORAGE TIER TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_storage_tiers_data";
+    fs::remove_all(root);
+    const std::string recent = minutes_ago(10);
+    const std::string warm = minutes_ago(3 * 60);
+    const std::string cold = minutes_ago(3 * 24 * 60);
+
+    bool ok = true;
+    ok = test_migrate_by_age(root, recent, warm, cold) && ok;
+    ok = ok && test_promote_on_reads(root, cold);
+    ok = ok && test_restart_recovery(root, warm, cold);
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Storage tier tests passed.\n" : "Storage tier tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,301 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <map>
+#include <limits>
+#include "levelii/FrameStorageManager.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr uint16_t NUM_RAYS = 720;
+    constexpr uint16_t NUM_GATES = 300;
+    constexpr float GATE_SPACING = 250.0f;
+    constexpr float FIRST_GATE = 2125.0f;
+
+    // Echo at rays [710, 720) + [0, 10) and gates [100, 140), value fixed per frame
+    void make_frame(uint8_t level, std::vector<uint8_t>& bitmask, std::vector<uint8_t>& values) {
+        size_t total = static_cast<size_t>(NUM_RAYS) * NUM_GATES;
+        bitmask.assign((total + 7) / 8, 0);
+        values.clear();
+        for (size_t r = 0; r < NUM_RAYS; ++r) {
+            if (r >= 10 && r < 710) continue;
+            for (size_t g = 100; g < 140; ++g) {
+                size_t b = r * NUM_GATES + g;
+                bitmask[b / 8] |= (1 << (7 - (b % 8)));
+                values.push_back(level);
+            }
+        }
+    }
+
+    float gate_center(int gate) {
+        return FIRST_GATE + (gate + 0.5f) * GATE_SPACING;
+    }
+
+    TimeSeriesArchive::Query point_query(float tilt) {
+        TimeSeriesArchive::Query q;
+        q.station = "KTLX";
+        q.product = "reflectivity";
+        q.tilt = tilt;
+        q.start = "20260215_000000";
+        q.end = "20260215_235959";
+        q.azimuth_min = q.azimuth_max = 1.0f;
+        q.range_min_m = q.range_max_m = gate_center(120);
+        return q;
+    }
+
+    bool append(TimeSeriesArchive& archive, const std::string& timestamp, float tilt, uint8_t level) {
+        std::vector<uint8_t> bitmask, values;
+        make_frame(level, bitmask, values);
+        return archive.append_frame("KTLX", "reflectivity", timestamp, tilt, NUM_RAYS, NUM_GATES, GATE_SPACING, FIRST_GATE,
+                                    bitmask, values);
+    }
+
+    std::map<std::string, uintmax_t> tile_sizes(const std::string& dir) {
+        std::map<std::string, uintmax_t> sizes;
+        for (const auto& entry : fs::directory_iterator(dir)) {
+            if (entry.is_regular_file()) sizes[entry.path().filename().string()] = entry.file_size();
+        }
+        return sizes;
+    }
+}
+
+bool test_point_and_area_queries(FrameStorageManager& manager) {
+    std::cout << "\n=== POINT / AREA QUERY TEST ===\n";
+
+    const std::vector<std::string> timestamps = {
+        "20260215_150000", "20260215_150500", "20260215_151000", "20260215_160000"
+    };
+
+    std::vector<uint8_t> bitmask, values;
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+        make_frame(static_cast<uint8_t>(50 + i * 10), bitmask, values);
+        if (!manager.save_frame_bitmask("KTLX", "reflectivity", timestamps[i], 0.5f,
+                                        NUM_RAYS, NUM_GATES, GATE_SPACING, FIRST_GATE,
+                                        bitmask, values)) {
+            std::cout << "❌ FAILED: save_frame_bitmask\n";
+            return false;
+        }
+    }
+
+    // An empty frame is indexed but writes no tiles
+    std::vector<uint8_t> empty_mask((static_cast<size_t>(NUM_RAYS) * NUM_GATES + 7) / 8, 0);
+    manager.save_frame_bitmask("KTLX", "reflectivity", "20260215_151500", 0.5f,
+                               NUM_RAYS, NUM_GATES, GATE_SPACING, FIRST_GATE, empty_mask, {});
+
+    TimeSeriesArchive::Query q;
+    q.station = "KTLX";
+    q.product = "reflectivity";
+    q.tilt = 0.5f;
+    q.start = "20260215_000000";
+    q.end = "20260215_235959";
+    q.azimuth_min = q.azimuth_max = 1.0f;
+    q.range_min_m = q.range_max_m = gate_center(120);
+
+    auto samples = manager.query_timeseries(q);
+    if (samples.size() != 5) {
+        std::cout << "❌ FAILED: expected 5 samples, got " << samples.size() << "\n";
+        return false;
+    }
+    if (samples[0].count != 1 || samples[0].mean != 50.0f || samples[4].max != 80) {
+        std::cout << "❌ FAILED: point values incorrect\n";
+        return false;
+    }
+    if (samples[3].timestamp != "20260215_151500" || samples[3].count != 0) {
+        std::cout << "❌ FAILED: empty frame should report no data\n";
+        return false;
+    }
+    std::cout << "✅ PASSED: point query\n";
+
+    // Area wrapping through north: rays 716..4 (9 rays) x gates 130..149 (10 inside echo)
+    q.azimuth_min = 358.0f;
+    q.azimuth_max = 2.0f;
+    q.range_min_m = gate_center(130);
+    q.range_max_m = gate_center(149);
+    q.start = q.end = "20260215_150500";
+    samples = manager.query_timeseries(q);
+    if (samples.size() != 1 || samples[0].count != 90 || samples[0].min != 60 || samples[0].max != 60) {
+        std::cout << "❌ FAILED: wrapped area query (count=" << (samples.empty() ? 0 : samples[0].count) << ")\n";
+        return false;
+    }
+    std::cout << "✅ PASSED: wrapped area query\n";
+
+    // Outside the echo
+    q.azimuth_min = q.azimuth_max = 180.0f;
+    samples = manager.query_timeseries(q);
+    if (samples.size() != 1 || samples[0].count != 0) {
+        std::cout << "❌ FAILED: query outside echo\n";
+        return false;
+    }
+    std::cout << "✅ PASSED: query outside echo\n";
+
+    // Ranges past every gate, or not numbers at all, find nothing
+    q.azimuth_min = 358.0f;
+    q.azimuth_max = 2.0f;
+    q.range_max_m = 1e30f;
+    samples = manager.query_timeseries(q);
+    if (samples.size() != 1 || samples[0].count != 90) {
+        std::cout << "❌ FAILED: range beyond the last gate should clamp\n";
+        return false;
+    }
+    q.range_min_m = 1e30f;
+    samples = manager.query_timeseries(q);
+    if (samples.size() != 1 || samples[0].count != 0) {
+        std::cout << "❌ FAILED: area past the last gate should be empty\n";
+        return false;
+    }
+    q.range_min_m = std::numeric_limits<float>::quiet_NaN();
+    if (!manager.query_timeseries(q).empty()) {
+        std::cout << "❌ FAILED: NaN range should be rejected\n";
+        return false;
+    }
+    std::cout << "✅ PASSED: out-of-range and NaN ranges\n";
+    return true;
+}
+
+bool test_prune(const std::string& root) {
+    std::cout << "\n=== PRUNE TEST ===\n";
+
+    levelii::SQLiteDatabase db(root + "/index.db");
+    TimeSeriesArchive archive(root + "/_timeseries", db);
+    archive.prune_before("20260215_160000");
+
+    TimeSeriesArchive::Query q;
+    q.station = "KTLX";
+    q.product = "reflectivity";
+    q.tilt = 0.5f;
+    q.start = "20260215_000000";
+    q.end = "20260215_235959";
+    q.azimuth_min = q.azimuth_max = 1.0f;
+    q.range_min_m = q.range_max_m = gate_center(120);
+
+    auto samples = archive.query(q);
+    if (samples.size() != 1 || samples[0].timestamp != "20260215_160000" || samples[0].count != 1) {
+        std::cout << "❌ FAILED: expected only the 16Z frame after pruning\n";
+        return false;
+    }
+    if (fs::exists(root + "/_timeseries/KTLX/reflectivity/0.5/20260215_15_720x300")) {
+        std::cout << "❌ FAILED: pruned chunk still on disk\n";
+        return false;
+    }
+    std::cout << "✅ PASSED: prune\n";
+    return true;
+}
+
+bool test_torn_tail(const std::string& root) {
+    std::cout << "\n=== TORN APPEND TEST ===\n";
+    fs::create_directories(root);
+    levelii::SQLiteDatabase db(root + "/index.db");
+    TimeSeriesArchive archive(root + "/_timeseries", db);
+    const std::string chunk = root + "/_timeseries/KTLX/reflectivity/0.5/20260215_15_720x300";
+    append(archive, "20260215_150000", 0.5f, 50);
+
+    // A crash part way through a record: header written, payload cut short
+    for (const auto& [name, size] : tile_sizes(chunk)) {
+        std::ofstream file(chunk + "/" + name, std::ios::binary | std::ios::app);
+        uint32_t claimed = 1000;
+        file.write("TSR1", 4);
+        file.write(reinterpret_cast<const char*>(&claimed), 4);
+        file.write("20260215_15", 11);
+    }
+    append(archive, "20260215_150500", 0.5f, 60);
+
+    auto samples = archive.query(point_query(0.5f));
+    if (samples.size() != 2 || samples[0].mean != 50.0f || samples[1].count != 1 || samples[1].mean != 60.0f) {
+        std::cout << "❌ FAILED: the frame after a torn record was lost\n";
+        return false;
+    }
+    std::cout << "✅ PASSED: torn tail\n";
+
+    // A tile that cannot be written: the tiles already appended are cut back, nothing is recorded
+    auto before = tile_sizes(chunk);
+    fs::remove(chunk + "/r11_g01.TSC");
+    fs::create_directories(chunk + "/r11_g01.TSC");
+    before.erase("r11_g01.TSC");
+    bool failed = !append(archive, "20260215_151000", 0.5f, 70);
+    auto after = tile_sizes(chunk);
+    after.erase("r11_g01.TSC");
+    if (!failed || after != before || archive.query(point_query(0.5f)).size() != 2) {
+        std::cout << "❌ FAILED: a failed append left records behind\n";
+        return false;
+    }
+
+    // Retried once the tile is writable, the frame is stored exactly once
+    fs::remove_all(chunk + "/r11_g01.TSC");
+    if (!append(archive, "20260215_151000", 0.5f, 70) || !append(archive, "20260215_151000", 0.5f, 70) ||
+        (samples = archive.query(point_query(0.5f))).size() != 3 || samples[2].count != 1 || samples[2].mean != 70.0f) {
+        std::cout << "❌ FAILED: retried append\n";
+        return false;
+    }
+    std::cout << "✅ PASSED: failed append rolled back\n";
+    return true;
+}
+
+bool test_concurrent_appends(const std::string& root) {
+    std::cout << "\n=== CONCURRENT APPEND TEST ===\n";
+    fs::create_directories(root);
+    levelii::SQLiteDatabase db(root + "/index.db");
+    TimeSeriesArchive archive(root + "/_timeseries", db);
+
+    // Two writers per tilt: different chunks append in parallel, the same chunk in turn
+    const int tilts = 4, writers_per_tilt = 2, frames = 12;
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int w = 0; w < tilts * writers_per_tilt; ++w) {
+        threads.emplace_back([&, w] {
+            float tilt = 0.5f + static_cast<float>(w % tilts);
+            for (int f = w / tilts; f < frames; f += writers_per_tilt) {
+                char timestamp[16];
+                std::snprintf(timestamp, sizeof(timestamp), "20260215_15%02d00", f * 4);
+                if (!append(archive, timestamp, tilt, static_cast<uint8_t>(10 + f))) failures.fetch_add(1);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (int t = 0; t < tilts; ++t) {
+        auto samples = archive.query(point_query(0.5f + t));
+        bool complete = samples.size() == static_cast<size_t>(frames);
+        for (size_t f = 0; complete && f < samples.size(); ++f) {
+            complete = samples[f].count == 1 && samples[f].mean == static_cast<float>(10 + f);
+        }
+        if (failures.load() != 0 || !complete) {
+            std::cout << "❌ FAILED: tilt " << 0.5f + t << " has " << samples.size() << " of " << frames << " frames intact\n";
+            return false;
+        }
+    }
+    std::cout << "✅ PASSED: concurrent appends\n";
+    return true;
+}
+
+int main() {
+    std::cout << "=" << std::string(60, '=') << "\n";
+    std::cout << "TIME-SERIES ARCHIVE TEST SUITE\n";
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    const std::string root = "./test_timeseries_data";
+    fs::remove_all(root);
+
+    bool ok = true;
+    {
+        FrameStorageManager manager(root);
+        manager.enable_timeseries_archive(24);
+        ok = test_point_and_area_queries(manager) && ok;
+        manager.shutdown_async_storage();
+    }
+    ok = test_prune(root) && ok;
+    ok = test_torn_tail(root + "/torn") && ok;
+    ok = test_concurrent_appends(root + "/concurrent") && ok;
+
+    fs::remove_all(root);
+
+    std::cout << "\n" << "=" << std::string(60, '=') << "\n";
+    std::cout << (ok ? "Time-series archive tests passed.\n" : "Time-series archive tests FAILED.\n");
+    std::cout << "=" << std::string(60, '=') << "\n";
+
+    return ok ? 0 : 1;
+}